@@ -0,0 +1,113 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalBenchAmortization.cpp
+// Project:     decimal
+// Purpose:     Reprices a portfolio of loans using annuity_plan
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_amortization.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+typedef dec::annuity_plan<2, 8> plan_type;
+typedef plan_type::amount_type amount_type;
+
+struct loan {
+    amount_type principal;
+    int plan;
+};
+
+const char *rates[] = {"0.0025", "0.003", "0.0035", "0.004", "0.0045", "0.005", "0.0055", "0.006"};
+const int terms[] = {120, 240, 360};
+
+// reference: factor recalculated for every loan, schedule with operators
+amount_type reprice_naive(const loan &item, const plan_type &plan) {
+    const dec::decimal<8> rate = plan.rate();
+    const dec::decimal<8> one(1);
+    const dec::decimal<8> factor = rate / (one - (one + rate).pow(-plan.periods()));
+    const amount_type payment = dec::decimal_cast<2>(dec::decimal_cast<8>(item.principal) * factor);
+    amount_type balance = item.principal;
+    amount_type total(0);
+    for (int i = 0; i < plan.periods(); ++i) {
+        amount_type interest = dec::decimal_cast<2>(dec::decimal_cast<8>(balance) * rate);
+        amount_type principal = payment - interest;
+        if (i == plan.periods() - 1 || principal > balance) {
+            principal = balance;
+        }
+        balance -= principal;
+        total += interest;
+    }
+    return total;
+}
+
+template<class Func>
+double run(const std::vector<loan> &loans, unsigned threadCount, Func func, dec::int64 &checksum) {
+    std::vector<dec::int64> sums(threadCount, 0);
+    std::vector<std::thread> threads;
+    const std::size_t chunk = (loans.size() + threadCount - 1) / threadCount;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threadCount; ++t) {
+        threads.push_back(std::thread([&, t]() {
+            const std::size_t first = t * chunk;
+            const std::size_t last = std::min(loans.size(), first + chunk);
+            for (std::size_t i = first; i < last; ++i) {
+                sums[t] += func(loans[i]).getUnbiased();
+            }
+        }));
+    }
+    for (std::size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    checksum = 0;
+    for (std::size_t t = 0; t < sums.size(); ++t) {
+        checksum += sums[t];
+    }
+    return elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::size_t loanCount = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+    const unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<plan_type> plans;
+    for (std::size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); ++r) {
+        for (std::size_t t = 0; t < sizeof(terms) / sizeof(terms[0]); ++t) {
+            plans.push_back(plan_type(dec::decimal<8>(rates[r]), terms[t]));
+        }
+    }
+
+    std::vector<loan> loans(loanCount);
+    test_random random(12345);
+    for (std::size_t i = 0; i < loanCount; ++i) {
+        const dec::details::uint64 bits = random.next();
+        loans[i].principal.setUnbiased(1000000 + static_cast<dec::int64>(bits % 100000000u));
+        loans[i].plan = static_cast<int>((bits >> 16) % plans.size());
+    }
+
+    dec::int64 planSum, naiveSum;
+    const double planTime = run(loans, threadCount, [&](const loan &item) {
+        dec::amortization_entry<2> rows[360];
+        return plans[item.plan].schedule(item.principal, rows);
+    }, planSum);
+    const double naiveTime = run(loans, threadCount, [&](const loan &item) {
+        return reprice_naive(item, plans[item.plan]);
+    }, naiveSum);
+
+    std::cout << "loans: " << loanCount << ", threads: " << threadCount << std::endl;
+    std::cout << "annuity_plan: " << planTime << " s, " << (loanCount / planTime) << " loans/s" << std::endl;
+    std::cout << "operators:    " << naiveTime << " s, " << (loanCount / naiveTime) << " loans/s" << std::endl;
+    std::cout << "total interest: " << planSum << " (operators: " << naiveSum << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,77 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalBenchCompare.cpp
+// Project:     decimal
+// Purpose:     Compares filtering "price between X and Y and qty > Z" with
+//              scalar operators and with bitmap kernels
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_bulk.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+template<class Func>
+double run(Func func) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+    const int repeats = (argc > 2) ? std::atoi(argv[2]) : 50;
+
+    std::vector<dec::decimal<4> > prices(count);
+    std::vector<dec::decimal<2> > quantities(count);
+    test_random random(1);
+    for (std::size_t i = 0; i < count; ++i) {
+        const dec::details::uint64 bits = random.next();
+        prices[i].setUnbiased(static_cast<dec::int64>(1000000 + (bits >> 40) % 20000));
+        quantities[i].setUnbiased(static_cast<dec::int64>((bits >> 20) % 100000));
+    }
+
+    const dec::decimal<4> low("100.5"), high("101.5");
+    const dec::decimal<2> minQuantity("250");
+    // constant in precision of price column, as scalar code has to use single precision
+    const dec::decimal<4> minQuantityPrice = dec::decimal_cast<4>(minQuantity);
+
+    std::size_t scalarCount = 0, kernelCount = 0;
+    std::vector<std::size_t> rows(count);
+
+    const double scalarTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            std::size_t selected = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (prices[i] >= low && prices[i] <= high && dec::decimal_cast<4>(quantities[i]) > minQuantityPrice) {
+                    rows[selected++] = i;
+                }
+            }
+            scalarCount += selected;
+        }
+    });
+
+    std::vector<dec::bitmap_word> byPrice(dec::bitmap_words(count)), byQuantity(dec::bitmap_words(count));
+    const double kernelTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            dec::compare_between(&prices[0], count, low, high, &byPrice[0]);
+            dec::compare(&quantities[0], count, dec::compare_greater, minQuantity, &byQuantity[0]);
+            dec::bitmap_and(&byPrice[0], &byQuantity[0], &byPrice[0], byPrice.size());
+            kernelCount += dec::bitmap_to_indexes(&byPrice[0], byPrice.size(), &rows[0]);
+        }
+    });
+
+    std::cout << "rows:             " << count * repeats << std::endl;
+    std::cout << "selected:         " << kernelCount << std::endl;
+    std::cout << "scalar operators: " << scalarTime << " s" << std::endl;
+    std::cout << "bitmap kernels:   " << kernelTime << " s" << std::endl;
+    return (scalarCount == kernelCount) ? 0 : 1;
+}
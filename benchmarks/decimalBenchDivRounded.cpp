@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalBenchDivRounded.cpp
+// Project:     decimal
+// Purpose:     Compares branch-free div_rounded() of rounding policies with
+//              div_rounded_reference() on values of mixed sign
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+template<class Func>
+double run(Func func) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// divisor is not constant, as in multDiv() and mixed precision operators
+template<class RoundPolicy>
+bool compare(const char *name, const std::vector<dec::int64> &values, const std::vector<dec::int64> &divisors,
+             int repeats) {
+    dec::int64 sum = 0, referenceSum = 0;
+    const double kernelTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                dec::int64 result;
+                RoundPolicy::div_rounded(result, values[i], divisors[i]);
+                sum += result;
+            }
+        }
+    });
+    const double referenceTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                dec::int64 result;
+                RoundPolicy::div_rounded_reference(result, values[i], divisors[i]);
+                referenceSum += result;
+            }
+        }
+    });
+    std::cout << name << ": branch-free " << kernelTime << " s, reference " << referenceTime << " s" << std::endl;
+    return sum == referenceSum;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+    const int repeats = (argc > 2) ? std::atoi(argv[2]) : 20;
+
+    std::vector<dec::int64> values(count), divisors(count);
+    test_random random(1);
+    for (std::size_t i = 0; i < count; ++i) {
+        const dec::details::uint64 bits = random.next();
+        // random signs and remainders, so that branches cannot be predicted
+        values[i] = static_cast<dec::int64>(bits) >> 20;
+        divisors[i] = dec::dec_utils<dec::def_round_policy>::pow10(static_cast<int>((bits >> 8) % 7) + 1);
+    }
+
+    std::cout << "divisions: " << count * repeats << std::endl;
+    bool same = compare<dec::def_round_policy>("def      ", values, divisors, repeats);
+    same = compare<dec::half_down_round_policy>("half_down", values, divisors, repeats) && same;
+    same = compare<dec::half_up_round_policy>("half_up  ", values, divisors, repeats) && same;
+    same = compare<dec::half_even_round_policy>("half_even", values, divisors, repeats) && same;
+    same = compare<dec::ceiling_round_policy>("ceiling  ", values, divisors, repeats) && same;
+    same = compare<dec::floor_round_policy>("floor    ", values, divisors, repeats) && same;
+    same = compare<dec::round_up_round_policy>("round_up ", values, divisors, repeats) && same;
+    return same ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalBenchDoubles.cpp
+// Project:     decimal
+// Purpose:     Compares conversion of double columns with decimal::setAsDouble()
+//              per element and with from_doubles() / to_doubles()
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_bulk.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+template<class Func>
+double run(Func func) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+template<class RoundPolicy>
+bool bench_policy(const char *name, const std::vector<double> &input, int repeats) {
+    typedef dec::decimal<4, RoundPolicy> value_type;
+    const std::size_t count = input.size();
+    std::vector<value_type> scalar(count), bulk(count);
+
+    const double scalarTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            for (std::size_t i = 0; i < count; ++i) {
+                scalar[i].setAsDouble(input[i]);
+            }
+        }
+    });
+
+    std::size_t failed = 0;
+    const double bulkTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            failed += dec::from_doubles(&input[0], &bulk[0], count);
+        }
+    });
+
+    bool same = (failed == 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        same = same && scalar[i] == bulk[i];
+    }
+    std::cout << name << " setAsDouble: " << scalarTime << " s, from_doubles: " << bulkTime << " s"
+              << (same ? "" : " MISMATCH") << std::endl;
+    return same;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+    const int repeats = (argc > 2) ? std::atoi(argv[2]) : 20;
+
+    // prices with up to 6 decimal places
+    std::vector<double> input(count);
+    test_random random(1);
+    for (std::size_t i = 0; i < count; ++i) {
+        const dec::details::uint64 bits = random.next();
+        input[i] = static_cast<double>(static_cast<dec::int64>((bits >> 20) % 2000000000) - 1000000000) / 1e6;
+    }
+
+    bool ok = bench_policy<dec::def_round_policy>("def_round_policy      ", input, repeats);
+    ok = bench_policy<dec::half_even_round_policy>("half_even_round_policy", input, repeats) && ok;
+    ok = bench_policy<dec::floor_round_policy>("floor_round_policy    ", input, repeats) && ok;
+
+    std::vector<dec::decimal<4> > values(count);
+    dec::from_doubles(&input[0], &values[0], count);
+    std::vector<double> scalar(count), bulk(count);
+    const double scalarTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            for (std::size_t i = 0; i < count; ++i) {
+                scalar[i] = values[i].getAsDouble();
+            }
+        }
+    });
+    const double bulkTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            dec::to_doubles(&values[0], &bulk[0], count);
+        }
+    });
+    ok = ok && scalar == bulk;
+    std::cout << "getAsDouble:                        " << scalarTime << " s, to_doubles:   " << bulkTime << " s"
+              << std::endl;
+    return ok ? 0 : 1;
+}
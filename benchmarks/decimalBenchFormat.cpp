@@ -0,0 +1,76 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalBenchFormat.cpp
+// Project:     decimal
+// Purpose:     Compares operator<< and toString with decimal_formatter
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+typedef dec::decimal<4> value_type;
+
+template<class Func>
+double run(Func func) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+
+    std::vector<value_type> values(count);
+    test_random random(1);
+    for (std::size_t i = 0; i < count; ++i) {
+        const dec::int64 bits = static_cast<dec::int64>(random.next());
+        values[i].setUnbiased((bits >> 20) % 100000000000LL);
+    }
+
+    std::size_t streamSize = 0, stringSize = 0, formatterSize = 0;
+
+    const double streamTime = run([&]() {
+        std::ostringstream out;
+        for (std::size_t i = 0; i < count; ++i) {
+            out << values[i] << '\n';
+        }
+        streamSize = out.str().size();
+    });
+
+    const double formatterTime = run([&]() {
+        const dec::decimal_formatter formatter;
+        std::string out;
+        out.reserve(count * 16);
+        for (std::size_t i = 0; i < count; ++i) {
+            formatter.append(values[i], out);
+            out += '\n';
+        }
+        formatterSize = out.size();
+    });
+
+    const double streamFormatterTime = run([&]() {
+        std::ostringstream out;
+        const dec::decimal_formatter formatter(out.getloc());
+        for (std::size_t i = 0; i < count; ++i) {
+            out << formatter(values[i]) << '\n';
+        }
+        stringSize = out.str().size();
+    });
+
+    std::cout << "values:                  " << count << std::endl;
+    std::cout << "operator<<:              " << streamTime << " s" << std::endl;
+    std::cout << "operator<< + formatter:  " << streamFormatterTime << " s" << std::endl;
+    std::cout << "formatter.append:        " << formatterTime << " s" << std::endl;
+    return (streamSize == formatterSize && stringSize == formatterSize) ? 0 : 1;
+}
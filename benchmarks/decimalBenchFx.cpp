@@ -0,0 +1,94 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalBenchFx.cpp
+// Project:     decimal
+// Purpose:     Compares conversion of amounts between currencies: triangulation
+//              with decimal_cast and operators, and fx_rate_table
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_fx.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+typedef dec::decimal<8> rate_type;
+typedef dec::decimal<2> amount_type;
+
+enum { currency_count = 150 };
+
+template<class Func>
+double run(Func func) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+struct conversion {
+    amount_type amount;
+    std::size_t from;
+    std::size_t to;
+};
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 2000000;
+
+    // rates for one USD between 0.3 and 30000
+    std::vector<rate_type> rates(currency_count);
+    std::vector<conversion> conversions(count);
+    test_random random(1);
+    rates[0] = rate_type(1);
+    for (std::size_t i = 1; i < rates.size(); ++i) {
+        const dec::details::uint64 bits = random.next();
+        const dec::int64 digits = static_cast<dec::int64>((bits >> 20) % 1000000000) + 30000000;
+        rates[i].setUnbiased(digits * dec::dec_utils<dec::def_round_policy>::pow10(static_cast<int>((bits >> 8) % 5)));
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        const dec::details::uint64 bits = random.next();
+        conversions[i].amount.setUnbiased(static_cast<dec::int64>((bits >> 24) % 100000000));
+        conversions[i].from = static_cast<std::size_t>((bits >> 8) % currency_count);
+        conversions[i].to = static_cast<std::size_t>((bits >> 16) % currency_count);
+    }
+
+    dec::fx_rate_table<8> table(currency_count);
+    for (std::size_t i = 1; i < rates.size(); ++i) {
+        table.set_rate(i, rates[i]);
+    }
+    table.publish();
+
+    std::vector<amount_type> chained(count), exact(count);
+    const double chainedTime = run([&]() {
+        for (std::size_t i = 0; i < count; ++i) {
+            const conversion &item = conversions[i];
+            const rate_type usd = dec::decimal_cast<8>(item.amount) / rates[item.from];
+            chained[i] = dec::decimal_cast<2>(usd * rates[item.to]);
+        }
+    });
+
+    bool ok = true;
+    const double tableTime = run([&]() {
+        const dec::fx_rate_table<8>::reader view(table);
+        for (std::size_t i = 0; i < count; ++i) {
+            const conversion &item = conversions[i];
+            ok = view.convert(item.amount, item.from, item.to, exact[i]) && ok;
+        }
+    });
+
+    std::size_t differences = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        differences += (chained[i] != exact[i]) ? 1 : 0;
+    }
+
+    std::cout << "conversions:         " << count << std::endl;
+    std::cout << "decimal_cast chain:  " << chainedTime << " s" << std::endl;
+    std::cout << "fx_rate_table:       " << tableTime << " s" << std::endl;
+    std::cout << "inexact chained:     " << differences << std::endl;
+    return ok ? 0 : 1;
+}
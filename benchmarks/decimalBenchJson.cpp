@@ -0,0 +1,126 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalBenchJson.cpp
+// Project:     decimal
+// Purpose:     Compares reading and writing of prices in JSON order book snapshot:
+//              via double, via std::string and with read_json / write_json
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_json.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef dec::decimal<8> value_type;
+
+template<class Func>
+double run(Func func) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// snapshot in format of depth endpoints of crypto exchanges:
+// {"lastUpdateId":1,"bids":[["price","quantity"],...],"asks":[...]}
+std::string make_snapshot(std::size_t levels) {
+    std::string result = "{\"lastUpdateId\":1027024,\"bids\":[";
+    test_random random(1);
+    for (int side = 0; side < 2; ++side) {
+        value_type price(side == 0 ? "41000.5" : "41001");
+        for (std::size_t i = 0; i < levels; ++i) {
+            const dec::int64 bits = static_cast<dec::int64>(random.next());
+            value_type quantity;
+            quantity.setUnbiased((bits >> 16) % 10000000000LL);
+            price += value_type(side == 0 ? "-0.5" : "0.5");
+            result += (i > 0) ? ",[\"" : "[\"";
+            result += dec::toString(price) + "\",\"" + dec::toString(quantity) + "\"]";
+        }
+        result += (side == 0) ? "],\"asks\":[" : "]}";
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::size_t levels = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 5000;
+    const int repeats = (argc > 2) ? std::atoi(argv[2]) : 100;
+
+    const std::string snapshot = make_snapshot(levels);
+
+    // quoted number tokens, as reported by JSON parser (keys start with letters)
+    std::vector<const char *> tokens;
+    for (std::size_t pos = 0; pos + 1 < snapshot.size(); ++pos) {
+        if (snapshot[pos] == '"' && snapshot[pos + 1] >= '0' && snapshot[pos + 1] <= '9') {
+            tokens.push_back(snapshot.data() + pos);
+            pos = snapshot.find('"', pos + 1);
+        }
+    }
+    const char *end = snapshot.data() + snapshot.size();
+
+    value_type doubleSum, stringSum, jsonSum;
+
+    const double doubleTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            for (std::size_t i = 0; i < tokens.size(); ++i) {
+                doubleSum += value_type(std::strtod(tokens[i] + 1, NULL));
+            }
+        }
+    });
+
+    const double stringTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            for (std::size_t i = 0; i < tokens.size(); ++i) {
+                const char *first = tokens[i] + 1;
+                const std::string text(first, static_cast<const char *>(std::memchr(first, '"', 64)));
+                stringSum += dec::fromString<value_type>(text);
+            }
+        }
+    });
+
+    const double jsonTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            for (std::size_t i = 0; i < tokens.size(); ++i) {
+                value_type value;
+                dec::read_json(tokens[i], end, value);
+                jsonSum += value;
+            }
+        }
+    });
+
+    std::string output;
+    const double toStringTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            output.clear();
+            for (std::size_t i = 0; i < tokens.size(); ++i) {
+                output += dec::toString(jsonSum) + ',';
+            }
+        }
+    });
+
+    output.reserve(tokens.size() * dec::max_json_chars);
+    const double writeTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            output.clear();
+            for (std::size_t i = 0; i < tokens.size(); ++i) {
+                dec::append_json(jsonSum, output) += ',';
+            }
+        }
+    });
+
+    std::cout << "numbers:             " << tokens.size() * repeats << std::endl;
+    std::cout << "strtod + decimal:    " << doubleTime << " s" << std::endl;
+    std::cout << "string + fromString: " << stringTime << " s" << std::endl;
+    std::cout << "read_json:           " << jsonTime << " s" << std::endl;
+    std::cout << "toString:            " << toStringTime << " s" << std::endl;
+    std::cout << "append_json:         " << writeTime << " s" << std::endl;
+    return (stringSum == jsonSum) ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalBenchOrderBook.cpp
+// Project:     decimal
+// Purpose:     Replays synthetic order-level (L3) message file into
+//              order_book and into book based on std::map
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_order_book.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+typedef dec::order_book<4, 2> book_type;
+typedef book_type::price_type price_type;
+typedef book_type::quantity_type quantity_type;
+
+enum { depth = 5 };
+
+template<class Func>
+double run(Func func) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// A id side price quantity, M id quantity, X id
+struct message {
+    char type;
+    dec::book_side side;
+    book_type::order_id id;
+    price_type price;
+    quantity_type quantity;
+};
+
+void write_messages(const char *path, std::size_t count) {
+    std::ofstream output(path);
+    std::vector<book_type::order_id> live;
+    book_type::order_id nextId = 1;
+    test_random random(1);
+    dec::int64 mid = 1000000;
+    for (std::size_t i = 0; i < count; ++i) {
+        const dec::details::uint64 bits = random.next();
+        const unsigned action = static_cast<unsigned>((bits >> 20) % 100);
+        if (action == 0) {
+            mid += static_cast<dec::int64>((bits >> 40) % 3) - 1;
+        }
+        // adds and cancels are balanced, so that number of live orders is stable
+        if (live.size() < 1000 || action < 30) {
+            const bool bid = ((bits >> 30) & 1) != 0;
+            // most orders are placed near the top of book, ticks of 0.0005
+            const dec::int64 distance = static_cast<dec::int64>(((bits >> 32) % 16) * ((bits >> 36) % 8) + 1);
+            price_type price;
+            price.setUnbiased((bid ? mid - distance : mid + distance) * 5);
+            quantity_type quantity;
+            quantity.setUnbiased(static_cast<dec::int64>((bits >> 44) % 100000) + 100);
+            output << "A " << nextId << (bid ? " B " : " S ") << dec::toString(price) << ' '
+                   << dec::toString(quantity) << '\n';
+            live.push_back(nextId++);
+            continue;
+        }
+        const std::size_t position = static_cast<std::size_t>((bits >> 8) % live.size());
+        quantity_type quantity;
+        quantity.setUnbiased(static_cast<dec::int64>((bits >> 44) % 50000) + 100);
+        if (action < 65) {
+            output << "M " << live[position] << ' ' << dec::toString(quantity) << '\n';
+        } else if (action < 70) {
+            // replace moves order away from mid, so that sides do not cross
+            price_type price;
+            price.setUnbiased((mid + ((bits & 1) != 0 ? -20 : 20)) * 5);
+            output << "X " << live[position] << '\n';
+            output << "A " << nextId << ((bits & 1) != 0 ? " B " : " S ") << dec::toString(price) << ' '
+                   << dec::toString(quantity) << '\n';
+            live[position] = nextId++;
+        } else {
+            output << "X " << live[position] << '\n';
+            live[position] = live.back();
+            live.pop_back();
+        }
+    }
+}
+
+void read_messages(const char *path, std::vector<message> &messages) {
+    std::ifstream input(path);
+    std::string type, side, price, quantity;
+    message item;
+    while (input >> type >> item.id) {
+        item.type = type[0];
+        if (item.type == 'A') {
+            input >> side >> price >> quantity;
+            item.side = (side == "B") ? dec::book_bid : dec::book_ask;
+            item.price = dec::fromString<price_type>(price);
+            item.quantity = dec::fromString<quantity_type>(quantity);
+        } else if (item.type == 'M') {
+            input >> quantity;
+            item.quantity = dec::fromString<quantity_type>(quantity);
+        }
+        messages.push_back(item);
+    }
+}
+
+// book used before order_book: levels in std::map, orders in std::unordered_map
+class map_book {
+public:
+    bool add(const message &item) {
+        if (!m_orders.insert(std::make_pair(item.id, item)).second) {
+            return false;
+        }
+        m_levels[item.side][item.price] += item.quantity;
+        return true;
+    }
+
+    bool modify(const message &item) {
+        std::unordered_map<book_type::order_id, message>::iterator it = m_orders.find(item.id);
+        if (it == m_orders.end()) {
+            return false;
+        }
+        m_levels[it->second.side][it->second.price] += item.quantity - it->second.quantity;
+        it->second.quantity = item.quantity;
+        return true;
+    }
+
+    bool cancel(const message &item) {
+        std::unordered_map<book_type::order_id, message>::iterator it = m_orders.find(item.id);
+        if (it == m_orders.end()) {
+            return false;
+        }
+        std::map<price_type, quantity_type> &levels = m_levels[it->second.side];
+        std::map<price_type, quantity_type>::iterator level = levels.find(it->second.price);
+        level->second -= it->second.quantity;
+        if (level->second.getUnbiased() == 0) {
+            levels.erase(level);
+        }
+        m_orders.erase(it);
+        return true;
+    }
+
+    dec::int64 checksum() const {
+        dec::int64 result = 0;
+        const std::map<price_type, quantity_type> &bids = m_levels[dec::book_bid];
+        std::map<price_type, quantity_type>::const_reverse_iterator bid = bids.rbegin();
+        for (int i = 0; i < depth && bid != bids.rend(); ++i, ++bid) {
+            result += bid->first.getUnbiased() ^ bid->second.getUnbiased();
+        }
+        const std::map<price_type, quantity_type> &asks = m_levels[dec::book_ask];
+        std::map<price_type, quantity_type>::const_iterator ask = asks.begin();
+        for (int i = 0; i < depth && ask != asks.end(); ++i, ++ask) {
+            result += ask->first.getUnbiased() ^ ask->second.getUnbiased();
+        }
+        return result;
+    }
+
+private:
+    std::unordered_map<book_type::order_id, message> m_orders;
+    std::map<price_type, quantity_type> m_levels[2];
+};
+
+dec::int64 checksum(const book_type &book) {
+    dec::int64 result = 0;
+    book_type::level levels[depth];
+    for (int side = 0; side < 2; ++side) {
+        const std::size_t count = book.snapshot(static_cast<dec::book_side>(side), depth, levels);
+        for (std::size_t i = 0; i < count; ++i) {
+            result += levels[i].price.getUnbiased() ^ levels[i].quantity.getUnbiased();
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 5000000;
+    const char *path = "decimal_bench_order_book.txt";
+
+    write_messages(path, count);
+    std::vector<message> messages;
+    const double readTime = run([&]() {
+        read_messages(path, messages);
+    });
+    std::remove(path);
+
+    // top of book is read after every message, as by strategy
+    dec::int64 bookSum = 0, mapSum = 0;
+    bool ok = true;
+    const double bookTime = run([&]() {
+        book_type book(price_type("0.0005"));
+        book.reserve(65536, 4096);
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            const message &item = messages[i];
+            switch (item.type) {
+                case 'A':
+                    ok = book.add(item.id, item.side, item.price, item.quantity) && ok;
+                    break;
+                case 'M':
+                    ok = book.modify(item.id, item.quantity) && ok;
+                    break;
+                default:
+                    ok = book.cancel(item.id) && ok;
+                    break;
+            }
+            bookSum += checksum(book);
+        }
+    });
+
+    const double mapTime = run([&]() {
+        map_book book;
+        for (std::size_t i = 0; i < messages.size(); ++i) {
+            const message &item = messages[i];
+            switch (item.type) {
+                case 'A':
+                    ok = book.add(item) && ok;
+                    break;
+                case 'M':
+                    ok = book.modify(item) && ok;
+                    break;
+                default:
+                    ok = book.cancel(item) && ok;
+                    break;
+            }
+            mapSum += book.checksum();
+        }
+    });
+
+    std::cout << "messages:   " << messages.size() << std::endl;
+    std::cout << "read file:  " << readTime << " s" << std::endl;
+    std::cout << "order_book: " << bookTime << " s" << std::endl;
+    std::cout << "std::map:   " << mapTime << " s" << std::endl;
+    return (ok && bookSum == mapSum) ? 0 : 1;
+}
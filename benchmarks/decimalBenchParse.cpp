@@ -0,0 +1,79 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalBenchParse.cpp
+// Project:     decimal
+// Purpose:     Compares parsing of short fields: stream, buffer and fixed-width parser
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef dec::decimal<6> value_type;
+
+template<class Func>
+double run(Func func) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+
+    // fields like "-?\d{1,10}\.\d{1,8}"
+    std::vector<std::string> fields(count);
+    test_random random(1);
+    for (std::size_t i = 0; i < count; ++i) {
+        const dec::int64 bits = static_cast<dec::int64>(random.next());
+        dec::decimal<8> value;
+        value.setUnbiased((bits >> 8) % 1000000000000000000LL);
+        fields[i] = dec::toString(value);
+    }
+
+    const dec::basic_decimal_format format;
+    dec::int64 streamSum = 0, bufferSum = 0, fastSum = 0;
+
+    const double streamTime = run([&]() {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::istringstream input(fields[i]);
+            value_type value;
+            dec::fromStream(input, format, value);
+            streamSum += value.getUnbiased();
+        }
+    });
+
+    const double bufferTime = run([&]() {
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::string &field = fields[i];
+            dec::details::buffer_reader input(field.data(), field.data() + field.size());
+            value_type value;
+            dec::fromStream(input, format, value);
+            bufferSum += value.getUnbiased();
+        }
+    });
+
+    const double fastTime = run([&]() {
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::string &field = fields[i];
+            fastSum += dec::fromString<value_type>(field.data(), field.size(), format).getUnbiased();
+        }
+    });
+
+    std::cout << "fields:              " << count << std::endl;
+    std::cout << "istringstream:       " << streamTime << " s" << std::endl;
+    std::cout << "buffer, scalar:      " << bufferTime << " s" << std::endl;
+    std::cout << "buffer, fixed-width: " << fastTime << " s" << std::endl;
+    return (streamSum == bufferSum && bufferSum == fastSum) ? 0 : 1;
+}
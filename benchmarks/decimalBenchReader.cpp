@@ -0,0 +1,95 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalBenchReader.cpp
+// Project:     decimal
+// Purpose:     Compares reading of text file: std::ifstream with operator>>
+//              and memory-mapped decimal_file_reader
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_reader.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef dec::decimal<6> value_type;
+
+template<class Func>
+double run(Func func) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::size_t rows = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 2000000;
+    const char *path = "decimal_bench_reader.csv";
+
+    // rows like "price quantity", so that operator>> can read them without extra code
+    {
+        std::ofstream output(path);
+        test_random random(1);
+        for (std::size_t i = 0; i < rows; ++i) {
+            const dec::int64 bits = static_cast<dec::int64>(random.next());
+            value_type price, quantity;
+            price.setUnbiased((bits >> 8) % 100000000000LL);
+            quantity.setUnbiased((bits >> 24) % 1000000000LL);
+            output << dec::toString(price) << ' ' << dec::toString(quantity) << '\n';
+        }
+    }
+
+    value_type streamSum, singleSum, parallelSum;
+
+    const double streamTime = run([&]() {
+        std::ifstream input(path);
+        value_type price, quantity;
+        while (input >> price >> quantity) {
+            streamSum += price + quantity;
+        }
+    });
+
+    std::vector<std::size_t> columns;
+    columns.push_back(0);
+    columns.push_back(1);
+
+    dec::decimal_reader_options options;
+    options.separator = ' ';
+    options.threads = 1;
+    const double singleTime = run([&]() {
+        dec::decimal_file_reader<6> reader(path, columns, options);
+        std::vector<std::vector<value_type> > values;
+        reader.read_columns(values);
+        for (std::size_t i = 0; i < values[0].size(); ++i) {
+            singleSum += values[0][i] + values[1][i];
+        }
+    });
+
+    const unsigned threads = std::thread::hardware_concurrency();
+    options.threads = threads;
+    const double parallelTime = run([&]() {
+        dec::decimal_file_reader<6> reader(path, columns, options);
+        std::vector<std::vector<value_type> > values;
+        reader.read_columns(values);
+        for (std::size_t i = 0; i < values[0].size(); ++i) {
+            parallelSum += values[0][i] + values[1][i];
+        }
+    });
+
+    std::remove(path);
+
+    std::cout << "rows:                 " << rows << std::endl;
+    std::cout << "ifstream, operator>>: " << streamTime << " s" << std::endl;
+    std::cout << "mapped, 1 thread:     " << singleTime << " s" << std::endl;
+    std::cout << "mapped, all threads (" << threads << "): " << parallelTime << " s" << std::endl;
+    return (streamSum == singleSum && singleSum == parallelSum) ? 0 : 1;
+}
@@ -0,0 +1,99 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalBenchStatistics.cpp
+// Project:     decimal
+// Purpose:     Compares mean, standard deviation, VWAP and median calculated
+//              with exact accumulators and with getAsDouble()
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#include "decimal_statistics.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+template<class Func>
+double run(Func func) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const std::size_t count = (argc > 1) ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+    const int repeats = (argc > 2) ? std::atoi(argv[2]) : 20;
+
+    std::vector<dec::decimal<4> > prices(count);
+    std::vector<dec::decimal<0> > quantities(count);
+    test_random random(1);
+    for (std::size_t i = 0; i < count; ++i) {
+        const dec::details::uint64 bits = random.next();
+        prices[i].setUnbiased(static_cast<dec::int64>(1000000 + (bits >> 40) % 20000));
+        quantities[i].setUnbiased(static_cast<dec::int64>(1 + (bits >> 20) % 1000));
+    }
+
+    dec::decimal<6> mean, stddev, vwap, median;
+    bool valid = true;
+    const double exactTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            dec::running_stats<4> stats;
+            dec::vwap_accumulator<4, 0> volume;
+            stats.add(&prices[0], count);
+            volume.add(&prices[0], &quantities[0], count);
+            valid = stats.mean(mean) && stats.stddev(stddev) && volume.vwap(vwap) &&
+                    dec::median(&prices[0], count, median) && valid;
+        }
+    });
+
+    double meanDouble = 0, stddevDouble = 0, vwapDouble = 0, medianDouble = 0;
+    std::vector<double> sorted(count);
+    const double doubleTime = run([&]() {
+        for (int r = 0; r < repeats; ++r) {
+            double sum = 0, sumSquares = 0, notional = 0, total = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                const double price = prices[i].getAsDouble();
+                const double quantity = quantities[i].getAsDouble();
+                sum += price;
+                sumSquares += price * price;
+                notional += price * quantity;
+                total += quantity;
+                sorted[i] = price;
+            }
+            const double n = static_cast<double>(count);
+            meanDouble = sum / n;
+            stddevDouble = std::sqrt((sumSquares - sum * meanDouble) / (n - 1));
+            vwapDouble = notional / total;
+            std::vector<double>::iterator middle = sorted.begin() + static_cast<std::ptrdiff_t>((count - 1) / 2);
+            std::nth_element(sorted.begin(), middle, sorted.end());
+            medianDouble = *middle;
+            if (count % 2 == 0) {
+                medianDouble = (medianDouble + *std::min_element(middle + 1, sorted.end())) / 2;
+            }
+        }
+    });
+
+    std::cout << "values:         " << count * repeats << std::endl;
+    std::cout << "mean:           " << mean << " (double " << meanDouble << ")" << std::endl;
+    std::cout << "stddev:         " << stddev << " (double " << stddevDouble << ")" << std::endl;
+    std::cout << "vwap:           " << vwap << " (double " << vwapDouble << ")" << std::endl;
+    std::cout << "median:         " << median << " (double " << medianDouble << ")" << std::endl;
+    std::cout << "exact decimals: " << exactTime << " s" << std::endl;
+    std::cout << "double:         " << doubleTime << " s" << std::endl;
+
+    // both versions agree within error of double arithmetic
+    const double tolerance = 1e-5;
+    const bool close = std::fabs(mean.getAsDouble() - meanDouble) < tolerance &&
+                       std::fabs(stddev.getAsDouble() - stddevDouble) < tolerance &&
+                       std::fabs(vwap.getAsDouble() - vwapDouble) < tolerance &&
+                       std::fabs(median.getAsDouble() - medianDouble) < tolerance;
+    return (valid && close) ? 0 : 1;
+}
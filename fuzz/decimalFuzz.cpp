@@ -0,0 +1,570 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimalFuzz.cpp
+// Project:     decimal
+// Purpose:     Differential fuzz target - compares rounding, arithmetic
+//              operators, parsing and formatting with exact 128-bit reference
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+// Built in two modes:
+// - with DEC_FUZZ_LIBFUZZER and -fsanitize=fuzzer: libFuzzer target, e.g.
+//     ./fuzz_decimal -max_total_time=600 ../fuzz/corpus
+// - without it: standalone driver (CTest target), which replays given corpus files
+//   and then checks pseudo-random inputs until time or iteration budget is used:
+//     ./fuzz_runner [--seconds N] [--iterations N] [files...]
+//
+// Every input is one check: first byte selects operation, next bytes give
+// rounding policy, precisions and operands. Known inexact paths reported by
+// statistics events (multDiv using floating point) are checked with tolerance.
+
+#ifndef DEC_ENABLE_STATS
+#define DEC_ENABLE_STATS
+#endif
+
+#include "decimal.h"
+#include "../tests/decimalTestUtils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifndef __SIZEOF_INT128__
+#error "fuzz target requires 128-bit integer type for reference arithmetic"
+#endif
+
+namespace {
+
+__extension__ typedef __int128 int128;
+
+using dec::int64;
+typedef dec::details::uint64 uint64;
+
+// --> Input decoding
+
+/// Reads values from fuzzer input, zeros past the end
+class fuzz_input {
+public:
+    fuzz_input(const unsigned char *data, std::size_t size) : m_pos(data), m_end(data + size) {
+    }
+
+    unsigned int byte() {
+        return (m_pos != m_end) ? *m_pos++ : 0;
+    }
+
+    uint64 word() {
+        uint64 result = 0;
+        for (int i = 0; i < 8; ++i) {
+            result = (result << 8) | byte();
+        }
+        return result;
+    }
+
+    /// Value from one of ranges where rounding and overflow bugs are likely
+    int64 value() {
+        const unsigned int shape = byte();
+        const uint64 raw = word();
+        const int64 small = static_cast<int64>(raw % 2001) - 1000;
+        switch (shape % 5) {
+        case 0:
+            return static_cast<int64>(raw);
+        case 1: {
+            // up to 'digits' decimal digits
+            const int64 limit = dec::dec_utils<dec::def_round_policy>::pow10(static_cast<int>(shape / 5 % 19));
+            const int64 magnitude = static_cast<int64>((raw >> 1) % static_cast<uint64>(limit));
+            return (raw & 1) ? -magnitude : magnitude;
+        }
+        case 2:
+            // near limits
+            return (raw & 1) ? DEC_MIN_INT64 + (small < 0 ? -small : small)
+                             : DEC_MAX_INT64 - (small < 0 ? -small : small);
+        case 3: {
+            // near multiple of power of ten
+            const int64 factor = dec::dec_utils<dec::def_round_policy>::pow10(static_cast<int>(shape / 5 % 19));
+            return (static_cast<int64>(raw >> 8) / factor) * factor + small % 10;
+        }
+        default:
+            return small;
+        }
+    }
+
+    std::size_t remaining() const {
+        return static_cast<std::size_t>(m_end - m_pos);
+    }
+
+    const unsigned char *position() const {
+        return m_pos;
+    }
+
+private:
+    const unsigned char *m_pos;
+    const unsigned char *m_end;
+};
+// <--
+
+// --> Reference arithmetic
+
+enum round_mode {
+    mode_truncate, mode_half_away, mode_half_floor, mode_half_ceiling, mode_half_even,
+    mode_ceiling, mode_floor, mode_away
+};
+
+template<class RoundPolicy>
+struct policy_traits;
+
+#define DEC_FUZZ_POLICY(policy, mode) \
+    template<> \
+    struct policy_traits<dec::policy> { \
+        static round_mode value() { return mode; } \
+        static const char *name() { return #policy; } \
+    };
+
+DEC_FUZZ_POLICY(null_round_policy, mode_truncate)
+DEC_FUZZ_POLICY(def_round_policy, mode_half_away)
+DEC_FUZZ_POLICY(half_down_round_policy, mode_half_floor)
+DEC_FUZZ_POLICY(half_up_round_policy, mode_half_ceiling)
+DEC_FUZZ_POLICY(half_even_round_policy, mode_half_even)
+DEC_FUZZ_POLICY(ceiling_round_policy, mode_ceiling)
+DEC_FUZZ_POLICY(floor_round_policy, mode_floor)
+DEC_FUZZ_POLICY(round_up_round_policy, mode_away)
+DEC_FUZZ_POLICY(round_down_round_policy, mode_truncate)
+
+#undef DEC_FUZZ_POLICY
+
+/// Exact num / den rounded with given mode
+int128 reference_round(int128 num, int128 den, round_mode mode) {
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+    const int128 quot = num / den;
+    const int128 rem = num % den;
+    if (rem == 0) {
+        return quot;
+    }
+    const bool negative = num < 0;
+    const int128 twice = 2 * (negative ? -rem : rem);
+    const int half = (twice > den) ? 1 : ((twice == den) ? 0 : -1);
+    const int128 away = negative ? quot - 1 : quot + 1;
+    switch (mode) {
+    case mode_truncate:
+        return quot;
+    case mode_half_away:
+        return (half >= 0) ? away : quot;
+    case mode_half_floor:
+        return (half > 0 || (half == 0 && negative)) ? away : quot;
+    case mode_half_ceiling:
+        return (half > 0 || (half == 0 && !negative)) ? away : quot;
+    case mode_half_even:
+        return (half > 0 || (half == 0 && quot % 2 != 0)) ? away : quot;
+    case mode_ceiling:
+        return negative ? quot : away;
+    case mode_floor:
+        return negative ? away : quot;
+    default:
+        return away;
+    }
+}
+
+bool fits(int128 value) {
+    return value >= DEC_MIN_INT64 && value <= DEC_MAX_INT64;
+}
+
+int128 pow10_128(int n) {
+    int128 result = 1;
+    while (n-- > 0) {
+        result *= 10;
+    }
+    return result;
+}
+
+int128 abs_128(int128 value) {
+    return (value < 0) ? -value : value;
+}
+
+/// Plain formatting: [-]digits[.digits]
+std::string reference_format(int64 value, int prec) {
+    const bool negative = value < 0;
+    uint64 magnitude = negative ? 0 - static_cast<uint64>(value) : static_cast<uint64>(value);
+    std::string digits;
+    do {
+        digits.insert(digits.begin(), static_cast<char>('0' + magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (static_cast<int>(digits.size()) <= prec) {
+        digits.insert(0, static_cast<std::size_t>(prec) + 1 - digits.size(), '0');
+    }
+    if (prec > 0) {
+        digits.insert(digits.size() - static_cast<std::size_t>(prec), 1, '.');
+    }
+    return negative ? "-" + digits : digits;
+}
+// <--
+
+// --> Failure reporting
+
+unsigned int events = 0;
+
+void record_event(dec::stats_event event) {
+    events |= 1u << event;
+}
+
+bool inexact_event() {
+    return (events & ((1u << dec::stats_mult_div_cross_float) | (1u << dec::stats_round_failure))) != 0;
+}
+
+std::string to_string_128(int128 value) {
+    const bool negative = value < 0;
+    std::string result;
+    do {
+        const int digit = static_cast<int>(value % 10);
+        result.insert(result.begin(), static_cast<char>('0' + (digit < 0 ? -digit : digit)));
+        value /= 10;
+    } while (value != 0);
+    return negative ? "-" + result : result;
+}
+
+void fail(const char *check, const char *policy, int prec1, int prec2, const std::string &args,
+          int128 actual, int128 expected) {
+    std::fprintf(stderr, "fuzz failure: %s, %s, precisions %d/%d, %s: got %s, expected %s\n",
+                 check, policy, prec1, prec2, args.c_str(), to_string_128(actual).c_str(),
+                 to_string_128(expected).c_str());
+    std::abort();
+}
+
+std::string args_string(int64 a, int64 b) {
+    return "a=" + to_string_128(a) + " b=" + to_string_128(b);
+}
+// <--
+
+// --> Checks
+
+/// div_rounded may fail only near int64 limits, otherwise result must be exact
+template<class RoundPolicy>
+void check_div_rounded(int64 a, int64 b) {
+    if (b == 0) {
+        return;
+    }
+    const int128 expected = reference_round(a, b, policy_traits<RoundPolicy>::value());
+    int64 output;
+    if (RoundPolicy::div_rounded(output, a, b)) {
+        if (output != expected) {
+            fail("div_rounded", policy_traits<RoundPolicy>::name(), 0, 0, args_string(a, b), output, expected);
+        }
+        return;
+    }
+    const bool nearLimits = a == DEC_MIN_INT64 || b == DEC_MIN_INT64 ||
+                            abs_128(a) > DEC_MAX_INT64 - abs_128(b);
+    if (output != 0 || (fits(expected) && !nearLimits)) {
+        fail("div_rounded failed", policy_traits<RoundPolicy>::name(), 0, 0, args_string(a, b), output, expected);
+    }
+}
+
+template<int Prec, class RoundPolicy>
+dec::decimal<Prec, RoundPolicy> make_decimal(int64 unbiased) {
+    dec::decimal<Prec, RoundPolicy> result;
+    result.setUnbiased(unbiased);
+    return result;
+}
+
+/// Operand of precision Prec2 converted to precision Prec, as done by + and -
+template<int Prec, int Prec2, class RoundPolicy>
+bool reference_operand(int64 value, int128 &output) {
+    if (Prec2 > Prec) {
+        const int64 factor = dec::dec_utils<RoundPolicy>::pow10(Prec2 - Prec);
+        // rounding near limits is allowed to fail
+        if (abs_128(value) > DEC_MAX_INT64 - factor) {
+            return false;
+        }
+        output = reference_round(value, factor, policy_traits<RoundPolicy>::value());
+    } else {
+        output = static_cast<int128>(value) * pow10_128(Prec - Prec2);
+    }
+    return fits(output);
+}
+
+template<int Prec, int Prec2, class RoundPolicy>
+void check_binary(unsigned int op, int64 a, int64 b) {
+    typedef dec::decimal<Prec, RoundPolicy> lhs_type;
+    typedef dec::decimal<Prec2, RoundPolicy> rhs_type;
+    const lhs_type lhs = make_decimal<Prec, RoundPolicy>(a);
+    const rhs_type rhs = make_decimal<Prec2, RoundPolicy>(b);
+    const round_mode mode = policy_traits<RoundPolicy>::value();
+    const char *policy = policy_traits<RoundPolicy>::name();
+
+    int128 expected, operand;
+    lhs_type result;
+    events = 0;
+    switch (op % 4) {
+    case 0:
+        if (!reference_operand<Prec, Prec2, RoundPolicy>(b, operand) || !fits(expected = a + operand)) {
+            return;
+        }
+        result = lhs + rhs;
+        if (result.getUnbiased() != expected) {
+            fail("operator+", policy, Prec, Prec2, args_string(a, b), result.getUnbiased(), expected);
+        }
+        result = lhs;
+        result += rhs;
+        if (result.getUnbiased() != expected) {
+            fail("operator+=", policy, Prec, Prec2, args_string(a, b), result.getUnbiased(), expected);
+        }
+        return;
+    case 1:
+        if (!reference_operand<Prec, Prec2, RoundPolicy>(b, operand) || !fits(expected = a - operand)) {
+            return;
+        }
+        result = lhs - rhs;
+        if (result.getUnbiased() != expected) {
+            fail("operator-", policy, Prec, Prec2, args_string(a, b), result.getUnbiased(), expected);
+        }
+        return;
+    case 2:
+        expected = reference_round(static_cast<int128>(a) * b, pow10_128(Prec2), mode);
+        if (!fits(expected)) {
+            return;
+        }
+        result = lhs * rhs;
+        break;
+    default:
+        if (b == 0) {
+            return;
+        }
+        expected = reference_round(static_cast<int128>(a) * pow10_128(Prec2), b, mode);
+        if (!fits(expected)) {
+            return;
+        }
+        result = lhs / rhs;
+        break;
+    }
+
+    const int128 actual = result.getUnbiased();
+    const char *name = (op % 4 == 2) ? "operator*" : "operator/";
+    if (!inexact_event()) {
+        if (actual != expected) {
+            fail(name, policy, Prec, Prec2, args_string(a, b), actual, expected);
+        }
+    } else if (abs_128(actual - expected) > 1 + (abs_128(expected) >> 50)) {
+        // floating point fallback of multDiv is documented as inexact
+        fail(name, policy, Prec, Prec2, args_string(a, b) + " (inexact path)", actual, expected);
+    }
+}
+
+template<int Prec, class RoundPolicy>
+void check_round_trip(int64 value) {
+    typedef dec::decimal<Prec, RoundPolicy> decimal_type;
+    const decimal_type input = make_decimal<Prec, RoundPolicy>(value);
+    const char *policy = policy_traits<RoundPolicy>::name();
+
+    const std::string text = dec::toString(input);
+    if (text != reference_format(value, Prec)) {
+        fail(("toString \"" + text + "\"").c_str(), policy, Prec, Prec, args_string(value, 0), value, value);
+    }
+
+    decimal_type output;
+    if (!dec::fromString(text.data(), text.size(), dec::basic_decimal_format(), output) ||
+        output.getUnbiased() != value) {
+        fail(("fromString \"" + text + "\"").c_str(), policy, Prec, Prec, args_string(value, 0),
+             output.getUnbiased(), value);
+    }
+
+    const std::string exponent = dec::toStringWithExponent(input);
+    if (!dec::fromString(exponent.data(), exponent.size(), dec::basic_decimal_format(), output) ||
+        output.getUnbiased() != value) {
+        fail(("fromString \"" + exponent + "\"").c_str(), policy, Prec, Prec, args_string(value, 0),
+             output.getUnbiased(), value);
+    }
+}
+
+/// Plain number with up to 18 digits, both fixed-width and stream parser must round it exactly.
+/// Longer numbers are not checked: parser does not detect overflow of digit accumulators.
+template<int Prec, class RoundPolicy>
+void check_parse(fuzz_input &input) {
+    const bool negative = (input.byte() & 1) != 0;
+    const int digits = static_cast<int>(input.byte() % 18) + 1;
+    const int fractionDigits = static_cast<int>(input.byte() % static_cast<unsigned int>(digits));
+    std::string text = negative ? "-" : "";
+    int128 mantissa = 0;
+    for (int i = 0; i < digits; ++i) {
+        if (i == digits - fractionDigits) {
+            text += '.';
+        }
+        const int digit = static_cast<int>(input.byte() % 10);
+        text += static_cast<char>('0' + digit);
+        mantissa = mantissa * 10 + digit;
+    }
+
+    const int128 expected = reference_round((negative ? -mantissa : mantissa) * pow10_128(Prec),
+                                            pow10_128(fractionDigits), policy_traits<RoundPolicy>::value());
+    if (!fits(expected)) {
+        return;
+    }
+
+    const char *policy = policy_traits<RoundPolicy>::name();
+    dec::decimal<Prec, RoundPolicy> output;
+    if (!dec::fromString(text.data(), text.size(), dec::basic_decimal_format(), output) ||
+        output.getUnbiased() != expected) {
+        fail(("fromString \"" + text + "\"").c_str(), policy, Prec, Prec, "", output.getUnbiased(), expected);
+    }
+
+    dec::details::buffer_reader reader(text.data(), text.data() + text.size());
+    if (!dec::fromStream(reader, dec::basic_decimal_format(), output) || output.getUnbiased() != expected) {
+        fail(("fromStream \"" + text + "\"").c_str(), policy, Prec, Prec, "", output.getUnbiased(), expected);
+    }
+}
+
+/// Any bytes: parser must not crash, value which was read must survive formatting and parsing
+template<int Prec, class RoundPolicy>
+void check_parse_bytes(fuzz_input &input) {
+    const char *text = reinterpret_cast<const char *>(input.position());
+    dec::decimal<Prec, RoundPolicy> value, again;
+    if (!dec::fromString(text, input.remaining(), dec::basic_decimal_format(), value)) {
+        return;
+    }
+    const std::string formatted = dec::toString(value);
+    if (!dec::fromString(formatted.data(), formatted.size(), dec::basic_decimal_format(), again) ||
+        again != value) {
+        fail(("round trip \"" + formatted + "\"").c_str(), policy_traits<RoundPolicy>::name(), Prec, Prec, "",
+             again.getUnbiased(), value.getUnbiased());
+    }
+}
+// <--
+
+// --> Dispatch
+
+// precisions of checked decimal types
+template<int Index>
+struct fuzz_precision;
+
+template<> struct fuzz_precision<0> { enum { value = 0 }; };
+template<> struct fuzz_precision<1> { enum { value = 1 }; };
+template<> struct fuzz_precision<2> { enum { value = 2 }; };
+template<> struct fuzz_precision<3> { enum { value = 4 }; };
+template<> struct fuzz_precision<4> { enum { value = 9 }; };
+template<> struct fuzz_precision<5> { enum { value = 18 }; };
+
+enum { fuzz_precision_count = 6 };
+
+template<class RoundPolicy, int Index>
+struct precision_dispatch {
+    static void run(unsigned int index, unsigned int op, fuzz_input &input) {
+        if (index != Index) {
+            precision_dispatch<RoundPolicy, Index - 1>::run(index, op, input);
+            return;
+        }
+        const int prec = fuzz_precision<Index / fuzz_precision_count>::value;
+        const int prec2 = fuzz_precision<Index % fuzz_precision_count>::value;
+        switch (op) {
+        case 0:
+            check_round_trip<prec, RoundPolicy>(input.value());
+            break;
+        case 1:
+            check_parse<prec, RoundPolicy>(input);
+            break;
+        case 2:
+            check_parse_bytes<prec, RoundPolicy>(input);
+            break;
+        default: {
+            const int64 a = input.value();
+            const int64 b = input.value();
+            check_binary<prec, prec2, RoundPolicy>(op, a, b);
+        }
+        }
+    }
+};
+
+template<class RoundPolicy>
+struct precision_dispatch<RoundPolicy, -1> {
+    static void run(unsigned int, unsigned int, fuzz_input &) {
+    }
+};
+
+template<class RoundPolicy>
+void run_policy(unsigned int op, fuzz_input &input) {
+    if (op == 0) {
+        const int64 a = input.value();
+        const int64 b = input.value();
+        check_div_rounded<RoundPolicy>(a, b);
+        return;
+    }
+    const unsigned int pair = input.byte() % (fuzz_precision_count * fuzz_precision_count);
+    precision_dispatch<RoundPolicy, fuzz_precision_count * fuzz_precision_count - 1>::run(pair, op - 1, input);
+}
+
+void run_one(const unsigned char *data, std::size_t size) {
+    static const bool hooked = (dec::set_stats_hook(record_event), true);
+    (void)hooked;
+
+    fuzz_input input(data, size);
+    // 0 - div_rounded, 1..3 - round trip and parsing, 4..7 - operators
+    const unsigned int op = input.byte() % 8;
+    switch (input.byte() % 8) {
+    case 0: run_policy<dec::null_round_policy>(op, input); break;
+    case 1: run_policy<dec::def_round_policy>(op, input); break;
+    case 2: run_policy<dec::half_down_round_policy>(op, input); break;
+    case 3: run_policy<dec::half_up_round_policy>(op, input); break;
+    case 4: run_policy<dec::half_even_round_policy>(op, input); break;
+    case 5: run_policy<dec::ceiling_round_policy>(op, input); break;
+    case 6: run_policy<dec::floor_round_policy>(op, input); break;
+    default: run_policy<dec::round_up_round_policy>(op, input); break;
+    }
+}
+// <--
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, std::size_t size) {
+    run_one(data, size);
+    return 0;
+}
+
+#ifndef DEC_FUZZ_LIBFUZZER
+
+int main(int argc, char *argv[]) {
+    double seconds = 10;
+    long iterations = 2000000;
+    std::size_t replayed = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::atol(argv[++i]);
+        } else {
+            std::ifstream file(argv[i], std::ios::binary);
+            if (!file) {
+                std::fprintf(stderr, "cannot read %s\n", argv[i]);
+                return 1;
+            }
+            const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            run_one(reinterpret_cast<const unsigned char *>(data.empty() ? "" : &data[0]), data.size());
+            ++replayed;
+        }
+    }
+
+    // deterministic sequence, so that failures can be reproduced
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    test_random random(1);
+    unsigned char data[64];
+    long done = 0;
+    for (; done < iterations; ++done) {
+        if (done % 1024 == 0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > seconds) {
+            break;
+        }
+        for (std::size_t i = 0; i < sizeof(data); ++i) {
+            data[i] = static_cast<unsigned char>(random.next() >> 56);
+        }
+        // short inputs exercise reading past the end
+        run_one(data, 8 + static_cast<std::size_t>(data[63] % (sizeof(data) - 8)));
+    }
+
+    std::printf("replayed %lu corpus files, checked %ld random inputs\n",
+                static_cast<unsigned long>(replayed), done);
+    return 0;
+}
+
+#endif // DEC_FUZZ_LIBFUZZER
@@ -33,20 +33,39 @@
 //   in this case define "DEC_INT64" somewhere
 // - define DEC_EXTERNAL_ROUND if you do not want internal "round()" function
 // - define DEC_CROSS_DOUBLE if you want to use double (instead of xdouble) for cross-conversions
+// - define DEC_NO_INT128 if you do not want to use compiler-provided 128-bit integers
+//   for wide intermediate results (portable code is used instead)
 // - define DEC_EXTERNAL_LIMITS to define by yourself DEC_MAX_INT32
 // - define DEC_NO_CPP11 if your compiler does not support C++11
+// - define DEC_NO_STRING_VIEW if you do not want std::string_view overloads (used with C++17)
+// - define DEC_ENABLE_STATS if you want to count slow paths and overflows of calculations
+//   (requires C++11, see get_stats())
 // - define DEC_ALLOW_SPACESHIP_OPER as 1 if your compiler supports spaceship operator
 // - define DEC_TRIVIAL_DEFAULT_CONSTRUCTIBLE as 1 if you want to make default constructor trivial
 //   use with caution because default constructor will not initialize the object
 // - define DEC_TYPE_LEVEL as 0 for strong typing (same precision required for both arguments),
 //   as 1 for allowing to mix lower or equal precision types
 //   as 2 for automatic rounding when different precision is mixed
+//   as 3 for exact results when different precision is mixed: sum and difference
+//   have higher precision, product has sum of precisions (rounded only by decimal_cast
+//   or assignment, zero when exact result does not fit), other operations work as on level 2
 
 #include <iosfwd>
 #include <iomanip>
 #include <sstream>
 #include <locale>
 #include <cmath>
+#include <cstring>
+#include <climits>
+
+#ifdef DEC_ENABLE_STATS
+#ifdef DEC_NO_CPP11
+#error "DEC_ENABLE_STATS requires C++11"
+#endif
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
 
 #ifndef DEC_TYPE_LEVEL
 #define DEC_TYPE_LEVEL 2
@@ -91,6 +110,15 @@
     #define DEC_MOVE(x) std::move(x)
 #endif
 
+#if !defined(DEC_NO_STRING_VIEW) && !defined(DEC_NO_CPP11) && \
+    ((__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)))
+#define DEC_USE_STRING_VIEW 1
+#include <string_view>
+#else
+#undef DEC_USE_STRING_VIEW
+#define DEC_USE_STRING_VIEW 0
+#endif
+
 #if (DEC_ALLOW_SPACESHIP_OPER == 1) && (__cplusplus > 201703L)
 #define DEC_USE_SPACESHIP_OPER 1
 #else
@@ -189,6 +217,7 @@ typedef xdouble cross_float;
 // Forward class definitions
 // ----------------------------------------------------------------------------
 class basic_decimal_format;
+struct format_spec;
 
 // ----------------------------------------------------------------------------
 // Constants
@@ -197,6 +226,146 @@ enum {
     max_decimal_points = 18
 };
 
+// ----------------------------------------------------------------------------
+// Statistics
+// ----------------------------------------------------------------------------
+/// Events counted when DEC_ENABLE_STATS is defined
+enum stats_event {
+    /// multDiv calculated using integer product
+    stats_mult_div_direct,
+    /// multDiv required gcd reduction of fractional parts
+    stats_mult_div_gcd,
+    /// multDiv used floating point arithmetic (result can be inexact)
+    stats_mult_div_cross_float,
+    /// rounding of fractional part in multDiv failed, part was skipped
+    stats_round_failure,
+    /// div_rounded returned false (result set to zero)
+    stats_div_overflow,
+    /// exact result of mixed precision operator (DEC_TYPE_LEVEL 3) did not fit (result set to zero)
+    stats_exact_overflow,
+    stats_event_count
+};
+
+/// Snapshot of counters, summed for all threads
+struct decimal_stats {
+    unsigned long long counters[stats_event_count];
+
+    unsigned long long operator[](stats_event event) const {
+        return counters[event];
+    }
+};
+
+/// Function called for every counted event, in thread which caused it
+typedef void (*stats_hook)(stats_event event);
+
+#ifdef DEC_ENABLE_STATS
+
+namespace details {
+
+    // counters of single thread, only owner thread writes them
+    struct stats_thread_counters;
+
+    struct stats_registry {
+        std::mutex mutex;
+        std::vector<stats_thread_counters *> threads;
+        // counters of finished threads
+        unsigned long long retired[stats_event_count];
+        std::atomic<stats_hook> hook;
+
+        stats_registry() : hook(nullptr) {
+            for (int i = 0; i < stats_event_count; ++i) {
+                retired[i] = 0;
+            }
+        }
+    };
+
+    inline stats_registry &get_stats_registry() {
+        static stats_registry registry;
+        return registry;
+    }
+
+    struct stats_thread_counters {
+        std::atomic<unsigned long long> values[stats_event_count];
+
+        stats_thread_counters() {
+            for (int i = 0; i < stats_event_count; ++i) {
+                values[i].store(0, std::memory_order_relaxed);
+            }
+            stats_registry &registry = get_stats_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.threads.push_back(this);
+        }
+
+        ~stats_thread_counters() {
+            stats_registry &registry = get_stats_registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (int i = 0; i < stats_event_count; ++i) {
+                registry.retired[i] += values[i].load(std::memory_order_relaxed);
+            }
+            for (std::size_t i = 0; i < registry.threads.size(); ++i) {
+                if (registry.threads[i] == this) {
+                    registry.threads.erase(registry.threads.begin() + i);
+                    break;
+                }
+            }
+        }
+    };
+
+    inline void stats_record(stats_event event) {
+        static thread_local stats_thread_counters counters;
+        // single writer - no atomic read-modify-write required
+        std::atomic<unsigned long long> &counter = counters.values[event];
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        const stats_hook hook = get_stats_registry().hook.load(std::memory_order_relaxed);
+        if (hook != nullptr) {
+            hook(event);
+        }
+    }
+
+} // namespace details
+
+/// Returns counters summed for all threads, counters of running threads can be
+/// a few events behind.
+inline decimal_stats get_stats() {
+    details::stats_registry &registry = details::get_stats_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    decimal_stats result;
+    for (int i = 0; i < stats_event_count; ++i) {
+        result.counters[i] = registry.retired[i];
+        for (std::size_t t = 0; t < registry.threads.size(); ++t) {
+            result.counters[i] += registry.threads[t]->values[i].load(std::memory_order_relaxed);
+        }
+    }
+    return result;
+}
+
+/// Sets hook called for every event (NULL to disable), returns previous hook.
+inline stats_hook set_stats_hook(stats_hook hook) {
+    return details::get_stats_registry().hook.exchange(hook);
+}
+
+#define DEC_STATS_EVENT(event) DEC_NAMESPACE::details::stats_record(DEC_NAMESPACE::event)
+
+#else
+
+/// Statistics are disabled - returns zero counters
+inline decimal_stats get_stats() {
+    decimal_stats result;
+    for (int i = 0; i < stats_event_count; ++i) {
+        result.counters[i] = 0;
+    }
+    return result;
+}
+
+/// Statistics are disabled - hook is never called
+inline stats_hook set_stats_hook(stats_hook) {
+    return NULL;
+}
+
+#define DEC_STATS_EVENT(event) ((void)0)
+
+#endif // DEC_ENABLE_STATS
+
 // ----------------------------------------------------------------------------
 // Class definitions
 // ----------------------------------------------------------------------------
@@ -224,6 +393,33 @@ template<int Prec> struct DecimalFactorDiff {
     static DEC_CONSTEXPR int64 value = DecimalFactorDiff_impl<Prec, Prec >= 0>::value;
 };
 
+namespace details {
+
+    /// True if rounded division a / b can use branch-free kernels below: divisor
+    /// is positive and a + b, a - b do not overflow.
+    inline bool div_kernel_range(int64 a, int64 b) {
+        return b > 0 && a <= DEC_MAX_INT64 - b && a >= DEC_MIN_INT64 + b;
+    }
+
+    /// Rounding by adding offset selected by sign of a before truncating division.
+    /// Requires div_kernel_range(a, b).
+    inline int64 div_offset_kernel(int64 a, int64 b, int64 positiveOffset, int64 negativeOffset) {
+        const int64 sign = a >> 63;
+        return (a + (positiveOffset ^ ((positiveOffset ^ negativeOffset) & sign))) / b;
+    }
+
+    /// Rounding to nearest, ties to even quotient. Requires div_kernel_range(a, b).
+    inline int64 div_half_even_kernel(int64 a, int64 b) {
+        const int64 q = a / b;
+        const int64 r = a - q * b;
+        const int64 sign = a >> 63;
+        const int64 absR = (r ^ sign) - sign;
+        const int64 up = static_cast<int64>(absR + (q & 1) > b - absR);
+        return q + ((up ^ sign) - sign);
+    }
+
+} // namespace details
+
 #ifndef DEC_EXTERNAL_ROUND
 
 // round floating point value and convert to int64
@@ -241,10 +437,13 @@ inline int64 round(T value) {
     return intPart;
 }
 
-// calculate output = round(a / b), where output, a, b are int64
-inline bool div_rounded(int64 &output, int64 a, int64 b) {
-    int64 divisorCorr = std::abs(b) / 2;
-    if (a >= 0) {
+// version of div_rounded() with branches, valid for all arguments
+inline bool div_rounded_reference(int64 &output, int64 a, int64 b) {
+    // |b| / 2 without negating b, which overflows for DEC_MIN_INT64
+    const int64 divisorCorr = (b < 0) ? -(b / 2) : b / 2;
+    if (a == DEC_MIN_INT64 && b == -1) {
+        // quotient does not fit
+    } else if (a >= 0) {
         if (DEC_MAX_INT64 - a >= divisorCorr) {
             output = (a + divisorCorr) / b;
             return true;
@@ -262,7 +461,7 @@ inline bool div_rounded(int64 &output, int64 a, int64 b) {
             return true;
         } else {
             const int64 i = a / b;
-            const int64 r = a - i * b;
+            const int64 r = i * b - a;
             if (r < divisorCorr) {
                 output = i;
                 return true;
@@ -271,11 +470,392 @@ inline bool div_rounded(int64 &output, int64 a, int64 b) {
     }
 
     output = 0;
+    DEC_STATS_EVENT(stats_div_overflow);
     return false;
 }
 
+// calculate output = round(a / b), where output, a, b are int64
+inline bool div_rounded(int64 &output, int64 a, int64 b) {
+    if (details::div_kernel_range(a, b)) {
+        output = details::div_offset_kernel(a, b, b / 2, -(b / 2));
+        return true;
+    }
+    return div_rounded_reference(output, a, b);
+}
+
 #endif // DEC_EXTERNAL_ROUND
 
+// ----------------------------------------------------------------------------
+// Wide arithmetic
+// ----------------------------------------------------------------------------
+#if !defined(DEC_NO_INT128) && defined(__SIZEOF_INT128__)
+#define DEC_USE_INT128 1
+#else
+#undef DEC_USE_INT128
+#define DEC_USE_INT128 0
+#endif
+
+namespace details {
+
+typedef unsigned long long uint64;
+
+inline int bit_length(uint64 value) {
+    int result = 0;
+    if (value >> 32) { value >>= 32; result += 32; }
+    if (value >> 16) { value >>= 16; result += 16; }
+    if (value >> 8) { value >>= 8; result += 8; }
+    if (value >> 4) { value >>= 4; result += 4; }
+    while (value != 0) { value >>= 1; ++result; }
+    return result;
+}
+
+/// Unsigned 128-bit integer used for intermediate results which do not fit in int64.
+/// Uses compiler-provided 128-bit type when available, portable code otherwise -
+/// results are the same in both cases.
+class uint128 {
+public:
+    uint128() : m_hi(0), m_lo(0) {}
+    uint128(uint64 value) : m_hi(0), m_lo(value) {}
+    uint128(uint64 hi, uint64 lo) : m_hi(hi), m_lo(lo) {}
+
+    uint64 hi() const { return m_hi; }
+    uint64 lo() const { return m_lo; }
+
+    bool isZero() const { return (m_hi | m_lo) == 0; }
+
+    int bitLength() const {
+        return (m_hi != 0) ? 64 + bit_length(m_hi) : bit_length(m_lo);
+    }
+
+    bool bit(int n) const {
+        if (n < 0 || n >= 128) return false;
+        return ((n >= 64 ? (m_hi >> (n - 64)) : (m_lo >> n)) & 1) != 0;
+    }
+
+    bool operator==(const uint128 &rhs) const { return m_hi == rhs.m_hi && m_lo == rhs.m_lo; }
+    bool operator!=(const uint128 &rhs) const { return !(*this == rhs); }
+    bool operator<(const uint128 &rhs) const {
+        return (m_hi != rhs.m_hi) ? (m_hi < rhs.m_hi) : (m_lo < rhs.m_lo);
+    }
+    bool operator>(const uint128 &rhs) const { return rhs < *this; }
+    bool operator<=(const uint128 &rhs) const { return !(rhs < *this); }
+    bool operator>=(const uint128 &rhs) const { return !(*this < rhs); }
+
+    uint128 operator+(const uint128 &rhs) const {
+        uint64 lo = m_lo + rhs.m_lo;
+        return uint128(m_hi + rhs.m_hi + (lo < m_lo ? 1 : 0), lo);
+    }
+
+    uint128 operator-(const uint128 &rhs) const {
+        uint64 lo = m_lo - rhs.m_lo;
+        return uint128(m_hi - rhs.m_hi - (m_lo < rhs.m_lo ? 1 : 0), lo);
+    }
+
+    uint128 operator<<(int n) const {
+        if (n <= 0) return *this;
+        if (n >= 128) return uint128();
+        if (n >= 64) return uint128(m_lo << (n - 64), 0);
+        return uint128((m_hi << n) | (m_lo >> (64 - n)), m_lo << n);
+    }
+
+    uint128 operator>>(int n) const {
+        if (n <= 0) return *this;
+        if (n >= 128) return uint128();
+        if (n >= 64) return uint128(0, m_hi >> (n - 64));
+        return uint128(m_hi >> n, (m_lo >> n) | (m_hi << (64 - n)));
+    }
+
+    /// Product modulo 2^128
+    uint128 operator*(const uint128 &rhs) const {
+        uint128 result = mul(m_lo, rhs.m_lo);
+        result.m_hi += m_lo * rhs.m_hi + m_hi * rhs.m_lo;
+        return result;
+    }
+
+    uint128 operator/(const uint128 &rhs) const {
+        uint128 quot, rem;
+        divmod(*this, rhs, quot, rem);
+        return quot;
+    }
+
+    uint128 operator%(const uint128 &rhs) const {
+        uint128 quot, rem;
+        divmod(*this, rhs, quot, rem);
+        return rem;
+    }
+
+    /// Full 64 x 64 -> 128 bit product
+    static uint128 mul(uint64 a, uint64 b) {
+#if DEC_USE_INT128
+        return fromNative(static_cast<native_t>(a) * b);
+#else
+        const uint64 mask = 0xffffffffULL;
+        uint64 a0 = a & mask, a1 = a >> 32;
+        uint64 b0 = b & mask, b1 = b >> 32;
+        uint64 p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+        uint64 mid = (p00 >> 32) + (p01 & mask) + (p10 & mask);
+        return uint128(p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32),
+                       (mid << 32) | (p00 & mask));
+#endif
+    }
+
+    /// Divides (hi * 2^64 + lo) by divisor, requires hi < divisor
+    static uint64 div64(uint64 hi, uint64 lo, uint64 divisor, uint64 &rem) {
+#if DEC_USE_INT128
+        native_t value = (static_cast<native_t>(hi) << 64) | lo;
+        rem = static_cast<uint64>(value % divisor);
+        return static_cast<uint64>(value / divisor);
+#else
+        uint128 quot, r;
+        divmodBits(uint128(hi, lo), uint128(divisor), quot, r);
+        rem = r.m_lo;
+        return quot.m_lo;
+#endif
+    }
+
+    /// Division by 64-bit value
+    uint128 divSmall(uint64 divisor, uint64 &rem) const {
+        uint64 qhi = m_hi / divisor;
+        uint64 qlo = div64(m_hi % divisor, m_lo, divisor, rem);
+        return uint128(qhi, qlo);
+    }
+
+    // divisor must not be zero
+    static void divmod(const uint128 &a, const uint128 &b, uint128 &quot, uint128 &rem) {
+#if DEC_USE_INT128
+        native_t na = a.native(), nb = b.native();
+        quot = fromNative(na / nb);
+        rem = fromNative(na % nb);
+#else
+        divmodBits(a, b, quot, rem);
+#endif
+    }
+
+private:
+#if !DEC_USE_INT128
+    // shift-subtract division
+    static void divmodBits(const uint128 &a, const uint128 &b, uint128 &quot, uint128 &rem) {
+        quot = uint128();
+        rem = a;
+        if (a < b) {
+            return;
+        }
+        int shift = a.bitLength() - b.bitLength();
+        uint128 d = b << shift;
+        for (int i = shift; i >= 0; --i) {
+            quot = quot << 1;
+            if (rem >= d) {
+                rem = rem - d;
+                quot.m_lo |= 1;
+            }
+            d = d >> 1;
+        }
+    }
+#endif
+
+#if DEC_USE_INT128
+    __extension__ typedef unsigned __int128 native_t;
+
+    native_t native() const {
+        return (static_cast<native_t>(m_hi) << 64) | m_lo;
+    }
+
+    static uint128 fromNative(native_t value) {
+        return uint128(static_cast<uint64>(value >> 64), static_cast<uint64>(value));
+    }
+#endif
+
+    uint64 m_hi;
+    uint64 m_lo;
+};
+
+/// Unsigned 256-bit integer, only what is needed for wide products and accumulators
+class uint256 {
+public:
+    uint256() {
+        m_limbs[0] = m_limbs[1] = m_limbs[2] = m_limbs[3] = 0;
+    }
+
+    explicit uint256(const uint128 &value) {
+        m_limbs[0] = value.lo();
+        m_limbs[1] = value.hi();
+        m_limbs[2] = 0;
+        m_limbs[3] = 0;
+    }
+
+    /// Full 128 x 128 -> 256 bit product
+    uint256(const uint128 &a, const uint128 &b) {
+        uint128 p0 = uint128::mul(a.lo(), b.lo());
+        uint128 p1 = uint128::mul(a.lo(), b.hi());
+        uint128 p2 = uint128::mul(a.hi(), b.lo());
+        uint128 p3 = uint128::mul(a.hi(), b.hi());
+        uint128 mid = uint128(p0.hi()) + uint128(p1.lo()) + uint128(p2.lo());
+        uint128 high = p3 + uint128(p1.hi()) + uint128(p2.hi()) + uint128(mid.hi());
+        m_limbs[0] = p0.lo();
+        m_limbs[1] = mid.lo();
+        m_limbs[2] = high.lo();
+        m_limbs[3] = high.hi();
+    }
+
+    uint256(uint64 l3, uint64 l2, uint64 l1, uint64 l0) {
+        m_limbs[0] = l0;
+        m_limbs[1] = l1;
+        m_limbs[2] = l2;
+        m_limbs[3] = l3;
+    }
+
+    int bitLength() const {
+        for (int i = 3; i >= 0; --i) {
+            if (m_limbs[i] != 0) return 64 * i + bit_length(m_limbs[i]);
+        }
+        return 0;
+    }
+
+    bool bit(int n) const {
+        if (n < 0 || n >= 256) return false;
+        return ((m_limbs[n / 64] >> (n % 64)) & 1) != 0;
+    }
+
+    /// Returns true if any bit below position n is set
+    bool anyBelow(int n) const {
+        if (n > 256) n = 256;
+        for (int i = 0; n > 0; ++i, n -= 64) {
+            uint64 mask = (n >= 64) ? ~0ULL : ((1ULL << n) - 1);
+            if (m_limbs[i] & mask) return true;
+        }
+        return false;
+    }
+
+    /// Returns bits [n, n + 128)
+    uint128 shiftedRight(int n) const {
+        if (n >= 256) return uint128();
+        return uint128(limbAt(n + 64), limbAt(n));
+    }
+
+    bool isZero() const {
+        return (m_limbs[0] | m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0;
+    }
+
+    bool operator==(const uint256 &rhs) const {
+        return m_limbs[0] == rhs.m_limbs[0] && m_limbs[1] == rhs.m_limbs[1] &&
+               m_limbs[2] == rhs.m_limbs[2] && m_limbs[3] == rhs.m_limbs[3];
+    }
+    bool operator!=(const uint256 &rhs) const { return !(*this == rhs); }
+    bool operator<(const uint256 &rhs) const {
+        for (int i = 3; i > 0; --i) {
+            if (m_limbs[i] != rhs.m_limbs[i]) return m_limbs[i] < rhs.m_limbs[i];
+        }
+        return m_limbs[0] < rhs.m_limbs[0];
+    }
+    bool operator>(const uint256 &rhs) const { return rhs < *this; }
+    bool operator<=(const uint256 &rhs) const { return !(rhs < *this); }
+    bool operator>=(const uint256 &rhs) const { return !(*this < rhs); }
+
+    /// Sum modulo 2^256
+    uint256 operator+(const uint256 &rhs) const {
+        uint256 result;
+        uint64 carry = 0;
+        for (int i = 0; i < 4; ++i) {
+            const uint64 sum = m_limbs[i] + carry;
+            carry = (sum < carry) ? 1 : 0;
+            result.m_limbs[i] = sum + rhs.m_limbs[i];
+            carry += (result.m_limbs[i] < sum) ? 1 : 0;
+        }
+        return result;
+    }
+
+    /// Difference modulo 2^256
+    uint256 operator-(const uint256 &rhs) const {
+        uint256 result;
+        uint64 borrow = 0;
+        for (int i = 0; i < 4; ++i) {
+            const uint64 diff = m_limbs[i] - rhs.m_limbs[i];
+            const uint64 nextBorrow = (m_limbs[i] < rhs.m_limbs[i] || diff < borrow) ? 1 : 0;
+            result.m_limbs[i] = diff - borrow;
+            borrow = nextBorrow;
+        }
+        return result;
+    }
+
+    uint256 operator<<(int n) const {
+        if (n <= 0) return *this;
+        uint256 result;
+        for (int i = 3; i >= 0; --i) {
+            result.m_limbs[i] = limbAt(64 * i - n);
+        }
+        return result;
+    }
+
+    uint256 operator>>(int n) const {
+        if (n <= 0) return *this;
+        uint256 result;
+        for (int i = 0; i < 4; ++i) {
+            result.m_limbs[i] = limbAt(64 * i + n);
+        }
+        return result;
+    }
+
+    /// Calculates output = a * b
+    /// \result Returns false if product does not fit in 256 bits
+    static bool mul(const uint256 &a, const uint128 &b, uint256 &output) {
+        uint64 product[6] = {0, 0, 0, 0, 0, 0};
+        const uint64 factors[2] = {b.lo(), b.hi()};
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                const uint128 part = uint128::mul(a.m_limbs[i], factors[j]);
+                addAt(product, i + j, part.lo());
+                addAt(product, i + j + 1, part.hi());
+            }
+        }
+        for (int i = 0; i < 4; ++i) {
+            output.m_limbs[i] = product[i];
+        }
+        return (product[4] | product[5]) == 0;
+    }
+
+    // divisor must not be zero, shift-subtract division
+    static void divmod(const uint256 &a, const uint256 &b, uint256 &quot, uint256 &rem) {
+        quot = uint256();
+        rem = a;
+        if (a < b) {
+            return;
+        }
+        int shift = a.bitLength() - b.bitLength();
+        uint256 d = b << shift;
+        for (int i = shift; i >= 0; --i) {
+            quot = quot << 1;
+            if (rem >= d) {
+                rem = rem - d;
+                quot.m_limbs[0] |= 1;
+            }
+            d = d >> 1;
+        }
+    }
+
+private:
+    // adds value at limb idx of 6-limb number
+    static void addAt(uint64 *limbs, int idx, uint64 value) {
+        for (; value != 0 && idx < 6; ++idx) {
+            limbs[idx] += value;
+            value = (limbs[idx] < value) ? 1 : 0;
+        }
+    }
+
+    // 64 bits starting at bit position n, zero bits outside of number
+    uint64 limbAt(int n) const {
+        if (n <= -64) return 0;
+        if (n < 0) return m_limbs[0] << (-n);
+        int idx = n / 64, off = n % 64;
+        uint64 low = (idx < 4) ? m_limbs[idx] : 0;
+        uint64 high = (idx + 1 < 4) ? m_limbs[idx + 1] : 0;
+        return (off == 0) ? low : ((low >> off) | (high << (64 - off)));
+    }
+
+    uint64 m_limbs[4];
+};
+
+} // namespace details
+
 template<class RoundPolicy>
 class dec_utils {
 public:
@@ -284,16 +864,19 @@ public:
                                 int64 divisor) {
 
         if (value1 == 0 || value2 == 0) {
+            DEC_STATS_EVENT(stats_mult_div_direct);
             return 0;
         }
 
         if (divisor == 1) {
+            DEC_STATS_EVENT(stats_mult_div_direct);
             return value1 * value2;
         }
 
         if (value1 == 1) {
             int64 result;
             if (RoundPolicy::div_rounded(result, value2, divisor)) {
+                DEC_STATS_EVENT(stats_mult_div_direct);
                 return result;
             }
         }
@@ -301,6 +884,7 @@ public:
         if (value2 == 1) {
             int64 result;
             if (RoundPolicy::div_rounded(result, value1, divisor)) {
+                DEC_STATS_EVENT(stats_mult_div_direct);
                 return result;
             }
         }
@@ -314,42 +898,45 @@ public:
         int64 result = value1 * value2int + value1int * value2dec;
 
         if (value1dec == 0 || value2dec == 0) {
+            DEC_STATS_EVENT(stats_mult_div_direct);
             return result;
         }
 
         if (!isMultOverflow(value1dec, value2dec)) { // no overflow
-            int64 resDecPart = value1dec * value2dec;
-            if (!RoundPolicy::div_rounded(resDecPart, resDecPart, divisor))
-                resDecPart = 0;
-            result += resDecPart;
+            if (!addRounded(result, value1dec * value2dec, divisor)) {
+                DEC_STATS_EVENT(stats_round_failure);
+            }
+            DEC_STATS_EVENT(stats_mult_div_direct);
             return result;
         }
 
         // minimize value1 & divisor
         {
+            // gcd can be negative, -1 would overflow for divisor equal to DEC_MIN_INT64
             int64 c = gcd(value1dec, divisor);
-            if (c != 1) {
+            if (c != 1 && c != -1) {
                 value1dec /= c;
                 divisor /= c;
             }
 
             // minimize value2 & divisor
             c = gcd(value2dec, divisor);
-            if (c != 1) {
+            if (c != 1 && c != -1) {
                 value2dec /= c;
                 divisor /= c;
             }
         }
 
         if (!isMultOverflow(value1dec, value2dec)) { // no overflow
-            int64 resDecPart = value1dec * value2dec;
-            if (RoundPolicy::div_rounded(resDecPart, resDecPart, divisor)) {
-                result += resDecPart;
+            if (addRounded(result, value1dec * value2dec, divisor)) {
+                DEC_STATS_EVENT(stats_mult_div_gcd);
                 return result;
             }
+            DEC_STATS_EVENT(stats_round_failure);
         }
 
         // overflow can occur - use less precise version
+        DEC_STATS_EVENT(stats_mult_div_cross_float);
         result += RoundPolicy::round(
                 static_cast<cross_float>(value1dec)
                         * static_cast<cross_float>(value2dec)
@@ -357,6 +944,35 @@ public:
         return result;
     }
 
+    // result += round(value / divisor), where value / divisor has the same sign as result.
+    // Only parity and sign of result are passed to rounding policy, so that half-even
+    // rounding depends on the whole result. Result is not changed on failure.
+    static bool addRounded(int64 &result, int64 value, int64 divisor) {
+        const int64 quotient = value / divisor;
+        const int64 remainder = value % divisor;
+        if (remainder == 0) {
+            result += quotient;
+            return true;
+        }
+        const int64 total = result + quotient;
+        const bool negative = (remainder < 0) != (divisor < 0);
+        const details::uint64 absRemainder = (remainder < 0) ? 0 - static_cast<details::uint64>(remainder)
+                                                             : static_cast<details::uint64>(remainder);
+        const details::uint64 absDivisor = (divisor < 0) ? 0 - static_cast<details::uint64>(divisor)
+                                                         : static_cast<details::uint64>(divisor);
+        const details::uint64 rest = absDivisor - absRemainder;
+        // fraction class: 1 = below half, 2 = exactly half, 3 = above half
+        const int64 fractionClass = (absRemainder < rest) ? 1 : ((absRemainder == rest) ? 2 : 3);
+        const int64 parity = total & 1;
+        const int64 a = parity * 4 + fractionClass;
+        int64 delta;
+        if (!RoundPolicy::div_rounded(delta, negative ? -a : a, 4)) {
+            return false;
+        }
+        result = total + delta - (negative ? -parity : parity);
+        return true;
+    }
+
     static bool isMultOverflow(const int64 value1, const int64 value2) {
        if (value1 == 0 || value2 == 0) {
            return false;
@@ -386,6 +1002,21 @@ public:
        return (value1 > DEC_MAX_INT64 / value2);
     }
 
+    // result = value1 * factor1 + value2 * factor2, returns false if it does not fit in int64
+    static bool scaledSum(int64 &result, const int64 value1, const int64 factor1,
+                          const int64 value2, const int64 factor2) {
+        if (isMultOverflow(value1, factor1) || isMultOverflow(value2, factor2)) {
+            return false;
+        }
+        const int64 term1 = value1 * factor1;
+        const int64 term2 = value2 * factor2;
+        if ((term2 > 0) ? (term1 > DEC_MAX_INT64 - term2) : (term1 < DEC_MIN_INT64 - term2)) {
+            return false;
+        }
+        result = term1 + term2;
+        return true;
+    }
+
     static int64 pow10(int n) {
         static const int64 decimalFactorTable[] = { 1, 10, 100, 1000, 10000,
                 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000,
@@ -419,6 +1050,37 @@ private:
 
 };
 
+namespace details {
+
+    /// Calculates truncated quotient and remainder. Exact quotient is further from zero
+    /// than truncated one when remainder is not zero; it is positive when remainder
+    /// and divisor have the same sign.
+    /// \result Returns false if quotient does not fit in int64
+    inline bool div_truncated(int64 &quotient, int64 &remainder, int64 a, int64 b) {
+        if (a == DEC_MIN_INT64 && b == -1) {
+            return false;
+        }
+        quotient = a / b;
+        remainder = a % b;
+        return true;
+    }
+
+    /// Moves sign of divisor to dividend, so that rounding can assume positive divisor.
+    /// \result Returns false if this is not possible without overflow
+    inline bool div_positive_divisor(int64 &a, int64 &b) {
+        if (b > 0) {
+            return true;
+        }
+        if (a == DEC_MIN_INT64 || b == DEC_MIN_INT64) {
+            return false;
+        }
+        a = -a;
+        b = -b;
+        return true;
+    }
+
+} // namespace details
+
 // no-rounding policy (decimal places stripped)
 class null_round_policy {
 public:
@@ -444,6 +1106,15 @@ public:
     static bool div_rounded(int64 &output, int64 a, int64 b) {
         return DEC_NAMESPACE::div_rounded(output, a, b);
     }
+
+    /// Version of div_rounded() with branches, valid for all arguments
+    static bool div_rounded_reference(int64 &output, int64 a, int64 b) {
+#ifndef DEC_EXTERNAL_ROUND
+        return DEC_NAMESPACE::div_rounded_reference(output, a, b);
+#else
+        return DEC_NAMESPACE::div_rounded(output, a, b);
+#endif
+    }
 };
 
 class half_down_round_policy {
@@ -473,8 +1144,23 @@ public:
     }
 
     static bool div_rounded(int64 &output, int64 a, int64 b) {
+        if (details::div_kernel_range(a, b)) {
+            output = details::div_offset_kernel(a, b, (b - 1) / 2, -(b / 2));
+            return true;
+        }
+        return div_rounded_reference(output, a, b);
+    }
+
+    /// Version of div_rounded() with branches, valid for all arguments
+    static bool div_rounded_reference(int64 &output, int64 a, int64 b) {
+        if (!details::div_positive_divisor(a, b)) {
+            output = 0;
+            DEC_STATS_EVENT(stats_div_overflow);
+            return false;
+        }
         int64 divisorCorr = std::abs(b) / 2;
-        int64 remainder = std::abs(a) % std::abs(b);
+        // divisor is positive here, so remainder of DEC_MIN_INT64 is safe to negate
+        int64 remainder = (a < 0) ? -(a % b) : a % b;
 
         if (a >= 0) {
             if (DEC_MAX_INT64 - a >= divisorCorr) {
@@ -493,6 +1179,7 @@ public:
         }
 
         output = 0;
+        DEC_STATS_EVENT(stats_div_overflow);
         return false;
     }
 };
@@ -524,8 +1211,23 @@ public:
     }
 
     static bool div_rounded(int64 &output, int64 a, int64 b) {
+        if (details::div_kernel_range(a, b)) {
+            output = details::div_offset_kernel(a, b, b / 2, -((b - 1) / 2));
+            return true;
+        }
+        return div_rounded_reference(output, a, b);
+    }
+
+    /// Version of div_rounded() with branches, valid for all arguments
+    static bool div_rounded_reference(int64 &output, int64 a, int64 b) {
+        if (!details::div_positive_divisor(a, b)) {
+            output = 0;
+            DEC_STATS_EVENT(stats_div_overflow);
+            return false;
+        }
         int64 divisorCorr = std::abs(b) / 2;
-        int64 remainder = std::abs(a) % std::abs(b);
+        // divisor is positive here, so remainder of DEC_MIN_INT64 is safe to negate
+        int64 remainder = (a < 0) ? -(a % b) : a % b;
 
         if (a >= 0) {
             if (DEC_MAX_INT64 - a >= divisorCorr) {
@@ -550,6 +1252,7 @@ public:
         }
 
         output = 0;
+        DEC_STATS_EVENT(stats_div_overflow);
         return false;
     }
 };
@@ -596,43 +1299,31 @@ public:
     }
 
     static bool div_rounded(int64 &output, int64 a, int64 b) {
-        int64 divisorDiv2 = std::abs(b) / 2;
-        int64 remainder = std::abs(a) % std::abs(b);
-
-        if (remainder == 0) {
-            output = a / b;
-        } else {
-            if (a >= 0) {
+        if (details::div_kernel_range(a, b)) {
+            output = details::div_half_even_kernel(a, b);
+            return true;
+        }
+        return div_rounded_reference(output, a, b);
+    }
 
-                if (remainder > divisorDiv2) {
-                    output = (a - remainder + std::abs(b)) / b;
-                } else if (remainder < divisorDiv2) {
-                    output = (a - remainder) / b;
-                } else {
-                    bool is_even = std::abs(a / b) % 2 == 0;
-                    if (is_even) {
-                        output = a / b;
-                    } else {
-                        output = (a - remainder + std::abs(b)) / b;
-                    }
-                }
-            } else {
-                // negative value
-                if (remainder > divisorDiv2) {
-                    output = (a + remainder - std::abs(b)) / b;
-                } else if (remainder < divisorDiv2) {
-                    output = (a + remainder) / b;
-                } else {
-                    bool is_even = std::abs(a / b) % 2 == 0;
-                    if (is_even) {
-                        output = a / b;
-                    } else {
-                        output = (a + remainder - std::abs(b)) / b;
-                    }
-                }
-            }
+    /// Version of div_rounded() with branches, valid for all arguments
+    static bool div_rounded_reference(int64 &output, int64 a, int64 b) {
+        int64 quotient, remainder;
+        if (!details::div_truncated(quotient, remainder, a, b)) {
+            output = 0;
+            DEC_STATS_EVENT(stats_div_overflow);
+            return false;
+        }
+        // compare |remainder| with |b| - |remainder|, without overflow
+        const details::uint64 absRemainder = (remainder < 0) ? 0 - static_cast<details::uint64>(remainder)
+                                                             : static_cast<details::uint64>(remainder);
+        const details::uint64 absDivisor = (b < 0) ? 0 - static_cast<details::uint64>(b)
+                                                   : static_cast<details::uint64>(b);
+        const details::uint64 rest = absDivisor - absRemainder;
+        output = quotient;
+        if (absRemainder > rest || (absRemainder == rest && quotient % 2 != 0)) {
+            output += ((remainder < 0) == (b < 0)) ? 1 : -1;
         }
-
         return true;
     }
 };
@@ -646,15 +1337,24 @@ public:
     }
 
     static bool div_rounded(int64 &output, int64 a, int64 b) {
-        int64 remainder = std::abs(a) % std::abs(b);
-        if (remainder == 0) {
-            output = a / b;
-        } else {
-            if (a >= 0) {
-                output = (a + std::abs(b)) / b;
-            } else {
-                output = a / b;
-            }
+        if (details::div_kernel_range(a, b)) {
+            output = details::div_offset_kernel(a, b, b - 1, 0);
+            return true;
+        }
+        return div_rounded_reference(output, a, b);
+    }
+
+    /// Version of div_rounded() with branches, valid for all arguments
+    static bool div_rounded_reference(int64 &output, int64 a, int64 b) {
+        int64 quotient, remainder;
+        if (!details::div_truncated(quotient, remainder, a, b)) {
+            output = 0;
+            DEC_STATS_EVENT(stats_div_overflow);
+            return false;
+        }
+        output = quotient;
+        if (remainder != 0 && (remainder < 0) == (b < 0)) {
+            ++output;
         }
         return true;
     }
@@ -669,15 +1369,24 @@ public:
     }
 
     static bool div_rounded(int64 &output, int64 a, int64 b) {
-        int64 remainder = std::abs(a) % std::abs(b);
-        if (remainder == 0) {
-            output = a / b;
-        } else {
-            if (a >= 0) {
-                output = (a - remainder) / b;
-            } else {
-                output = (a + remainder - std::abs(b)) / b;
-            }
+        if (details::div_kernel_range(a, b)) {
+            output = details::div_offset_kernel(a, b, 0, -(b - 1));
+            return true;
+        }
+        return div_rounded_reference(output, a, b);
+    }
+
+    /// Version of div_rounded() with branches, valid for all arguments
+    static bool div_rounded_reference(int64 &output, int64 a, int64 b) {
+        int64 quotient, remainder;
+        if (!details::div_truncated(quotient, remainder, a, b)) {
+            output = 0;
+            DEC_STATS_EVENT(stats_div_overflow);
+            return false;
+        }
+        output = quotient;
+        if (remainder != 0 && (remainder < 0) != (b < 0)) {
+            --output;
         }
         return true;
     }
@@ -700,21 +1409,730 @@ public:
     }
 
     static bool div_rounded(int64 &output, int64 a, int64 b) {
-        int64 remainder = std::abs(a) % std::abs(b);
-        if (remainder == 0) {
-            output = a / b;
+        if (details::div_kernel_range(a, b)) {
+            output = details::div_offset_kernel(a, b, b - 1, -(b - 1));
+            return true;
+        }
+        return div_rounded_reference(output, a, b);
+    }
+
+    /// Version of div_rounded() with branches, valid for all arguments
+    static bool div_rounded_reference(int64 &output, int64 a, int64 b) {
+        int64 quotient, remainder;
+        if (!details::div_truncated(quotient, remainder, a, b)) {
+            output = 0;
+            DEC_STATS_EVENT(stats_div_overflow);
+            return false;
+        }
+        output = quotient;
+        if (remainder != 0) {
+            output += ((remainder < 0) == (b < 0)) ? 1 : -1;
+        }
+        return true;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Runtime rounding policy
+// ----------------------------------------------------------------------------
+/// Rounding policy selected at runtime (e.g. from configuration),
+/// every value corresponds to one of policy classes above.
+enum runtime_round_policy {
+    round_policy_def,
+    round_policy_null,
+    round_policy_half_down,
+    round_policy_half_up,
+    round_policy_half_even,
+    round_policy_ceiling,
+    round_policy_floor,
+    round_policy_round_down,
+    round_policy_round_up
+};
+
+/// Calls visitor with instance of policy class selected by runtime value.
+/// Visitor should define result_type and template operator()(const RoundPolicy &).
+/// Use it to select template version of bulk operation once per batch.
+template<class Visitor>
+typename Visitor::result_type visit_round_policy(runtime_round_policy policy, Visitor &visitor) {
+    switch (policy) {
+    case round_policy_null:
+        return visitor(null_round_policy());
+    case round_policy_half_down:
+        return visitor(half_down_round_policy());
+    case round_policy_half_up:
+        return visitor(half_up_round_policy());
+    case round_policy_half_even:
+        return visitor(half_even_round_policy());
+    case round_policy_ceiling:
+        return visitor(ceiling_round_policy());
+    case round_policy_floor:
+        return visitor(floor_round_policy());
+    case round_policy_round_down:
+        return visitor(round_down_round_policy());
+    case round_policy_round_up:
+        return visitor(round_up_round_policy());
+    default:
+        return visitor(def_round_policy());
+    }
+}
+
+namespace details {
+
+    /// Functions of single policy, called through pointers
+    struct runtime_round_functions {
+        bool (*div_rounded)(int64 &output, int64 a, int64 b);
+        int64 (*multDiv)(const int64 value1, const int64 value2, int64 divisor);
+    };
+
+    /// Returns jump table entry for policy, unknown values use def_round_policy.
+    inline const runtime_round_functions &get_round_functions(runtime_round_policy policy) {
+        // order must match runtime_round_policy
+        static const runtime_round_functions table[] = {
+            { &def_round_policy::div_rounded, &dec_utils<def_round_policy>::multDiv },
+            { &null_round_policy::div_rounded, &dec_utils<null_round_policy>::multDiv },
+            { &half_down_round_policy::div_rounded, &dec_utils<half_down_round_policy>::multDiv },
+            { &half_up_round_policy::div_rounded, &dec_utils<half_up_round_policy>::multDiv },
+            { &half_even_round_policy::div_rounded, &dec_utils<half_even_round_policy>::multDiv },
+            { &ceiling_round_policy::div_rounded, &dec_utils<ceiling_round_policy>::multDiv },
+            { &floor_round_policy::div_rounded, &dec_utils<floor_round_policy>::multDiv },
+            { &round_down_round_policy::div_rounded, &dec_utils<round_down_round_policy>::multDiv },
+            { &round_up_round_policy::div_rounded, &dec_utils<round_up_round_policy>::multDiv }
+        };
+        const unsigned int index = static_cast<unsigned int>(policy);
+        return table[index < sizeof(table) / sizeof(table[0]) ? index : 0];
+    }
+
+    // names accepted by parse_round_policy, order must match runtime_round_policy
+    inline const char *const *round_policy_names() {
+        static const char *const names[] = {
+            "def", "null", "half_down", "half_up", "half_even",
+            "ceiling", "floor", "round_down", "round_up"
+        };
+        return names;
+    }
+
+} // namespace details
+
+/// Division with rounding selected at runtime, see def_round_policy::div_rounded.
+inline bool div_rounded(int64 &output, int64 a, int64 b, runtime_round_policy policy) {
+    return details::get_round_functions(policy).div_rounded(output, a, b);
+}
+
+/// result = (value1 * value2) / divisor, rounded with policy selected at runtime
+inline int64 multDiv(const int64 value1, const int64 value2, int64 divisor, runtime_round_policy policy) {
+    return details::get_round_functions(policy).multDiv(value1, value2, divisor);
+}
+
+/// Returns name of policy, e.g. "half_even" for round_policy_half_even
+inline const char *round_policy_name(runtime_round_policy policy) {
+    const unsigned int index = static_cast<unsigned int>(policy);
+    return (index <= round_policy_round_up) ? details::round_policy_names()[index] : "def";
+}
+
+/// Converts policy name (see round_policy_name) to policy value.
+/// \result Returns false and leaves output unchanged if name is not recognized
+inline bool parse_round_policy(const std::string &name, runtime_round_policy &output) {
+    for (int i = 0; i <= round_policy_round_up; ++i) {
+        if (name == details::round_policy_names()[i]) {
+            output = static_cast<runtime_round_policy>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+// Math functions support
+// ----------------------------------------------------------------------------
+// Only integer arithmetic is used, so results do not depend on compiler or platform.
+namespace details {
+
+    /// Rounds q + fraction using rounding policy, where fraction is described only
+    /// by its class: 0 = exact, 1 = below half, 2 = exactly half, 3 = above half.
+    /// Sign is applied before rounding.
+    template<class RoundPolicy>
+    bool round_sticky(int64 &output, bool negative, const uint128 &q, int fractionClass) {
+        if (q > uint128(static_cast<uint64>(DEC_MAX_INT64))) {
+            // only -2^63 fits, when fraction is rounded towards zero
+            int64 delta;
+            if (!negative || q != uint128(static_cast<uint64>(DEC_MAX_INT64) + 1) ||
+                !RoundPolicy::div_rounded(delta, -fractionClass, 4) || delta != 0) {
+                return false;
+            }
+            output = DEC_MIN_INT64;
+            return true;
+        }
+        const int64 parity = static_cast<int64>(q.lo() & 1);
+        const int64 base = static_cast<int64>(q.lo()) - parity;
+        const int64 a = parity * 4 + fractionClass;
+        int64 delta;
+        if (!RoundPolicy::div_rounded(delta, negative ? -a : a, 4)) {
+            return false;
+        }
+        if (negative) {
+            output = delta - base;
         } else {
-            if (a >= 0) {
-                output = (a + std::abs(b)) / b;
-            } else {
-                output = (a - std::abs(b)) / b;
+            if (delta > 0 && base > DEC_MAX_INT64 - delta) {
+                return false;
+            }
+            output = base + delta;
+        }
+        return true;
+    }
+
+    /// Classifies remainder of division by divisor, see round_sticky
+    inline int fraction_class(const uint128 &rem, const uint128 &divisor) {
+        if (rem.isZero()) return 0;
+        const uint128 rest = divisor - rem;
+        return (rem < rest) ? 1 : ((rem == rest) ? 2 : 3);
+    }
+
+    /// Calculates output = round(value * scale / 2^shift)
+    /// If inexact is true, value is known to be an approximation of a number which
+    /// is never exactly at the rounding boundary.
+    template<class RoundPolicy>
+    bool round_scaled(int64 &output, bool negative, const uint128 &value, int shift,
+                      uint64 scale, bool inexact) {
+        const uint256 product(value, uint128(scale));
+        uint128 q;
+        int fractionClass;
+        if (shift <= 0) {
+            if (product.bitLength() - shift > 63) {
+                return false;
+            }
+            q = product.shiftedRight(0) << (-shift);
+            fractionClass = 0;
+        } else {
+            if (product.bitLength() - shift > 63) {
+                return false;
+            }
+            q = product.shiftedRight(shift);
+            const bool half = product.bit(shift - 1);
+            const bool rest = product.anyBelow(shift - 1);
+            fractionClass = half ? (rest ? 3 : 2) : (rest ? 1 : 0);
+        }
+        if (inexact && (fractionClass == 0 || fractionClass == 2)) {
+            ++fractionClass;
+        }
+        return round_sticky<RoundPolicy>(output, negative, q, fractionClass);
+    }
+
+    inline uint128 pow10_wide(int n) {
+        uint128 result(1);
+        while (n-- > 0) {
+            result = result * uint128(10);
+        }
+        return result;
+    }
+
+    inline uint64 abs_unsigned(int64 value) {
+        return (value < 0) ? static_cast<uint64>(-(value + 1)) + 1 : static_cast<uint64>(value);
+    }
+
+    inline uint64 gcd_unsigned(uint64 a, uint64 b) {
+        while (b != 0) {
+            const uint64 rest = a % b;
+            a = b;
+            b = rest;
+        }
+        return a;
+    }
+
+    /// Calculates output = round(value / 10^n) for any n >= 0, without overflow
+    template<class RoundPolicy>
+    bool div_pow10_rounded(int64 &output, int64 value, int n) {
+        const bool negative = value < 0;
+        const uint128 absValue(abs_unsigned(value));
+        if (n > 38) {
+            // |value| < 10^19, so quotient is below half
+            return round_sticky<RoundPolicy>(output, negative, uint128(), absValue.isZero() ? 0 : 1);
+        }
+        const uint128 divisor = pow10_wide(n);
+        uint128 quot, rem;
+        uint128::divmod(absValue, divisor, quot, rem);
+        return round_sticky<RoundPolicy>(output, negative, quot, fraction_class(rem, divisor));
+    }
+
+    /// Calculates base^n, returns false if result is greater than limit
+    inline bool checked_pow(uint128 &output, uint64 base, unsigned int n, const uint128 &limit) {
+        uint128 result(1);
+        uint128 factor(base);
+        while (true) {
+            if (n & 1) {
+                if (result.bitLength() + factor.bitLength() > 128) return false;
+                result = result * factor;
+                if (result > limit) return false;
             }
+            n >>= 1;
+            if (n == 0) break;
+            if (2 * factor.bitLength() > 128) return false;
+            factor = factor * factor;
+            if (factor > limit) return false;
         }
+        output = result;
         return true;
     }
+
+    /// Binary floating point value with 128-bit mantissa: mant * 2^exp2.
+    /// Mantissa is normalized (highest bit set). All operations truncate,
+    /// exact is cleared when any nonzero bit was dropped.
+    struct wide_float {
+        uint128 mant;
+        int exp2;
+        bool exact;
+
+        /// Creates num / den, num must not be zero
+        static wide_float fromRatio(uint64 num, uint64 den) {
+            // quotient = num * 2^192 / den, at least 129 bits long
+            uint64 rem = num % den;
+            const uint64 q3 = num / den;
+            const uint64 q2 = uint128::div64(rem, 0, den, rem);
+            const uint64 q1 = uint128::div64(rem, 0, den, rem);
+            const uint64 q0 = uint128::div64(rem, 0, den, rem);
+            const uint256 quot(q3, q2, q1, q0);
+            const int shift = quot.bitLength() - 128;
+            wide_float result;
+            result.mant = quot.shiftedRight(shift);
+            result.exp2 = shift - 192;
+            result.exact = (rem == 0) && !quot.anyBelow(shift);
+            return result;
+        }
+
+        wide_float operator*(const wide_float &rhs) const {
+            const uint256 product(mant, rhs.mant);
+            const int shift = product.bitLength() - 128;
+            wide_float result;
+            result.mant = product.shiftedRight(shift);
+            result.exp2 = exp2 + rhs.exp2 + shift;
+            result.exact = exact && rhs.exact && !product.anyBelow(shift);
+            // tiny values are kept tiny, without risk of exponent overflow
+            if (result.exp2 < min_exp2) {
+                result.exp2 = min_exp2;
+                result.exact = false;
+            }
+            return result;
+        }
+
+        enum {
+            min_exp2 = -4096,
+            max_exp2 = 256
+        };
+    };
+
+    /// Constants in fixed point format with 120 fractional bits
+    class math_constants {
+    public:
+        static uint128 ln2() {
+            return uint128(0x00b17217f7d1cf79ULL, 0xabc9e3b39803f2f6ULL);
+        }
+
+        static uint128 ln10() {
+            return uint128(0x024d763776aaa2b0ULL, 0x5ba95b58ae0b4c28ULL);
+        }
+
+        // exp(n / 16)
+        static uint128 exp16(int n) {
+            static const uint64 table[][2] = {
+                {0x0100000000000000ULL, 0x0000000000000000ULL},
+                {0x011082b577d34ed7ULL, 0xd5b1a019e225c9a9ULL},
+                {0x012216045b6f5ccfULL, 0x9ced688384e06b8dULL},
+                {0x0134cb8170b58352ULL, 0xd4e0c48cb7c66493ULL},
+                {0x0148b5e3c3e81866ULL, 0x767bc3b69baabe53ULL},
+                {0x015de9176045ff53ULL, 0xb513246531754403ULL},
+                {0x01747a513dbef6a6ULL, 0x23478b659b092405ULL},
+                {0x018c802477b000fdULL, 0xc24db40ed853110bULL},
+                {0x01a61298e1e069bcULL, 0x972dfefab6df33f9ULL},
+                {0x01c14b4312564464ULL, 0x432aa513ba422005ULL},
+                {0x01de455df80e3c05ULL, 0xca897b072f6daa5bULL},
+                {0x01fd1de6182f8c89ULL, 0xd2c3b6d08c659722ULL}
+            };
+            return uint128(table[n][0], table[n][1]);
+        }
+
+        // exp(n / 256)
+        static uint128 exp256(int n) {
+            static const uint64 table[][2] = {
+                {0x0100000000000000ULL, 0x0000000000000000ULL},
+                {0x010100802ab55777ULL, 0xd28a2a42d26aa9eeULL},
+                {0x010202015600445bULL, 0x0c326382bc73689dULL},
+                {0x010304848362076aULL, 0x08d9411a1cee76caULL},
+                {0x0104080ab55de391ULL, 0x7ab864b3e9044e6bULL},
+                {0x01050c94ef7a206dULL, 0xc2da1f7b86de3f8eULL},
+                {0x0106122436410dd1ULL, 0x4e5659d75e95b76eULL},
+                {0x010718b98f42084eULL, 0xfbdb328b919e6909ULL},
+                {0x0108205601127ec9ULL, 0x8e0bd083aba80c97ULL},
+                {0x010928fa934ef909ULL, 0x3044ef6e13adf7cdULL},
+                {0x010a32a84e9c1f58ULL, 0x145cc1cf959b1b11ULL},
+                {0x010b3d603ca7c327ULL, 0x30fadc469f215fd2ULL},
+                {0x010c49236829e8bcULL, 0x292cfe63d64b295eULL},
+                {0x010d55f2dce5d1e9ULL, 0x66e6b6d0a6a8e24eULL},
+                {0x010e63cfa7ab09d1ULL, 0x7324137d6c341c1dULL},
+                {0x010f72bad65671b6ULL, 0x9772cc4a342d0e03ULL}
+            };
+            return uint128(table[n][0], table[n][1]);
+        }
+
+        // ln(1 + n / 16)
+        static uint128 ln16(int n) {
+            static const uint64 table[][2] = {
+                {0x0000000000000000ULL, 0x0000000000000000ULL},
+                {0x000f85186008b153ULL, 0x30be64b8b7759978ULL},
+                {0x001e27076e2af2e5ULL, 0xe9ea87ffe1fe9e15ULL},
+                {0x002bfe60e14f27a7ULL, 0x90e7c4140e424775ULL},
+                {0x00391fef8f353443ULL, 0x584bb03de5ff7344ULL},
+                {0x00459d72aeae9838ULL, 0x0e731f55c41b8b82ULL},
+                {0x0051862f08717b09ULL, 0xf42decdeccf1cd10ULL},
+                {0x005ce75fdaef401aULL, 0x7389314feb4fbde5ULL},
+                {0x0067cc8fb2fe612fULL, 0xcada35d9bd014886ULL},
+                {0x00723fdf1e6a6886ULL, 0xb097607bcbfee689ULL},
+                {0x007c4a3d7ebc1bb2ULL, 0xcd720ec44c73d75cULL},
+                {0x0085f39721295415ULL, 0xb4c4bdd99effe69bULL},
+                {0x008f42faf3820681ULL, 0xef62cd2f9f1e35f2ULL},
+                {0x00983eb99a7885f0ULL, 0xfdac850fab36cdeeULL},
+                {0x00a0ec7f42339573ULL, 0x2325e617a300bbcaULL},
+                {0x00a9516932de2d57ULL, 0x73be4578ad97aea7ULL}
+            };
+            return uint128(table[n][0], table[n][1]);
+        }
+
+        // 1 / (1 + n / 16), rounded up
+        static uint128 inv16(int n) {
+            static const uint64 table[][2] = {
+                {0x0100000000000000ULL, 0x0000000000000000ULL},
+                {0x00f0f0f0f0f0f0f0ULL, 0xf0f0f0f0f0f0f0f1ULL},
+                {0x00e38e38e38e38e3ULL, 0x8e38e38e38e38e39ULL},
+                {0x00d79435e50d7943ULL, 0x5e50d79435e50d7aULL},
+                {0x00ccccccccccccccULL, 0xcccccccccccccccdULL},
+                {0x00c30c30c30c30c3ULL, 0x0c30c30c30c30c31ULL},
+                {0x00ba2e8ba2e8ba2eULL, 0x8ba2e8ba2e8ba2e9ULL},
+                {0x00b21642c8590b21ULL, 0x642c8590b21642c9ULL},
+                {0x00aaaaaaaaaaaaaaULL, 0xaaaaaaaaaaaaaaabULL},
+                {0x00a3d70a3d70a3d7ULL, 0x0a3d70a3d70a3d71ULL},
+                {0x009d89d89d89d89dULL, 0x89d89d89d89d89d9ULL},
+                {0x0097b425ed097b42ULL, 0x5ed097b425ed097cULL},
+                {0x0092492492492492ULL, 0x4924924924924925ULL},
+                {0x008d3dcb08d3dcb0ULL, 0x8d3dcb08d3dcb08eULL},
+                {0x0088888888888888ULL, 0x8888888888888889ULL},
+                {0x0084210842108421ULL, 0x0842108421084211ULL}
+            };
+            return uint128(table[n][0], table[n][1]);
+        }
+
+        // ln(1 + n / 256)
+        static uint128 ln256(int n) {
+            static const uint64 table[][2] = {
+                {0x0000000000000000ULL, 0x0000000000000000ULL},
+                {0x0000ff805515885eULL, 0x0250435ab4da6a5bULL},
+                {0x0001fe02a6b10678ULL, 0x8fc37690391dc282ULL},
+                {0x0002fb88ebf0214eULL, 0xdba4a25e0b0837cdULL},
+                {0x0003f815161f807cULL, 0x79f3db4e9a6f57aaULL},
+                {0x0004f3a910d1a95dULL, 0x3bcd295bf531790cULL},
+                {0x0005ee46c1f56c46ULL, 0xaa49fd531c5af007ULL},
+                {0x0006e7f009ebe465ULL, 0xfef5196dd6237986ULL},
+                {0x0007e0a6c39e0cc0ULL, 0x133e3f04f1ef229fULL},
+                {0x0008d86cc491ecbfULL, 0xe1651776453b7e82ULL},
+                {0x0009cf43dcff5eafULL, 0xd480ad90155c8a72ULL},
+                {0x000ac52dd7e4726aULL, 0x463547a963a91bb3ULL},
+                {0x000bba2c7b196e7eULL, 0x231a7950f7252c16ULL},
+                {0x000cae41876471f5ULL, 0xbeb41d00a417e330ULL},
+                {0x000da16eb88cb8dfULL, 0x61468a63ecfb66e9ULL},
+                {0x000e93b5c56d85a9ULL, 0x08f1e2992bfea38eULL}
+            };
+            return uint128(table[n][0], table[n][1]);
+        }
+
+        // 1 / (1 + n / 256), rounded up
+        static uint128 inv256(int n) {
+            static const uint64 table[][2] = {
+                {0x0100000000000000ULL, 0x0000000000000000ULL},
+                {0x00ff00ff00ff00ffULL, 0x00ff00ff00ff0100ULL},
+                {0x00fe03f80fe03f80ULL, 0xfe03f80fe03f80ffULL},
+                {0x00fd08e5500fd08eULL, 0x5500fd08e5500fd1ULL},
+                {0x00fc0fc0fc0fc0fcULL, 0x0fc0fc0fc0fc0fc1ULL},
+                {0x00fb18856506ddabULL, 0xa5c3300fb1885651ULL},
+                {0x00fa232cf252138aULL, 0xbf82ee6986d6f63bULL},
+                {0x00f92fb2211855a8ULL, 0x653b605d71e2cc6aULL},
+                {0x00f83e0f83e0f83eULL, 0x0f83e0f83e0f83e1ULL},
+                {0x00f74e3fc22c700fULL, 0x74e3fc22c700f74fULL},
+                {0x00f6603d980f6603ULL, 0xd980f6603d980f67ULL},
+                {0x00f57403d5d00f57ULL, 0x403d5d00f57403d6ULL},
+                {0x00f4898d5f85bb39ULL, 0x503d226357e16ecfULL},
+                {0x00f3a0d52cba8723ULL, 0x363ecf76f58816d8ULL},
+                {0x00f2b9d6480f2b9dULL, 0x6480f2b9d6480f2cULL},
+                {0x00f1d48bcee0d399ULL, 0xfa5504b926bb0a65ULL}
+            };
+            return uint128(table[n][0], table[n][1]);
+        }
+    };
+
+    enum {
+        fixed_frac_bits = 120
+    };
+
+    inline uint128 fixed_one() {
+        return uint128(1) << fixed_frac_bits;
+    }
+
+    inline uint128 fixed_mul(const uint128 &a, const uint128 &b) {
+        return uint256(a, b).shiftedRight(fixed_frac_bits);
+    }
+
+    /// Converts value / factor to fixed point, requires value / factor < 128
+    inline uint128 fixed_from_ratio(uint64 value, uint64 factor) {
+        uint64 rem = value % factor;
+        const uint64 intPart = value / factor;
+        const uint64 frac1 = uint128::div64(rem, 0, factor, rem);
+        const uint64 frac0 = uint128::div64(rem, 0, factor, rem);
+        return (uint128(intPart) << fixed_frac_bits) + (uint128(frac1, frac0) >> (128 - fixed_frac_bits));
+    }
+
+    template<class RoundPolicy>
+    bool pow_wide(int64 &output, bool negative, const wide_float &base, unsigned int n, uint64 factor) {
+        wide_float result = base;
+        for (int i = bit_length(n) - 2; i >= 0; --i) {
+            result = result * result;
+            if ((n >> i) & 1) {
+                result = result * base;
+            }
+            if (result.exp2 > wide_float::max_exp2) {
+                return false;
+            }
+        }
+        return round_scaled<RoundPolicy>(output, negative, result.mant, -result.exp2, factor, !result.exact);
+    }
+
+    /// Calculates output = (value / 10^prec)^n * 10^prec
+    template<class RoundPolicy>
+    bool pow_unbiased(int64 &output, int64 value, int prec, int n) {
+        const uint64 factor = static_cast<uint64>(dec_utils<RoundPolicy>::pow10(prec));
+        const unsigned int absN = (n < 0) ? static_cast<unsigned int>(-(n + 1)) + 1 : static_cast<unsigned int>(n);
+        const bool negative = (value < 0) && ((absN & 1) != 0);
+        const uint64 absValue = abs_unsigned(value);
+
+        if (absN == 0) {
+            output = static_cast<int64>(factor);
+            return true;
+        }
+
+        if (absValue == 0) {
+            output = 0;
+            return (n > 0);
+        }
+
+        // value = mant / 10^digits, without trailing zeros
+        uint64 mant = absValue;
+        int digits = prec;
+        while (digits > 0 && mant % 10 == 0) {
+            mant /= 10;
+            --digits;
+        }
+
+        const uint128 maxPayload(static_cast<uint64>(DEC_MAX_INT64));
+        const uint64 resultDigits = static_cast<uint64>(digits) * absN;
+
+        if (n > 0) {
+            if (resultDigits <= static_cast<uint64>(prec) + 1) {
+                // exact result has at most prec + 1 decimal digits, calculate it directly
+                uint128 power;
+                if (!checked_pow(power, mant, absN, maxPayload * uint128(10) + uint128(9))) {
+                    return false;
+                }
+                const int scaleDigits = prec - static_cast<int>(resultDigits);
+                if (scaleDigits < 0) {
+                    uint64 rem;
+                    const uint128 quot = power.divSmall(10, rem);
+                    return round_sticky<RoundPolicy>(output, negative, quot,
+                                                     fraction_class(uint128(rem), uint128(10)));
+                }
+                const uint128 scale = pow10_wide(scaleDigits);
+                if (power.bitLength() + scale.bitLength() > 128) {
+                    return false;
+                }
+                return round_sticky<RoundPolicy>(output, negative, power * scale, 0);
+            }
+            return pow_wide<RoundPolicy>(output, negative, wide_float::fromRatio(absValue, factor), absN, factor);
+        }
+
+        // negative exponent: result = 10^(prec + resultDigits) / mant^n
+        if (static_cast<uint64>(prec) + resultDigits <= 38) {
+            uint128 power;
+            if (checked_pow(power, mant, absN, uint128(~0ULL, ~0ULL))) {
+                uint128 quot, rem;
+                uint128::divmod(pow10_wide(prec + static_cast<int>(resultDigits)), power, quot, rem);
+                return round_sticky<RoundPolicy>(output, negative, quot, fraction_class(rem, power));
+            }
+        }
+        return pow_wide<RoundPolicy>(output, negative, wide_float::fromRatio(factor, absValue), absN, factor);
+    }
+
+    /// Returns floor(sqrt(n)) calculated with integer Newton iteration
+    inline uint128 isqrt(const uint128 &n) {
+        if (n.isZero()) {
+            return n;
+        }
+
+        // start above the root
+        uint128 root = uint128(1) << ((n.bitLength() + 1) / 2);
+        while (true) {
+            const uint128 next = (root + n / root) >> 1;
+            if (next >= root) {
+                break;
+            }
+            root = next;
+        }
+        return root;
+    }
+
+    /// Calculates output = sqrt(value / 10^prec) * 10^prec
+    template<class RoundPolicy>
+    bool sqrt_unbiased(int64 &output, int64 value, int prec) {
+        if (value < 0) {
+            return false;
+        }
+
+        const uint128 n = uint128::mul(static_cast<uint64>(value),
+                                       static_cast<uint64>(dec_utils<RoundPolicy>::pow10(prec)));
+        if (n.isZero()) {
+            output = 0;
+            return true;
+        }
+
+        const uint128 root = isqrt(n);
+
+        // root is never exactly at half: (root + 0.5)^2 = root^2 + root + 0.25
+        const uint128 rem = n - root * root;
+        const int fractionClass = rem.isZero() ? 0 : ((rem <= root) ? 1 : 3);
+        return round_sticky<RoundPolicy>(output, false, root, fractionClass);
+    }
+
+    /// Calculates output = exp(value / 10^prec) * 10^prec
+    template<class RoundPolicy>
+    bool exp_unbiased(int64 &output, int64 value, int prec) {
+        const uint64 factor = static_cast<uint64>(dec_utils<RoundPolicy>::pow10(prec));
+        // exp(x) is rational only for x = 0
+        const bool exactInput = (value == 0);
+        if (exactInput) {
+            output = static_cast<int64>(factor);
+            return true;
+        }
+
+        const uint64 absValue = abs_unsigned(value);
+        if (absValue / factor >= 100) {
+            // overflow or positive value far below the smallest representable one
+            return (value < 0) && round_sticky<RoundPolicy>(output, false, uint128(), 1);
+        }
+
+        // value = k * ln2 + r, where 0 <= r < ln2
+        const uint128 ln2 = math_constants::ln2();
+        uint128 quot, r;
+        uint128::divmod(fixed_from_ratio(absValue, factor), ln2, quot, r);
+        int k = static_cast<int>(quot.lo());
+        if (value < 0) {
+            k = -k;
+            if (!r.isZero()) {
+                --k;
+                r = ln2 - r;
+            }
+        }
+
+        // r = j / 16 + i / 256 + s, where s < 1 / 256
+        const int j = static_cast<int>((r >> (fixed_frac_bits - 4)).lo());
+        r = r - (uint128(static_cast<uint64>(j)) << (fixed_frac_bits - 4));
+        const int i = static_cast<int>((r >> (fixed_frac_bits - 8)).lo());
+        r = r - (uint128(static_cast<uint64>(i)) << (fixed_frac_bits - 8));
+
+        // exp(s) = 1 + s + s^2/2! + ...
+        uint128 sum = fixed_one();
+        uint128 term = sum;
+        for (uint64 t = 1; ; ++t) {
+            uint64 rem;
+            term = fixed_mul(term, r).divSmall(t, rem);
+            if (term.isZero()) {
+                break;
+            }
+            sum = sum + term;
+        }
+
+        const uint128 result = fixed_mul(fixed_mul(math_constants::exp16(j), math_constants::exp256(i)), sum);
+        return round_scaled<RoundPolicy>(output, false, result, fixed_frac_bits - k, factor, !exactInput);
+    }
+
+    /// Calculates output = ln(value / 10^prec) * 10^prec
+    template<class RoundPolicy>
+    bool ln_unbiased(int64 &output, int64 value, int prec) {
+        if (value <= 0) {
+            return false;
+        }
+
+        const uint64 factor = static_cast<uint64>(dec_utils<RoundPolicy>::pow10(prec));
+        // ln(x) is rational only for x = 1
+        const bool exactInput = (static_cast<uint64>(value) == factor);
+        if (exactInput) {
+            output = 0;
+            return true;
+        }
+
+        // value = 2^b * y, where 1 <= y < 2
+        const int b = bit_length(static_cast<uint64>(value)) - 1;
+        const uint128 one = fixed_one();
+        uint128 y = uint128(static_cast<uint64>(value)) << (fixed_frac_bits - b);
+
+        // y = (1 + j / 16) * (1 + i / 256) * (1 + t), where t < 1 / 256
+        const int j = static_cast<int>((y >> (fixed_frac_bits - 4)).lo()) & 15;
+        y = fixed_mul(y, math_constants::inv16(j));
+        int i = static_cast<int>(((y - one) >> (fixed_frac_bits - 8)).lo());
+        if (i > 15) {
+            i = 15;
+        }
+        y = fixed_mul(y, math_constants::inv256(i));
+        const uint128 t = y - one;
+
+        // ln(1 + t) = t - t^2/2 + t^3/3 - ...
+        uint128 pos, neg;
+        uint128 power = t;
+        for (uint64 n = 1; !power.isZero(); ++n) {
+            uint64 rem;
+            const uint128 term = power.divSmall(n, rem);
+            if (term.isZero()) {
+                break;
+            }
+            if (n & 1) {
+                pos = pos + term;
+            } else {
+                neg = neg + term;
+            }
+            power = fixed_mul(power, t);
+        }
+
+        const uint128 plus = math_constants::ln2() * uint128(static_cast<uint64>(b)) + math_constants::ln16(j) +
+                             math_constants::ln256(i) + pos - neg;
+        const uint128 minus = math_constants::ln10() * uint128(static_cast<uint64>(prec));
+        if (plus >= minus) {
+            return round_scaled<RoundPolicy>(output, false, plus - minus, fixed_frac_bits, factor, !exactInput);
+        }
+        return round_scaled<RoundPolicy>(output, true, minus - plus, fixed_frac_bits, factor, !exactInput);
+    }
+
+} // namespace details
+
+#if DEC_TYPE_LEVEL > 2
+/// Precisions of exact results of operators on decimals with different precisions:
+/// sum and difference use higher precision, product uses sum of precisions.
+template<int Prec1, int Prec2>
+struct decimal_mix {
+    enum {
+        sum_prec = (Prec1 > Prec2) ? Prec1 : Prec2,
+        product_prec = Prec1 + Prec2
+    };
 };
+#endif
 
+// default argument is already given if decimal_fwd.h was included first
+#ifdef _DECIMAL_FWD_H__
+template<int Prec, class RoundPolicy>
+#else
 template<int Prec, class RoundPolicy = def_round_policy>
+#endif
 class decimal {
 public:
     typedef dec_storage_t raw_data_t;
@@ -776,6 +2194,36 @@ public:
         fromString(value, format, *this);
     }
 
+    explicit decimal(const std::string &value, const format_spec &format) {
+        fromString(value, format, *this);
+    }
+
+    explicit decimal(const char *value) {
+        fromString(value, std::strlen(value), *this);
+    }
+
+    explicit decimal(const char *value, const basic_decimal_format &format) {
+        fromString(value, std::strlen(value), format, *this);
+    }
+
+    explicit decimal(const char *value, const format_spec &format) {
+        fromString(value, std::strlen(value), format, *this);
+    }
+
+#if DEC_USE_STRING_VIEW
+    explicit decimal(std::string_view value) {
+        fromString(value.data(), value.size(), *this);
+    }
+
+    explicit decimal(std::string_view value, const basic_decimal_format &format) {
+        fromString(value.data(), value.size(), format, *this);
+    }
+
+    explicit decimal(std::string_view value, const format_spec &format) {
+        fromString(value.data(), value.size(), format, *this);
+    }
+#endif
+
 #ifdef DEC_NO_CPP11
     ~decimal() {
     }
@@ -928,7 +2376,7 @@ template<int Prec2>
         result.m_value += rhs.getUnbiased() * DecimalFactorDiff<Prec - Prec2>::value;
         return result;
     }
-#elif DEC_TYPE_LEVEL > 1
+#elif DEC_TYPE_LEVEL == 2
     template<int Prec2>
     const decimal operator+(const decimal<Prec2, RoundPolicy> &rhs) const {
         decimal result = *this;
@@ -942,6 +2390,22 @@ template<int Prec2>
                     * DecimalFactorDiff<Prec - Prec2>::value;
         }
 
+        return result;
+    }
+#elif DEC_TYPE_LEVEL > 2
+    // exact sum in higher of both precisions, zero if it does not fit
+    template<int Prec2>
+    const decimal<decimal_mix<Prec, Prec2>::sum_prec, RoundPolicy>
+    operator+(const decimal<Prec2, RoundPolicy> &rhs) const {
+        decimal<decimal_mix<Prec, Prec2>::sum_prec, RoundPolicy> result;
+        int64 value;
+        if (!dec_utils<RoundPolicy>::scaledSum(value, m_value,
+                DecimalFactorDiff<decimal_mix<Prec, Prec2>::sum_prec - Prec>::value, rhs.getUnbiased(),
+                DecimalFactorDiff<decimal_mix<Prec, Prec2>::sum_prec - Prec2>::value)) {
+            DEC_STATS_EVENT(stats_exact_overflow);
+            value = 0;
+        }
+        result.setUnbiased(value);
         return result;
     }
 #endif
@@ -1010,7 +2474,7 @@ template<int Prec2>
         result.m_value -= rhs.getUnbiased() * DecimalFactorDiff<Prec - Prec2>::value;
         return result;
     }
-#elif DEC_TYPE_LEVEL > 1
+#elif DEC_TYPE_LEVEL == 2
     template<int Prec2>
     const decimal operator-(const decimal<Prec2, RoundPolicy> &rhs) const {
         decimal result = *this;
@@ -1024,6 +2488,22 @@ template<int Prec2>
                     * DecimalFactorDiff<Prec - Prec2>::value;
         }
 
+        return result;
+    }
+#elif DEC_TYPE_LEVEL > 2
+    // exact difference in higher of both precisions, zero if it does not fit
+    template<int Prec2>
+    const decimal<decimal_mix<Prec, Prec2>::sum_prec, RoundPolicy>
+    operator-(const decimal<Prec2, RoundPolicy> &rhs) const {
+        decimal<decimal_mix<Prec, Prec2>::sum_prec, RoundPolicy> result;
+        int64 value;
+        if (!dec_utils<RoundPolicy>::scaledSum(value, m_value,
+                DecimalFactorDiff<decimal_mix<Prec, Prec2>::sum_prec - Prec>::value, rhs.getUnbiased(),
+                -DecimalFactorDiff<decimal_mix<Prec, Prec2>::sum_prec - Prec2>::value)) {
+            DEC_STATS_EVENT(stats_exact_overflow);
+            value = 0;
+        }
+        result.setUnbiased(value);
         return result;
     }
 #endif
@@ -1084,7 +2564,7 @@ template<int Prec2>
                 rhs.getUnbiased(), DecimalFactor<Prec2>::value);
         return result;
     }
-#elif DEC_TYPE_LEVEL > 1
+#elif DEC_TYPE_LEVEL == 2
     template<int Prec2>
     const decimal operator*(const decimal<Prec2, RoundPolicy>& rhs) const {
         decimal result = *this;
@@ -1092,12 +2572,38 @@ template<int Prec2>
                 rhs.getUnbiased(), DecimalFactor<Prec2>::value);
         return result;
     }
-#endif
-
-    template <typename T>
-    decimal & operator*=(const T &rhs) {
-        *this *= static_cast<decimal>(rhs);
-        return *this;
+#elif DEC_TYPE_LEVEL > 2
+    // exact product in sum of both precisions, available when it does not exceed max_decimal_points;
+    // zero if it does not fit
+    template<int Prec2>
+    const typename ENABLE_IF<decimal_mix<Prec, Prec2>::product_prec <= max_decimal_points,
+                             decimal<decimal_mix<Prec, Prec2>::product_prec, RoundPolicy> >::type
+    operator*(const decimal<Prec2, RoundPolicy>& rhs) const {
+        decimal<decimal_mix<Prec, Prec2>::product_prec, RoundPolicy> result;
+        if (dec_utils<RoundPolicy>::isMultOverflow(m_value, rhs.getUnbiased())) {
+            DEC_STATS_EVENT(stats_exact_overflow);
+            result.setUnbiased(0);
+        } else {
+            result.setUnbiased(m_value * rhs.getUnbiased());
+        }
+        return result;
+    }
+
+    // product rounded to this precision, as on level 2
+    template<int Prec2>
+    const typename ENABLE_IF<(decimal_mix<Prec, Prec2>::product_prec > max_decimal_points), decimal>::type
+    operator*(const decimal<Prec2, RoundPolicy>& rhs) const {
+        decimal result = *this;
+        result.m_value = dec_utils<RoundPolicy>::multDiv(result.m_value,
+                rhs.getUnbiased(), DecimalFactor<Prec2>::value);
+        return result;
+    }
+#endif
+
+    template <typename T>
+    decimal & operator*=(const T &rhs) {
+        *this *= static_cast<decimal>(rhs);
+        return *this;
     }
 
     decimal & operator*=(const decimal &rhs) {
@@ -1200,16 +2706,16 @@ template<int Prec2>
         return *this;
     }
 
-    const decimal operator%(const decimal<Prec> &rhs) const {
+    const decimal operator%(const decimal &rhs) const {
         int64 resultPayload;
         resultPayload = this->m_value;
         resultPayload %= rhs.m_value;
-        decimal<Prec> result;
+        decimal result;
         result.m_value = resultPayload;
         return result;
     }
 
-    decimal & operator%=(const decimal<Prec> &rhs) {
+    decimal & operator%=(const decimal &rhs) {
         int64 resultPayload;
         resultPayload = this->m_value;
         resultPayload %= rhs.m_value;
@@ -1224,7 +2730,7 @@ template<int Prec2>
         int64 rhsInThisPrec = rhs.getUnbiased() * DecimalFactorDiff<Prec - Prec2>::value;
         int64 resultPayload = this->m_value;
         resultPayload %= rhsInThisPrec;
-        decimal<Prec> result;
+        decimal result;
         result.m_value = resultPayload;
         return result;
     }
@@ -1247,7 +2753,7 @@ template<int Prec2>
         int64 thisInRhsPrec = m_value * DecimalFactorDiff<Prec2 - Prec>::value;
         int64 resultPayload = thisInRhsPrec % rhs.getUnbiased();
         resultPayload /= DecimalFactorDiff<Prec2 - Prec>::value;
-        decimal<Prec> result;
+        decimal result;
         result.m_value = resultPayload;
         return result;
     }
@@ -1296,49 +2802,83 @@ template<int Prec2>
         m_value = value;
     }
 
-    decimal<Prec> abs() const {
+    decimal abs() const {
         if (m_value >= 0)
             return *this;
         else
-            return (decimal<Prec>(0) - *this);
+            return (decimal(0) - *this);
     }
 
-    decimal<Prec> trunc() const {
+    decimal trunc() const {
         int64 beforeValue, afterValue;
         afterValue = m_value % DecimalFactor<Prec>::value;
         beforeValue = (m_value - afterValue);
-        decimal<Prec> result;
+        decimal result;
         result.m_value = beforeValue;
         return result;
     }
 
-    decimal<Prec> floor() const {
+    decimal floor() const {
         int64 beforeValue, afterValue;
         afterValue = m_value % DecimalFactor<Prec>::value;
         beforeValue = (m_value - afterValue);
 
         if (afterValue < 0) beforeValue -= DecimalFactor<Prec>::value;
 
-        decimal<Prec> result;
+        decimal result;
         result.m_value = beforeValue;
         return result;
     }
 
-    decimal<Prec> ceil() const {
+    decimal ceil() const {
         int64 beforeValue, afterValue;
         afterValue = m_value % DecimalFactor<Prec>::value;
         beforeValue = (m_value - afterValue);
 
         if (afterValue > 0) beforeValue +=  DecimalFactor<Prec>::value;
-        decimal<Prec> result;
+        decimal result;
         result.m_value = beforeValue;
         return result;
     }
 
-    decimal<Prec> round() const {
+    decimal round() const {
         int64 resultPayload;
         RoundPolicy::div_rounded(resultPayload, this->m_value, DecimalFactor<Prec>::value);
-        decimal<Prec> result(resultPayload);
+        decimal result(resultPayload);
+        return result;
+    }
+
+    /// Returns value raised to integer power, rounded using active rounding policy.
+    /// Returns 0 on overflow or when zero is raised to negative power.
+    decimal pow(int n) const {
+        decimal result;
+        if (!details::pow_unbiased<RoundPolicy>(result.m_value, m_value, Prec, n))
+            result.m_value = 0;
+        return result;
+    }
+
+    /// Returns square root rounded using active rounding policy, 0 for negative values.
+    decimal sqrt() const {
+        decimal result;
+        if (!details::sqrt_unbiased<RoundPolicy>(result.m_value, m_value, Prec))
+            result.m_value = 0;
+        return result;
+    }
+
+    /// Returns e raised to the power of value, rounded using active rounding policy.
+    /// Returns 0 on overflow.
+    decimal exp() const {
+        decimal result;
+        if (!details::exp_unbiased<RoundPolicy>(result.m_value, m_value, Prec))
+            result.m_value = 0;
+        return result;
+    }
+
+    /// Returns natural logarithm rounded using active rounding policy, 0 for values <= 0.
+    decimal ln() const {
+        decimal result;
+        if (!details::ln_unbiased<RoundPolicy>(result.m_value, m_value, Prec))
+            result.m_value = 0;
         return result;
     }
 
@@ -1380,9 +2920,9 @@ template<int Prec2>
     /// See also @pack.
     template<int sourcePrec>
     decimal &pack_rounded(int64 beforeValue, int64 afterValue) {
-        decimal<sourcePrec> temp;
+        decimal<sourcePrec, RoundPolicy> temp;
         temp.pack(beforeValue, afterValue);
-        decimal<Prec> result(temp.getUnbiased(), temp.getPrecFactor());
+        decimal result(temp.getUnbiased(), temp.getPrecFactor());
 
         *this = result;
         return *this;
@@ -1400,22 +2940,34 @@ template<int Prec2>
         return output;
     }
 
-    void setWithExponent(int64 mantissa, int exponent) {
+    /// Sets value to mantissa * 10^exponent, rounded using RoundPolicy.
+    /// \result Returns false and sets value to 0 if result does not fit in decimal
+    bool setWithExponent(int64 mantissa, int exponent) {
 
         int exponentForPack = exponent + Prec;
 
         if (exponentForPack < 0) {
             int64 newValue;
 
-            if (!RoundPolicy::div_rounded(newValue, mantissa,
+            if (-exponentForPack > max_decimal_points ||
+                !RoundPolicy::div_rounded(newValue, mantissa,
                     dec_utils<RoundPolicy>::pow10(-exponentForPack))) {
-                newValue = 0;
+                // divisor too big or rounding near limits
+                if (!details::div_pow10_rounded<RoundPolicy>(newValue, mantissa, -exponentForPack)) {
+                    m_value = 0;
+                    return false;
+                }
             }
 
             m_value = newValue;
+        } else if (mantissa != 0 && (exponentForPack > max_decimal_points ||
+                   dec_utils<RoundPolicy>::isMultOverflow(mantissa, dec_utils<RoundPolicy>::pow10(exponentForPack)))) {
+            m_value = 0;
+            return false;
         } else {
             m_value = mantissa * dec_utils<RoundPolicy>::pow10(exponentForPack);
         }
+        return true;
     }
 
     void getWithExponent(int64 &mantissa, int &exponent) const {
@@ -1570,6 +3122,21 @@ decimal<Prec> decimal_cast(const char (&arg)[N]) {
     return result;
 }
 
+template<int Prec>
+decimal<Prec> decimal_cast(const char *arg, std::size_t size) {
+    decimal<Prec> result;
+    fromString(arg, size, result);
+    return result;
+}
+
+#if DEC_USE_STRING_VIEW
+template<int Prec>
+decimal<Prec> decimal_cast(std::string_view arg) {
+    decimal<Prec> result(arg);
+    return result;
+}
+#endif
+
 // with rounding policy
 template<int Prec, typename RoundPolicy>
 decimal<Prec, RoundPolicy> decimal_cast(uint arg) {
@@ -1607,6 +3174,141 @@ decimal<Prec, RoundPolicy> decimal_cast(const char (&arg)[N]) {
     return result;
 }
 
+template<int Prec, typename RoundPolicy>
+decimal<Prec, RoundPolicy> decimal_cast(const char *arg, std::size_t size) {
+    decimal<Prec, RoundPolicy> result;
+    fromString(arg, size, result);
+    return result;
+}
+
+#if DEC_USE_STRING_VIEW
+template<int Prec, typename RoundPolicy>
+decimal<Prec, RoundPolicy> decimal_cast(std::string_view arg) {
+    decimal<Prec, RoundPolicy> result(arg);
+    return result;
+}
+#endif
+
+// Operations with rounding policy selected at runtime.
+// Example of use:
+//   dec::runtime_round_policy policy;
+//   dec::parse_round_policy(config.rounding, policy);
+//   c = dec::multiply(a, b, policy);
+//   d = dec::decimal_cast<2>(c, policy);
+template<int Prec, int Prec2, class RoundPolicy>
+decimal<Prec, RoundPolicy> decimal_cast(const decimal<Prec2, RoundPolicy> &arg, runtime_round_policy policy) {
+    decimal<Prec, RoundPolicy> result;
+    result.setUnbiased(multDiv(arg.getUnbiased(), DecimalFactor<Prec>::value,
+            DecimalFactor<Prec2>::value, policy));
+    return result;
+}
+
+/// Returns lhs * rhs with precision of lhs
+template<int Prec, int Prec2, class RoundPolicy>
+decimal<Prec, RoundPolicy> multiply(const decimal<Prec, RoundPolicy> &lhs, const decimal<Prec2, RoundPolicy> &rhs,
+                                    runtime_round_policy policy) {
+    decimal<Prec, RoundPolicy> result;
+    result.setUnbiased(multDiv(lhs.getUnbiased(), rhs.getUnbiased(), DecimalFactor<Prec2>::value, policy));
+    return result;
+}
+
+/// Returns lhs / rhs with precision of lhs
+template<int Prec, int Prec2, class RoundPolicy>
+decimal<Prec, RoundPolicy> divide(const decimal<Prec, RoundPolicy> &lhs, const decimal<Prec2, RoundPolicy> &rhs,
+                                  runtime_round_policy policy) {
+    decimal<Prec, RoundPolicy> result;
+    result.setUnbiased(multDiv(lhs.getUnbiased(), DecimalFactor<Prec2>::value, rhs.getUnbiased(), policy));
+    return result;
+}
+
+    /// Plain value format: trivially copyable, without virtual functions and allocation,
+    /// so it can be a compile-time constant or template argument:
+    ///   DEC_CONSTEXPR dec::format_spec german = {',', '.', true, {3}};
+    /// Parsing and formatting functions take it directly, basic_decimal_format
+    /// is converted to it once per call.
+    struct format_spec {
+        enum { max_grouping = 8 };
+
+        char decimal_point;
+        char thousands_sep;
+        bool thousands_grouping;
+        /// Group sizes as in std::numpunct::grouping(), zero-terminated if shorter than max_grouping
+        char grouping[max_grouping];
+    };
+
+    /// Returns format_spec, grouping longer than format_spec::max_grouping is truncated
+    inline format_spec make_format_spec(char decimal_point, char thousands_sep, bool thousands_grouping,
+                                        const std::string &grouping) {
+        format_spec result = {decimal_point, thousands_sep, thousands_grouping, {0}};
+        const std::size_t size = (grouping.size() < static_cast<std::size_t>(format_spec::max_grouping))
+                                 ? grouping.size() : static_cast<std::size_t>(format_spec::max_grouping);
+        std::memcpy(result.grouping, grouping.data(), size);
+        return result;
+    }
+
+    /// '.' as decimal point and no grouping, as basic_decimal_format
+    inline format_spec make_format_spec() {
+        const format_spec result = {'.', ',', false, {0}};
+        return result;
+    }
+
+    /// See decimal_format(char)
+    inline format_spec make_format_spec(char decimal_point) {
+        const format_spec result = {decimal_point, ',', false, {0}};
+        return result;
+    }
+
+    /// See decimal_format(char, char), groups of 3 digits if thousands_sep is not '\0'
+    inline format_spec make_format_spec(char decimal_point, char thousands_sep) {
+        const format_spec result = {decimal_point, thousands_sep, thousands_sep != '\0',
+                                    {static_cast<char>(thousands_sep != '\0' ? 3 : 0)}};
+        return result;
+    }
+
+    /// See decimal_format(char, char, bool)
+    inline format_spec make_format_spec(char decimal_point, char thousands_sep, bool thousands_grouping) {
+        const format_spec result = {decimal_point, thousands_sep, thousands_grouping,
+                                    {static_cast<char>(thousands_grouping ? 3 : 0)}};
+        return result;
+    }
+
+    /// Returns grouping of spec as std::string, see std::numpunct::grouping()
+    inline std::string grouping_string(const format_spec &spec) {
+        std::size_t size = 0;
+        while (size < static_cast<std::size_t>(format_spec::max_grouping) && spec.grouping[size] != '\0') {
+            ++size;
+        }
+        return std::string(spec.grouping, size);
+    }
+
+    /// Unicode code point
+    typedef unsigned long code_point;
+
+    /// Format with separators given as Unicode code points, e.g. U+202F (narrow no-break space)
+    /// or U+066B (Arabic decimal separator), for text in UTF-8, UTF-16 or UTF-32:
+    ///   DEC_CONSTEXPR dec::unicode_format_spec french = {',', 0x202F, true, {3}};
+    struct unicode_format_spec {
+        code_point decimal_point;
+        code_point thousands_sep;
+        bool thousands_grouping;
+        /// Group sizes as in format_spec
+        char grouping[format_spec::max_grouping];
+    };
+
+    /// Returns unicode_format_spec with the same separators as format, chars are treated as Latin-1
+    inline unicode_format_spec make_unicode_format_spec(const format_spec &format) {
+        unicode_format_spec result = {static_cast<unsigned char>(format.decimal_point),
+                                      static_cast<unsigned char>(format.thousands_sep),
+                                      format.thousands_grouping, {0}};
+        std::memcpy(result.grouping, format.grouping, sizeof(result.grouping));
+        return result;
+    }
+
+    /// '.' as decimal point and no grouping
+    inline unicode_format_spec make_unicode_format_spec() {
+        return make_unicode_format_spec(make_format_spec());
+    }
+
     // value format with constant default values
     class basic_decimal_format {
     public:
@@ -1627,105 +3329,440 @@ decimal<Prec, RoundPolicy> decimal_cast(const char (&arg)[N]) {
         virtual std::string grouping() const {
             return "";
         }
+
+        /// Separator outside of ASCII or 0 if decimal_point() is used
+        virtual code_point decimal_point_code() const {
+            return 0;
+        }
+
+        /// Separator outside of ASCII or 0 if thousands_sep() is used
+        virtual code_point thousands_sep_code() const {
+            return 0;
+        }
+
+        /// Returns format as format_spec, used by parsing and formatting functions
+        format_spec spec() const {
+            return make_format_spec(decimal_point(), thousands_sep(), thousands_grouping(), grouping());
+        }
+
+        /// Returns format with separators as code points
+        unicode_format_spec unicode_spec() const {
+            unicode_format_spec result = make_unicode_format_spec(spec());
+            if (decimal_point_code() != 0) {
+                result.decimal_point = decimal_point_code();
+            }
+            if (thousands_sep_code() != 0) {
+                result.thousands_sep = thousands_sep_code();
+            }
+            return result;
+        }
+
+        /// Returns true if separators can not be written as single chars, then
+        /// std::string is written and read as UTF-8
+        bool has_unicode_separators() const {
+            return decimal_point_code() != 0 || thousands_sep_code() != 0;
+        }
     };
 
     // value format with full specification stored in fields
     class decimal_format: public basic_decimal_format {
     public:
 
-        decimal_format(char decimal_point) :
-          m_decimal_point(decimal_point),
-          m_thousands_sep(','),
-          m_thousands_grouping(false),
-          m_grouping("") {
+        decimal_format(char decimal_point) : m_spec(make_format_spec(decimal_point)),
+                                             m_decimal_point_code(0), m_thousands_sep_code(0) {
         }
 
-        decimal_format(char decimal_point, char thousands_sep) : m_decimal_point(decimal_point),
-                                                                       m_thousands_sep(thousands_sep),
-                                                                       m_thousands_grouping(thousands_sep != '\0'),
-                                                                       m_grouping(thousands_sep != '\0' ? "\03" : "") {
-
+        decimal_format(char decimal_point, char thousands_sep) :
+                m_spec(make_format_spec(decimal_point, thousands_sep)),
+                m_decimal_point_code(0), m_thousands_sep_code(0) {
         }
 
-        decimal_format(char decimal_point, char thousands_sep, bool thousands_grouping) : m_decimal_point(decimal_point),
-                                                                                                m_thousands_sep(thousands_sep),
-                                                                                                m_thousands_grouping(thousands_grouping),
-                                                                                                m_grouping(thousands_grouping ? "\03" : "") {
-
+        decimal_format(char decimal_point, char thousands_sep, bool thousands_grouping) :
+                m_spec(make_format_spec(decimal_point, thousands_sep, thousands_grouping)),
+                m_decimal_point_code(0), m_thousands_sep_code(0) {
         }
 
         decimal_format(char decimal_point, char thousands_sep, bool thousands_grouping, const std::string &grouping) :
-                m_decimal_point(decimal_point),
-                m_thousands_sep(thousands_sep),
-                m_thousands_grouping(thousands_grouping),
-                m_grouping(grouping) {
-
+                m_spec(make_format_spec(decimal_point, thousands_sep, thousands_grouping, grouping)),
+                m_decimal_point_code(0), m_thousands_sep_code(0) {
         }
 
-        decimal_format(const decimal_format &source): m_decimal_point(source.m_decimal_point),
-                                                                  m_thousands_sep(source.m_thousands_sep),
-                                                                  m_thousands_grouping(source.m_thousands_grouping),
-                                                                  m_grouping(source.m_grouping) {
-
+        explicit decimal_format(const format_spec &spec) : m_spec(spec),
+                                                           m_decimal_point_code(0), m_thousands_sep_code(0) {
         }
 
-        decimal_format & operator=(const decimal_format &rhs) {
-            if (&rhs != this) {
-                m_decimal_point = rhs.m_decimal_point;
-                m_thousands_sep = rhs.m_thousands_sep;
-                m_thousands_grouping = rhs.m_thousands_grouping;
-                m_grouping = rhs.grouping();
-            }
-            return *this;
+        /// Format with separators outside of ASCII (used by toString() and fromString()
+        /// as UTF-8). Functions using single chars see '.' and ' ' instead of them.
+        explicit decimal_format(const unicode_format_spec &spec) :
+                m_spec(make_format_spec(spec.decimal_point < 0x80 ? static_cast<char>(spec.decimal_point) : '.',
+                                        spec.thousands_sep < 0x80 ? static_cast<char>(spec.thousands_sep) : ' ',
+                                        spec.thousands_grouping)),
+                m_decimal_point_code(spec.decimal_point < 0x80 ? 0 : spec.decimal_point),
+                m_thousands_sep_code(spec.thousands_sep < 0x80 ? 0 : spec.thousands_sep) {
+            std::memcpy(m_spec.grouping, spec.grouping, sizeof(m_spec.grouping));
         }
 
         char decimal_point() const DEC_OVERRIDE {
-            return m_decimal_point;
+            return m_spec.decimal_point;
         }
 
         char thousands_sep() const DEC_OVERRIDE {
-            return m_thousands_sep;
+            return m_spec.thousands_sep;
         }
 
         bool thousands_grouping() const DEC_OVERRIDE {
-            return m_thousands_grouping;
+            return m_spec.thousands_grouping;
         }
 
         std::string grouping() const DEC_OVERRIDE {
-            return m_grouping;
+            return grouping_string(m_spec);
+        }
+
+        code_point decimal_point_code() const DEC_OVERRIDE {
+            return m_decimal_point_code;
+        }
+
+        code_point thousands_sep_code() const DEC_OVERRIDE {
+            return m_thousands_sep_code;
+        }
+
+        /// Returns stored format, without calls of virtual functions
+        const format_spec &spec() const {
+            return m_spec;
         }
 
     private:
-        char m_decimal_point;
-        char m_thousands_sep;
-        bool m_thousands_grouping;
-        std::string m_grouping;
+        format_spec m_spec;
+        code_point m_decimal_point_code;
+        code_point m_thousands_sep_code;
     };
 
     class decimal_format_punct : public std::numpunct<char>
     {
     public:
-        decimal_format_punct(const basic_decimal_format &format): m_format(format) {}
+        decimal_format_punct(const format_spec &format): m_format(format) {}
+        decimal_format_punct(const basic_decimal_format &format): m_format(format.spec()) {}
 
     protected:
-        virtual char do_thousands_sep() const { return m_format.thousands_sep(); }
-        virtual std::string do_grouping() const { return m_format.grouping(); }
-        const basic_decimal_format &m_format;
+        virtual char do_thousands_sep() const { return m_format.thousands_sep; }
+        virtual std::string do_grouping() const { return grouping_string(m_format); }
+        const format_spec m_format;
     };
 
+    /// Returns format given by numpunct facet of locale (as used by stream operators)
+    inline format_spec format_spec_from_locale(const std::locale &locale) {
+        using namespace std;
+        if (!has_facet<numpunct<char> >(locale)) {
+            return make_format_spec();
+        }
+        const numpunct<char> &facet = use_facet<numpunct<char> >(locale);
+        const string grouping_spec = facet.grouping();
+        return make_format_spec(facet.decimal_point(), facet.thousands_sep(), !grouping_spec.empty(),
+                                grouping_spec);
+    }
+
+    template<typename StreamType>
+    format_spec format_spec_from_stream(StreamType &stream) {
+        return format_spec_from_locale(stream.getloc());
+    }
+
     template<typename StreamType>
     decimal_format format_from_stream(StreamType &stream) {
-        using namespace std;
-        const numpunct<char> *facet =
-                has_facet<numpunct<char> >(stream.getloc()) ?
-                &use_facet<numpunct<char> >(stream.getloc()) : NULL;
-        const char dec_point = (facet != NULL) ? facet->decimal_point() : '.';
-        const bool thousands_grouping =
-                (facet != NULL) ? (!facet->grouping().empty()) : false;
-        const char thousands_sep = (facet != NULL) ? facet->thousands_sep() : ',';
-        string grouping_spec =
-                (facet != NULL) ? (facet->grouping()) : string("");
-        return decimal_format(dec_point, thousands_sep, thousands_grouping, grouping_spec);
+        return decimal_format(format_spec_from_stream(stream));
+    }
+
+    namespace details {
+
+        /// Returns table of two-digit strings "00" to "99"
+        inline const char *digit_pairs() {
+            static const char table[] =
+                    "00010203040506070809"
+                    "10111213141516171819"
+                    "20212223242526272829"
+                    "30313233343536373839"
+                    "40414243444546474849"
+                    "50515253545556575859"
+                    "60616263646566676869"
+                    "70717273747576777879"
+                    "80818283848586878889"
+                    "90919293949596979899";
+            return table;
+        }
+
+        /// Writes decimal digits of value backwards (ending at end), at least minDigits digits.
+        /// \result Returns pointer to the first written char
+        inline char *write_digits_backward(char *end, uint64 value, int minDigits) {
+            const char *pairs = digit_pairs();
+            char *pos = end;
+            while (value >= 100) {
+                const unsigned int idx = static_cast<unsigned int>(value % 100) * 2;
+                value /= 100;
+                *--pos = pairs[idx + 1];
+                *--pos = pairs[idx];
+            }
+            if (value >= 10) {
+                const unsigned int idx = static_cast<unsigned int>(value) * 2;
+                *--pos = pairs[idx + 1];
+                *--pos = pairs[idx];
+            } else {
+                *--pos = static_cast<char>('0' + value);
+            }
+            while (end - pos < minDigits) {
+                *--pos = '0';
+            }
+            return pos;
+        }
+
+    } // namespace details
+
+    /// Formatter with separators resolved once, for repeated output of decimals.
+    /// Does not allocate memory and does not change locale of streams.
+    /// Output is the same as from toString() / toStream() with the same format.
+    ///
+    /// Sample usage:
+    ///   const dec::decimal_formatter formatter(dec::decimal_format(',', '.'));
+    ///   char buffer[dec::decimal_formatter::max_chars];
+    ///   *formatter.format(value, buffer) = '\0';
+    ///   std::cout << formatter(value);
+    class decimal_formatter {
+    public:
+        /// Max number of chars written by format()
+        enum { max_chars = 64 };
+
+        /// Creates formatter with '.' as decimal point and without grouping
+        decimal_formatter() : m_decimal_point('.'), m_thousands_sep(','), m_separator_mask(0) {
+        }
+
+        explicit decimal_formatter(const format_spec &format) :
+                m_decimal_point(format.decimal_point), m_thousands_sep(format.thousands_sep),
+                m_separator_mask(separator_mask(format.grouping, format_spec::max_grouping)) {
+        }
+
+        explicit decimal_formatter(const basic_decimal_format &format) :
+                m_decimal_point('.'), m_thousands_sep(','), m_separator_mask(0) {
+            *this = decimal_formatter(format.spec());
+        }
+
+        /// Creates formatter using numpunct facet of locale (as used by operator<<)
+        explicit decimal_formatter(const std::locale &locale) :
+                m_decimal_point('.'), m_thousands_sep(','), m_separator_mask(0) {
+            if (std::has_facet<std::numpunct<char> >(locale)) {
+                const std::numpunct<char> &facet = std::use_facet<std::numpunct<char> >(locale);
+                m_decimal_point = facet.decimal_point();
+                m_thousands_sep = facet.thousands_sep();
+                const std::string grouping = facet.grouping();
+                m_separator_mask = separator_mask(grouping.data(), grouping.size());
+            }
+        }
+
+        char decimal_point() const {
+            return m_decimal_point;
+        }
+
+        char thousands_sep() const {
+            return m_thousands_sep;
+        }
+
+        bool thousands_grouping() const {
+            return m_separator_mask != 0;
+        }
+
+        /// Writes value to buffer of at least max_chars size, without terminating zero.
+        /// \result Returns pointer past the last written char
+        template<int Prec, class RoundPolicy>
+        char *format(const decimal<Prec, RoundPolicy> &value, char *buffer) const {
+            const int64 unbiased = value.getUnbiased();
+            const bool negative = unbiased < 0;
+            // works also for DEC_MIN_INT64
+            const details::uint64 absValue =
+                    negative ? (0 - static_cast<details::uint64>(unbiased)) : static_cast<details::uint64>(unbiased);
+            const details::uint64 factor = static_cast<details::uint64>(DecimalFactor<Prec>::value);
+            return format_unpacked(negative, absValue / factor, absValue % factor, Prec, buffer);
+        }
+
+        /// Writes value given as absolute parts before and after decimal point
+        /// (after < 10^precision, precision <= max_decimal_points), see format().
+        char *format_unpacked(bool negative, details::uint64 before, details::uint64 after, int precision,
+                              char *buffer) const {
+            char temp[max_chars];
+            char *end = temp + max_chars;
+            char *pos = end;
+
+            if (precision > 0) {
+                pos = details::write_digits_backward(pos, after, precision);
+                *--pos = m_decimal_point;
+            }
+
+            if (m_separator_mask == 0) {
+                pos = details::write_digits_backward(pos, before, 1);
+            } else {
+                int count = 0;
+                do {
+                    if ((m_separator_mask >> count) & 1) {
+                        *--pos = m_thousands_sep;
+                    }
+                    *--pos = static_cast<char>('0' + before % 10);
+                    before /= 10;
+                    ++count;
+                } while (before != 0);
+            }
+
+            if (negative) {
+                *--pos = '-';
+            }
+
+            const std::size_t length = static_cast<std::size_t>(end - pos);
+            std::memcpy(buffer, pos, length);
+            return buffer + length;
+        }
+
+        /// Writes value in scientific notation (e.g. "-1.25e-3", "6e5"), see decimal::getWithExponent().
+        /// Buffer must have at least max_chars size, terminating zero is not written.
+        /// \result Returns pointer past the last written char
+        template<int Prec, class RoundPolicy>
+        char *format_exponent(const decimal<Prec, RoundPolicy> &value, char *buffer) const {
+            return format_exponent_unbiased(value.getUnbiased(), Prec, buffer);
+        }
+
+        /// Version of format_exponent() for unbiased value with given precision
+        char *format_exponent_unbiased(int64 unbiased, int precision, char *buffer) const {
+            int exponent = -precision;
+            if (unbiased == 0) {
+                exponent = 0;
+            }
+            while (unbiased != 0 && unbiased % 10 == 0) {
+                unbiased /= 10;
+                ++exponent;
+            }
+
+            char digits[24];
+            char *digitsEnd = digits + sizeof(digits);
+            const char *first = details::write_digits_backward(digitsEnd, details::abs_unsigned(unbiased), 1);
+            const int count = static_cast<int>(digitsEnd - first);
+
+            char *pos = buffer;
+            if (unbiased < 0) {
+                *pos++ = '-';
+            }
+            *pos++ = *first;
+            if (count > 1) {
+                *pos++ = m_decimal_point;
+                std::memcpy(pos, first + 1, static_cast<std::size_t>(count - 1));
+                pos += count - 1;
+            }
+
+            // one digit before decimal point
+            exponent += count - 1;
+            *pos++ = 'e';
+            if (exponent < 0) {
+                *pos++ = '-';
+                exponent = -exponent;
+            }
+            char *expEnd = digits + sizeof(digits);
+            const char *expFirst = details::write_digits_backward(expEnd, static_cast<details::uint64>(exponent), 1);
+            std::memcpy(pos, expFirst, static_cast<std::size_t>(expEnd - expFirst));
+            return pos + (expEnd - expFirst);
+        }
+
+        /// Appends value to output, without allocation if output has enough capacity reserved.
+        template<int Prec, class RoundPolicy>
+        std::string &append(const decimal<Prec, RoundPolicy> &value, std::string &output) const {
+            char buffer[max_chars];
+            output.append(buffer, format(value, buffer));
+            return output;
+        }
+
+        template<int Prec, class RoundPolicy>
+        std::string toString(const decimal<Prec, RoundPolicy> &value) const {
+            std::string result;
+            append(value, result);
+            return result;
+        }
+
+        /// Value bound to formatter, for use with operator<<
+        template<int Prec, class RoundPolicy>
+        class formatted {
+        public:
+            formatted(const decimal_formatter &formatter, const decimal<Prec, RoundPolicy> &value) :
+                    m_formatter(formatter), m_value(value) {
+            }
+
+            template<class traits>
+            void write(std::basic_ostream<char, traits> &output) const {
+                char buffer[max_chars];
+                const std::streamsize length = m_formatter.format(m_value, buffer) - buffer;
+                const std::streamsize padding = output.width() > length ? output.width() - length : 0;
+                const bool left = (output.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+                if (!left) {
+                    write_fill(output, padding);
+                }
+                output.write(buffer, length);
+                if (left) {
+                    write_fill(output, padding);
+                }
+                output.width(0);
+            }
+
+        private:
+            template<class traits>
+            static void write_fill(std::basic_ostream<char, traits> &output, std::streamsize count) {
+                const char fill = output.fill();
+                for (std::streamsize i = 0; i < count; ++i) {
+                    output.put(fill);
+                }
+            }
+
+            const decimal_formatter &m_formatter;
+            const decimal<Prec, RoundPolicy> &m_value;
+        };
+
+        /// Returns object which writes value to stream using this formatter:
+        ///   std::cout << formatter(value);
+        /// Stream width and fill are respected, stream locale is not used.
+        template<int Prec, class RoundPolicy>
+        formatted<Prec, RoundPolicy> operator()(const decimal<Prec, RoundPolicy> &value) const {
+            return formatted<Prec, RoundPolicy>(*this, value);
+        }
+
+    private:
+        // bit n is set when separator goes after n-th digit counting from decimal point,
+        // see std::numpunct::grouping
+        // grouping ends at length or at zero char
+        static unsigned long separator_mask(const char *grouping, std::size_t length) {
+            unsigned long result = 0;
+            int position = 0;
+            std::size_t i = 0;
+            while (i < length) {
+                const char size = grouping[i];
+                if (size <= 0 || size == CHAR_MAX) {
+                    break;
+                }
+                position += size;
+                if (position > max_decimal_points) {
+                    break;
+                }
+                result |= 1UL << position;
+                if (i + 1 < length && grouping[i + 1] != '\0') {
+                    ++i;
+                }
+            }
+            return result;
+        }
+
+        char m_decimal_point;
+        char m_thousands_sep;
+        unsigned long m_separator_mask;
+    };
+
+    /// Max number of chars written by toString() to buffer of Unicode text
+    enum { max_unicode_units = 4 * decimal_formatter::max_chars };
+
+    template<class traits, int Prec, class RoundPolicy>
+    std::basic_ostream<char, traits> &
+    operator<<(std::basic_ostream<char, traits> &os,
+            const decimal_formatter::formatted<Prec, RoundPolicy> &value) {
+        value.write(os);
+        return os;
     }
 
     /// Exports decimal to stream
@@ -1734,72 +3771,331 @@ decimal<Prec, RoundPolicy> decimal_cast(const char (&arg)[N]) {
     /// '.' is locale-dependent decimal point character
     /// bbbb is stream of digits before decimal point
     /// aaaa is stream of digits after decimal point
+    /// Value is written at once with stream width and fill, locale of stream is not changed.
+    template<class decimal_type, typename StreamType>
+    void toStream(const decimal_type &arg, const format_spec &format, StreamType &output) {
+        const decimal_formatter formatter(format);
+        formatter(arg).write(output);
+    }
+
     template<class decimal_type, typename StreamType>
     void toStream(const decimal_type &arg, const basic_decimal_format &format, StreamType &output, bool formatFromStream = false) {
-        using namespace std;
+        format_spec spec = format.spec();
+        if (formatFromStream && !(spec.thousands_grouping && format.change_thousands_if_needed())) {
+            // grouping of stream locale is kept
+            const format_spec streamSpec = format_spec_from_stream(output);
+            spec.thousands_sep = streamSpec.thousands_sep;
+            spec.thousands_grouping = streamSpec.thousands_grouping;
+            std::memcpy(spec.grouping, streamSpec.grouping, sizeof(spec.grouping));
+        }
+        toStream(arg, spec, output);
+    }
 
-        int64 before, after;
-        int sign;
+    template<class decimal_type, typename StreamType>
+    void toStream(const decimal_type &arg, StreamType &output) {
+        toStream(arg, format_spec_from_stream(output), output);
+    }
 
-        arg.unpack(before, after);
-        sign = 1;
+namespace details {
 
-        if (before < 0) {
-            sign = -1;
-            before = -before;
+    /// Reads chars from memory buffer, with the subset of input stream interface
+    /// used by parse_unpacked() and fromStream().
+    class buffer_reader {
+    public:
+        buffer_reader(const char *begin, const char *end) : m_pos(begin), m_end(end), m_good(true) {
         }
 
-        if (after < 0) {
-            sign = -1;
-            after = -after;
+        /// Returns next char or -1 (EOF) at the end of buffer, like std::istream::get()
+        int get() {
+            if (m_pos == m_end) {
+                m_good = false;
+                return -1;
+            }
+            return static_cast<unsigned char>(*m_pos++);
         }
 
-        if (sign < 0) {
-            output << "-";
+        /// Returns next char without extracting it, -1 at the end of buffer
+        int peek() const {
+            return (m_pos == m_end) ? -1 : static_cast<unsigned char>(*m_pos);
         }
 
-        std::locale oldloc = output.getloc();
-        if (!formatFromStream || (format.thousands_grouping() && format.change_thousands_if_needed())) {
-            output.imbue( std::locale( std::locale::classic(), new decimal_format_punct(format) ) );
-            output << before;
-            output.imbue(oldloc);
-        } else {
-            output << before;
+        /// Puts back the last char returned by get()
+        void unget() {
+            --m_pos;
         }
 
-        if (arg.getDecimalPoints() > 0) {
-            output.imbue(std::locale::classic());
-            output << format.decimal_point();
-            output << setw(arg.getDecimalPoints()) << setfill('0') << right
-                   << after;
-            output.imbue(oldloc);
+        operator bool() const {
+            return m_good;
         }
-    }
 
-    template<class decimal_type, typename StreamType>
-    void toStream(const decimal_type &arg, StreamType &output) {
-        toStream(arg, format_from_stream(output), output, true);
-    }
+        /// Returns global locale, used by default by string streams
+        std::locale getloc() const {
+            return std::locale();
+        }
 
-namespace details {
+    private:
+        const char *m_pos;
+        const char *m_end;
+        bool m_good;
+    };
 
-    /// Extract values from stream ready to be packed to decimal
-    template<typename StreamType>
-    bool parse_unpacked(StreamType &input, const basic_decimal_format &format, int &sign, int64 &before, int64 &after,
-                        int &decimalDigits) {
+    // Unicode text is converted to chars of ascii_spec(): separators become '.'
+    // and ',', other ASCII chars are kept and the rest is rejected by parser.
+    // Code units are UTF-8 for 1-byte, UTF-16 for 2-byte and UTF-32 for 4-byte chars.
 
-        const char dec_point = format.decimal_point();
-        const bool thousands_grouping = format.thousands_grouping();
-        const char thousands_sep = format.thousands_sep();
+    // returned for invalid sequences, above the last code point
+    enum { invalid_code_point = 0x110000 };
+
+    inline format_spec ascii_spec(const unicode_format_spec &format) {
+        format_spec result = {'.', ',', format.thousands_grouping, {0}};
+        std::memcpy(result.grouping, format.grouping, sizeof(result.grouping));
+        return result;
+    }
+
+    inline char ascii_char(code_point value, const unicode_format_spec &format) {
+        if (value == format.decimal_point) {
+            return '.';
+        }
+        if (format.thousands_grouping && value == format.thousands_sep) {
+            return ',';
+        }
+        return (value < 0x80 && value != '.' && value != ',') ? static_cast<char>(value) : '\x01';
+    }
+
+    template<typename CharT>
+    code_point code_unit_value(CharT unit) {
+        const code_point mask = (sizeof(CharT) >= 4) ? 0xFFFFFFFFUL : ((sizeof(CharT) == 2) ? 0xFFFFUL : 0xFFUL);
+        return static_cast<code_point>(unit) & mask;
+    }
+
+    template<typename CharT>
+    CharT *encode_code_point(code_point value, CharT *out) {
+        if (sizeof(CharT) == 1) {
+            if (value < 0x80) {
+                *out++ = static_cast<CharT>(value);
+            } else if (value < 0x800) {
+                *out++ = static_cast<CharT>(0xC0 | (value >> 6));
+                *out++ = static_cast<CharT>(0x80 | (value & 0x3F));
+            } else if (value < 0x10000) {
+                *out++ = static_cast<CharT>(0xE0 | (value >> 12));
+                *out++ = static_cast<CharT>(0x80 | ((value >> 6) & 0x3F));
+                *out++ = static_cast<CharT>(0x80 | (value & 0x3F));
+            } else {
+                *out++ = static_cast<CharT>(0xF0 | (value >> 18));
+                *out++ = static_cast<CharT>(0x80 | ((value >> 12) & 0x3F));
+                *out++ = static_cast<CharT>(0x80 | ((value >> 6) & 0x3F));
+                *out++ = static_cast<CharT>(0x80 | (value & 0x3F));
+            }
+        } else if (sizeof(CharT) == 2 && value >= 0x10000) {
+            *out++ = static_cast<CharT>(0xD800 + ((value - 0x10000) >> 10));
+            *out++ = static_cast<CharT>(0xDC00 + ((value - 0x10000) & 0x3FF));
+        } else {
+            *out++ = static_cast<CharT>(value);
+        }
+        return out;
+    }
+
+    /// Reads one code point, invalid sequences return invalid_code_point and skip one unit
+    template<typename CharT>
+    code_point decode_code_point(const CharT *&pos, const CharT *end) {
+        const code_point lead = code_unit_value(*pos++);
+        if (sizeof(CharT) == 1 && lead >= 0x80) {
+            const int length = (lead >= 0xF0) ? 4 : ((lead >= 0xE0) ? 3 : ((lead >= 0xC2) ? 2 : 0));
+            if (length == 0 || lead > 0xF4 || end - pos < length - 1) {
+                return invalid_code_point;
+            }
+            code_point result = lead & (0x3F >> (length - 1));
+            for (int i = 1; i < length; ++i) {
+                const code_point next = code_unit_value(pos[i - 1]);
+                if ((next & 0xC0) != 0x80) {
+                    return invalid_code_point;
+                }
+                result = (result << 6) | (next & 0x3F);
+            }
+            static const code_point minimum[5] = {0, 0, 0x80, 0x800, 0x10000};
+            if (result < minimum[length] || result > 0x10FFFF || (result >= 0xD800 && result < 0xE000)) {
+                return invalid_code_point;
+            }
+            pos += length - 1;
+            return result;
+        }
+        if (sizeof(CharT) == 2 && lead >= 0xD800 && lead < 0xE000) {
+            if (lead >= 0xDC00 || pos == end || code_unit_value(*pos) < 0xDC00 || code_unit_value(*pos) >= 0xE000) {
+                return invalid_code_point;
+            }
+            return 0x10000 + ((lead - 0xD800) << 10) + (code_unit_value(*pos++) - 0xDC00);
+        }
+        return lead;
+    }
+
+    /// Replaces '.' and ',' of text written with ascii_spec() by separators of format
+    template<typename CharT>
+    CharT *encode_ascii(const char *begin, const char *end, const unicode_format_spec &format, CharT *out) {
+        for (; begin != end; ++begin) {
+            if (*begin == '.') {
+                out = encode_code_point(format.decimal_point, out);
+            } else if (*begin == ',') {
+                out = encode_code_point(format.thousands_sep, out);
+            } else {
+                *out++ = static_cast<CharT>(*begin);
+            }
+        }
+        return out;
+    }
+
+    /// Input for parse_unpacked() from stream of any char type, without locale conversions
+    template<typename StreamType>
+    class unicode_stream_reader {
+    public:
+        typedef typename StreamType::traits_type traits_type;
+
+        unicode_stream_reader(StreamType &input, const unicode_format_spec &format) :
+                m_input(input), m_format(format) {
+        }
+
+        int get() {
+            return convert(m_input.get());
+        }
+
+        int peek() {
+            return convert(m_input.peek());
+        }
+
+        void unget() {
+            m_input.unget();
+        }
+
+        operator bool() const {
+            return !m_input.fail();
+        }
+
+    private:
+        int convert(typename traits_type::int_type unit) const {
+            if (traits_type::eq_int_type(unit, traits_type::eof())) {
+                return -1;
+            }
+            return static_cast<unsigned char>(ascii_char(code_unit_value(traits_type::to_char_type(unit)), m_format));
+        }
+
+        StreamType &m_input;
+        const unicode_format_spec &m_format;
+    };
+
+    /// Input for parse_unpacked() from Unicode text, see buffer_reader
+    template<typename CharT>
+    class unicode_buffer_reader {
+    public:
+        unicode_buffer_reader(const CharT *begin, const CharT *end, const unicode_format_spec &format) :
+                m_pos(begin), m_last(begin), m_end(end), m_format(format), m_good(true) {
+        }
+
+        int get() {
+            if (m_pos == m_end) {
+                m_good = false;
+                return -1;
+            }
+            m_last = m_pos;
+            return static_cast<unsigned char>(ascii_char(decode_code_point(m_pos, m_end), m_format));
+        }
+
+        int peek() const {
+            if (m_pos == m_end) {
+                return -1;
+            }
+            const CharT *pos = m_pos;
+            return static_cast<unsigned char>(ascii_char(decode_code_point(pos, m_end), m_format));
+        }
+
+        /// Puts back the last code point returned by get()
+        void unget() {
+            m_pos = m_last;
+        }
+
+        operator bool() const {
+            return m_good;
+        }
+
+    private:
+        const CharT *m_pos;
+        const CharT *m_last;
+        const CharT *m_end;
+        const unicode_format_spec &m_format;
+        bool m_good;
+    };
+
+    /// Returns format given by numpunct facet of locale for char type of wide stream
+    template<typename CharT>
+    unicode_format_spec unicode_spec_from_locale(const std::locale &locale) {
+        if (!std::has_facet<std::numpunct<CharT> >(locale)) {
+            return make_unicode_format_spec();
+        }
+        const std::numpunct<CharT> &facet = std::use_facet<std::numpunct<CharT> >(locale);
+        const std::string grouping = facet.grouping();
+        unicode_format_spec result = make_unicode_format_spec(
+                make_format_spec('.', ',', !grouping.empty(), grouping));
+        result.decimal_point = code_unit_value(facet.decimal_point());
+        result.thousands_sep = code_unit_value(facet.thousands_sep());
+        return result;
+    }
+
+    /// Appends decimal digit to value, with sign applied so that DEC_MIN_INT64 can be reached.
+    /// \result Returns false if value would overflow
+    inline bool append_digit(int64 &value, int sign, int digit) {
+        if (sign < 0) {
+            if (value < (DEC_MIN_INT64 + digit) / 10) {
+                return false;
+            }
+            value = 10 * value - digit;
+        } else {
+            if (value > (DEC_MAX_INT64 - digit) / 10) {
+                return false;
+            }
+            value = 10 * value + digit;
+        }
+        return true;
+    }
+
+    /// Checks if exponent digits follow 'e', with optional sign which is read only when a digit follows it.
+    /// Other chars are left in input.
+    template<typename StreamType>
+    bool read_exponent_sign(StreamType &input, int &expSign) {
+        const int next = input.peek();
+        if (next == '-' || next == '+') {
+            input.get();
+            const int digit = input.peek();
+            if (digit >= '0' && digit <= '9') {
+                expSign = (next == '-') ? -1 : 1;
+                return true;
+            }
+            input.unget();
+            return false;
+        }
+        return next >= '0' && next <= '9';
+    }
+
+    /// Extract values from stream ready to be packed to decimal.
+    /// Value is (before + after / 10^decimalDigits) * 10^exponent, exponent is given
+    /// in input after 'e' or 'E' (e.g. "1.25E-3"). 'e' without exponent digits
+    /// ends the number, like any other char, and only the 'e' is read from input.
+    template<typename StreamType>
+    bool parse_unpacked(StreamType &input, const format_spec &format, int &sign, int64 &before, int64 &after,
+                        int &decimalDigits, int &exponent) {
+
+        const char dec_point = format.decimal_point;
+        const bool thousands_grouping = format.thousands_grouping;
+        const char thousands_sep = format.thousands_sep;
 
         enum StateEnum {
-            IN_SIGN, IN_BEFORE_FIRST_DIG, IN_BEFORE_DEC, IN_AFTER_DEC, IN_END
+            IN_SIGN, IN_BEFORE_FIRST_DIG, IN_BEFORE_DEC, IN_AFTER_DEC, IN_EXP_FIRST_DIG, IN_EXP, IN_END
         } state = IN_SIGN;
+        // larger exponents overflow anyway
+        const int maxExponent = 100000;
         enum ErrorCodes {
             ERR_WRONG_CHAR = -1,
             ERR_NO_DIGITS = -2,
             ERR_WRONG_STATE = -3,
-            ERR_STREAM_GET_ERROR = -4
+            ERR_STREAM_GET_ERROR = -4,
+            ERR_OVERFLOW = -5
         };
 
         before = after = 0;
@@ -1808,6 +4104,8 @@ namespace details {
         int error = 0;
         int digitsCount = 0;
         int afterDigitCount = 0;
+        int expSign = 1;
+        int expValue = 0;
         char c;
 
         while ((input) && (state != IN_END)) // loop while extraction from file is possible
@@ -1835,7 +4133,11 @@ namespace details {
                 break;
             case IN_BEFORE_FIRST_DIG:
                 if ((c >= '0') && (c <= '9')) {
-                    before = 10 * before + static_cast<int>(c - '0');
+                    if (!append_digit(before, sign, static_cast<int>(c - '0'))) {
+                        state = IN_END;
+                        error = ERR_OVERFLOW;
+                        break;
+                    }
                     state = IN_BEFORE_DEC;
                     digitsCount++;
                 } else if (c == dec_point) {
@@ -1847,22 +4149,32 @@ namespace details {
                 break;
             case IN_BEFORE_DEC:
                 if ((c >= '0') && (c <= '9')) {
-                    before = 10 * before + static_cast<int>(c - '0');
+                    if (!append_digit(before, sign, static_cast<int>(c - '0'))) {
+                        state = IN_END;
+                        error = ERR_OVERFLOW;
+                        break;
+                    }
                     digitsCount++;
                 } else if (c == dec_point) {
                     state = IN_AFTER_DEC;
                 } else if (thousands_grouping && c == thousands_sep) {
                     ; // ignore the char
+                } else if (c == 'e' || c == 'E') {
+                    // not an exponent: number ends at 'e' (e.g. "100EUR")
+                    state = read_exponent_sign(input, expSign) ? IN_EXP_FIRST_DIG : IN_END;
                 } else {
                     state = IN_END;
                 }
                 break;
             case IN_AFTER_DEC:
                 if ((c >= '0') && (c <= '9')) {
-                    after = 10 * after + static_cast<int>(c - '0');
-                    afterDigitCount++;
-                    if (afterDigitCount >= DEC_NAMESPACE::max_decimal_points)
-                        state = IN_END;
+                    // digits beyond supported precision are skipped, exponent can follow them
+                    if (afterDigitCount < DEC_NAMESPACE::max_decimal_points) {
+                        after = 10 * after + static_cast<int>(c - '0');
+                        afterDigitCount++;
+                    }
+                } else if ((c == 'e' || c == 'E') && digitsCount > 0) {
+                    state = read_exponent_sign(input, expSign) ? IN_EXP_FIRST_DIG : IN_END;
                 } else {
                     state = IN_END;
                     if (digitsCount == 0) {
@@ -1870,6 +4182,23 @@ namespace details {
                     }
                 }
                 break;
+            case IN_EXP_FIRST_DIG:
+                if ((c >= '0') && (c <= '9')) {
+                    expValue = static_cast<int>(c - '0');
+                    state = IN_EXP;
+                } else {
+                    state = IN_END;
+                }
+                break;
+            case IN_EXP:
+                if ((c >= '0') && (c <= '9')) {
+                    if (expValue < maxExponent) {
+                        expValue = 10 * expValue + static_cast<int>(c - '0');
+                    }
+                } else {
+                    state = IN_END;
+                }
+                break;
             default:
                 error = ERR_WRONG_STATE;
                 state = IN_END;
@@ -1878,11 +4207,12 @@ namespace details {
         } // while stream good & not end
 
         decimalDigits = afterDigitCount;
+        exponent = expSign * expValue;
 
         if (error >= 0) {
 
+            // before is accumulated with sign already applied
             if (sign < 0) {
-                before = -before;
                 after = -after;
             }
 
@@ -1893,15 +4223,261 @@ namespace details {
         return (error >= 0);
     } // function
 
+    template<typename StreamType>
+    bool parse_unpacked(StreamType &input, const basic_decimal_format &format, int &sign, int64 &before, int64 &after,
+                        int &decimalDigits, int &exponent) {
+        return parse_unpacked(input, format.spec(), sign, before, after, decimalDigits, exponent);
+    }
+
+    /// Version of parse_unpacked() for values without exponent, fails for exponent forms
+    template<typename StreamType>
+    bool parse_unpacked(StreamType &input, const format_spec &format, int &sign, int64 &before, int64 &after,
+                        int &decimalDigits) {
+        int exponent;
+        if (!parse_unpacked(input, format, sign, before, after, decimalDigits, exponent)) {
+            return false;
+        }
+        if (exponent != 0) {
+            before = after = 0;
+            return false;
+        }
+        return true;
+    }
+
+    template<typename StreamType>
+    bool parse_unpacked(StreamType &input, const basic_decimal_format &format, int &sign, int64 &before, int64 &after,
+                        int &decimalDigits) {
+        return parse_unpacked(input, format.spec(), sign, before, after, decimalDigits);
+    }
+
     template<typename StreamType>
     bool parse_unpacked(StreamType &input, int &sign, int64 &before, int64 &after,
                         int &decimalDigits) {
-        return parse_unpacked(input, format_from_stream(input), sign, before, after, decimalDigits);
+        return parse_unpacked(input, format_spec_from_stream(input), sign, before, after, decimalDigits);
     }
 }
 ;
 // namespace
 
+namespace details {
+
+    /// Packs result of parse_unpacked() into decimal, rounding when there are
+    /// more digits after decimal point than decimal_type supports.
+    /// \result Returns false and sets output to 0 if value does not fit
+    template<int Prec, class RoundPolicy>
+    bool pack_parsed(int64 before, int64 after, int afterDigits, decimal<Prec, RoundPolicy> &output) {
+        typedef decimal<Prec, RoundPolicy> decimal_type;
+        if (afterDigits <= Prec) {
+            // direct mode
+            const int64 factor = decimal_type::getPrecFactor();
+            after *= dec_utils<def_round_policy>::pow10(Prec - afterDigits);
+            if (dec_utils<def_round_policy>::isMultOverflow(before, factor) ||
+                (before > 0 && after > DEC_MAX_INT64 - before * factor) ||
+                (before < 0 && after < DEC_MIN_INT64 - before * factor)) {
+                output = decimal_type(0);
+                return false;
+            }
+            output.pack(before, after);
+            return true;
+        }
+        // rounding mode, |before.after| * 10^afterDigits always fits in 128 bits
+        const bool negative = (before < 0) || (after < 0);
+        const uint128 mantissa = uint128(abs_unsigned(before)) * pow10_wide(afterDigits) +
+                                 uint128(abs_unsigned(after));
+        const uint128 divisor = pow10_wide(afterDigits - Prec);
+        uint128 quot, rem;
+        uint128::divmod(mantissa, divisor, quot, rem);
+        int64 value;
+        if (!round_sticky<RoundPolicy>(value, negative, quot, fraction_class(rem, divisor))) {
+            output = decimal_type(0);
+            return false;
+        }
+        output.setUnbiased(value);
+        return true;
+    }
+
+    /// Version of pack_parsed() for values with exponent, rounds using policy of decimal_type.
+    /// \result Returns false and sets output to 0 if value does not fit
+    template<int Prec, class RoundPolicy>
+    bool pack_parsed(int64 before, int64 after, int afterDigits, int exponent, decimal<Prec, RoundPolicy> &output) {
+        typedef decimal<Prec, RoundPolicy> decimal_type;
+        if (exponent == 0) {
+            return pack_parsed(before, after, afterDigits, output);
+        }
+        // mantissa = |before.after| without decimal point, it always fits in 128 bits
+        // and is below 10^37, so it is scaled and rounded only once
+        const bool negative = (before < 0) || (after < 0);
+        const uint128 mantissa = uint128(abs_unsigned(before)) * pow10_wide(afterDigits) +
+                                 uint128(abs_unsigned(after));
+        const int shift = exponent - afterDigits + Prec;
+        uint128 quot;
+        int fractionClass = 0;
+        if (shift > 19) {
+            // 10^19 > 2^63, only zero fits
+            if (!mantissa.isZero()) {
+                output = decimal_type(0);
+                return false;
+            }
+        } else if (shift >= 0) {
+            const uint256 product(mantissa, pow10_wide(shift));
+            if (product.bitLength() > 64) {
+                output = decimal_type(0);
+                return false;
+            }
+            quot = product.shiftedRight(0);
+        } else if (-shift > 38) {
+            // quotient is 0 and fraction is below half
+            fractionClass = mantissa.isZero() ? 0 : 1;
+        } else {
+            const uint128 divisor = pow10_wide(-shift);
+            uint128 rem;
+            uint128::divmod(mantissa, divisor, quot, rem);
+            fractionClass = fraction_class(rem, divisor);
+        }
+        int64 value;
+        if (!round_sticky<RoundPolicy>(value, negative, quot, fractionClass)) {
+            output = decimal_type(0);
+            return false;
+        }
+        output.setUnbiased(value);
+        return true;
+    }
+
+    // --> Fixed-width parser
+    // Fields like "-123.4567" are processed 8 chars at a time in 64-bit words (SWAR),
+    // with the first char in the lowest byte.
+
+    inline uint64 load_word(const char *data) {
+        uint64 result = 0;
+        for (int i = 7; i >= 0; --i) {
+            result = (result << 8) | static_cast<unsigned char>(data[i]);
+        }
+        return result;
+    }
+
+    inline int count_trailing_zeros(uint64 value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(value);
+#else
+        int result = 0;
+        while ((value & 1) == 0) {
+            value >>= 1;
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    /// Returns word with high bit set in every byte which is not a digit
+    inline uint64 non_digit_bytes(uint64 word) {
+        const uint64 highBits = 0x8080808080808080ULL;
+        const uint64 low = word & ~highBits;
+        // carries do not cross bytes, because every byte of low is < 0x80
+        const uint64 belowZero = ~(low + 0x5050505050505050ULL);
+        const uint64 aboveNine = low + 0x4646464646464646ULL;
+        return (word | belowZero | aboveNine) & highBits;
+    }
+
+    /// Returns number of digits at the beginning of data (max 16), 16 bytes must be readable
+    inline int digit_run(const char *data) {
+        const uint64 first = non_digit_bytes(load_word(data));
+        if (first != 0) {
+            return count_trailing_zeros(first) / 8;
+        }
+        const uint64 second = non_digit_bytes(load_word(data + 8));
+        return (second != 0) ? (8 + count_trailing_zeros(second) / 8) : 16;
+    }
+
+    /// Converts word with 8 digit values (0-9, the most significant in the lowest byte)
+    inline uint64 combine_8_digits(uint64 word) {
+        // pairs, then groups of 4, then all 8 digits
+        word = (word * (10 * 256 + 1)) >> 8;
+        word = ((word & 0x00FF00FF00FF00FFULL) * (100 * 65536 + 1)) >> 16;
+        return ((word & 0x0000FFFF0000FFFFULL) * (10000ULL * 4294967296ULL + 1)) >> 32;
+    }
+
+    /// Converts up to 8 digits
+    inline uint64 parse_short_digits(const char *data, int count) {
+        if (count == 0) {
+            return 0;
+        }
+        // digits are moved to the most significant bytes, lower bytes work as leading zeros
+        const uint64 word = (load_word(data) & 0x0F0F0F0F0F0F0F0FULL) << (8 * (8 - count));
+        return combine_8_digits(word);
+    }
+
+    /// Converts up to 16 digits
+    inline uint64 parse_digits(const char *data, int count) {
+        if (count <= 8) {
+            return parse_short_digits(data, count);
+        }
+        return parse_short_digits(data, 8) * static_cast<uint64>(dec_utils<def_round_policy>::pow10(count - 8)) +
+               parse_short_digits(data + 8, count - 8);
+    }
+
+    /// Parses fields with format: [sign]digits[point[digits]] (without spaces or grouping),
+    /// up to 16 digits before and after decimal point, total length up to 32 chars.
+    /// Output is the same as from parse_unpacked().
+    /// \result Returns false if input does not have such format (use parse_unpacked then)
+    inline bool parse_fixed(const char *input, std::size_t size, char decimalPoint, int &sign,
+                            int64 &before, int64 &after, int &afterDigits) {
+        const std::size_t maxSize = 32;
+        if (size == 0 || size > maxSize || (decimalPoint >= '0' && decimalPoint <= '9')) {
+            return false;
+        }
+
+        // copy with zero padding, so that words can be loaded past the end of input
+        char block[maxSize + 16];
+        std::memcpy(block, input, size);
+        std::memset(block + size, 0, sizeof(block) - size);
+
+        std::size_t pos = 0;
+        sign = 1;
+        if (block[0] == '-') {
+            sign = -1;
+            pos = 1;
+        } else if (block[0] == '+') {
+            pos = 1;
+        }
+
+        const std::size_t intStart = pos;
+        const int intDigits = digit_run(block + pos);
+        if (intDigits == 0 || intDigits == 16) {
+            return false;
+        }
+        pos += static_cast<std::size_t>(intDigits);
+
+        std::size_t fracStart = pos;
+        int fracDigits = 0;
+        if (pos < size) {
+            if (block[pos] != decimalPoint) {
+                return false;
+            }
+            fracStart = ++pos;
+            fracDigits = digit_run(block + pos);
+            if (fracDigits == 16) {
+                return false;
+            }
+            pos += static_cast<std::size_t>(fracDigits);
+        }
+
+        if (pos != size) {
+            return false;
+        }
+
+        before = static_cast<int64>(parse_digits(block + intStart, intDigits));
+        after = static_cast<int64>(parse_digits(block + fracStart, fracDigits));
+        if (sign < 0) {
+            before = -before;
+            after = -after;
+        }
+        afterDigits = fracDigits;
+        return true;
+    }
+    // <--
+
+} // namespace details
+
 /// Converts stream of chars to decimal
 /// Handles the following formats ('.' is selected from locale info):
 /// \code
@@ -1913,48 +4489,38 @@ namespace details {
 /// .123
 /// 0.
 /// -.123
+/// 1.25E-3
+/// 6e5
 /// \endcode
 /// Spaces and tabs on the front are ignored.
+/// Values with exponent are rounded using policy of decimal_type, values which
+/// do not fit in decimal_type are treated as errors.
 /// Performs rounding when provided value has higher precision than in output type.
 /// \param[in] input input stream
 /// \param[out] output decimal value, 0 on error
 /// \result Returns true if conversion succeeded
 template<typename decimal_type, typename StreamType>
-bool fromStream(StreamType &input, const basic_decimal_format &format, decimal_type &output) {
-    int sign, afterDigits;
+bool fromStream(StreamType &input, const format_spec &format, decimal_type &output) {
+    int sign, afterDigits, exponent;
     int64 before, after;
     bool result = details::parse_unpacked(input, format, sign, before, after,
-            afterDigits);
+            afterDigits, exponent);
     if (result) {
-        if (afterDigits <= decimal_type::decimal_points) {
-            // direct mode
-            int corrCnt = decimal_type::decimal_points - afterDigits;
-            while (corrCnt > 0) {
-                after *= 10;
-                --corrCnt;
-            }
-            output.pack(before, after);
-        } else {
-            // rounding mode
-            int corrCnt = afterDigits;
-            int64 decimalFactor = 1;
-            while (corrCnt > 0) {
-                before *= 10;
-                decimalFactor *= 10;
-                --corrCnt;
-            }
-            decimal_type temp(before + after, decimalFactor);
-            output = temp;
-        }
+        result = details::pack_parsed(before, after, afterDigits, exponent, output);
     } else {
         output = decimal_type(0);
     }
     return result;
 }
 
+template<typename decimal_type, typename StreamType>
+bool fromStream(StreamType &input, const basic_decimal_format &format, decimal_type &output) {
+    return fromStream(input, format.spec(), output);
+}
+
     template<typename decimal_type, typename StreamType>
     bool fromStream(StreamType &input, decimal_type &output) {
-        return fromStream(input, format_from_stream(input), output);
+        return fromStream(input, format_spec_from_stream(input), output);
     }
 
     /// Exports decimal to string
@@ -1965,25 +4531,54 @@ bool fromStream(StreamType &input, const basic_decimal_format &format, decimal_t
     /// aaaa is stream of digits after decimal point
     template<int prec, typename roundPolicy>
     std::string &toString(const decimal<prec, roundPolicy> &arg,
-            const basic_decimal_format &format,
+            const format_spec &format,
             std::string &output) {
-        using namespace std;
+        output.clear();
+        return decimal_formatter(format).append(arg, output);
+    }
+
+    /// Writes value to buffer of at least max_unicode_units chars, without terminating zero,
+    /// as UTF-8 (char, char8_t), UTF-16 (char16_t) or UTF-32 (char32_t, wchar_t on most platforms).
+    /// \result Returns pointer past the last written char
+    template<typename CharT, int prec, typename roundPolicy>
+    CharT *toString(const decimal<prec, roundPolicy> &arg, const unicode_format_spec &format, CharT *buffer) {
+        char ascii[decimal_formatter::max_chars];
+        const decimal_formatter formatter(details::ascii_spec(format));
+        return details::encode_ascii(ascii, formatter.format(arg, ascii), format, buffer);
+    }
 
-        ostringstream out;
-        toStream(arg, format, out);
-        output = DEC_MOVE(out.str());
+    template<typename CharT, int prec, typename roundPolicy>
+    std::basic_string<CharT> &toString(const decimal<prec, roundPolicy> &arg, const unicode_format_spec &format,
+                                       std::basic_string<CharT> &output) {
+        CharT buffer[max_unicode_units];
+        output.assign(buffer, toString(arg, format, buffer));
         return output;
     }
 
+    /// Returns text in given char type, e.g. toString<char16_t>(value, format)
+    template<typename CharT, int prec, typename roundPolicy>
+    std::basic_string<CharT> toString(const decimal<prec, roundPolicy> &arg, const unicode_format_spec &format) {
+        std::basic_string<CharT> res;
+        toString(arg, format, res);
+        return res;
+    }
+
     template<int prec, typename roundPolicy>
     std::string &toString(const decimal<prec, roundPolicy> &arg,
-                          std::string &output) {
-        using namespace std;
+            const basic_decimal_format &format,
+            std::string &output) {
+        if (format.has_unicode_separators()) {
+            return toString(arg, format.unicode_spec(), output);
+        }
+        return toString(arg, format.spec(), output);
+    }
 
-        ostringstream out;
-        toStream(arg, out);
-        output = DEC_MOVE(out.str());
-        return output;
+    /// Version of toString() using format of global locale
+    template<int prec, typename roundPolicy>
+    std::string &toString(const decimal<prec, roundPolicy> &arg,
+                          std::string &output) {
+        output.clear();
+        return decimal_formatter(std::locale()).append(arg, output);
     }
 
     /// Exports decimal to string
@@ -1999,6 +4594,13 @@ bool fromStream(StreamType &input, const basic_decimal_format &format, decimal_t
         return res;
     }
 
+    template<int prec, typename roundPolicy>
+    std::string toString(const decimal<prec, roundPolicy> &arg, const format_spec &format) {
+        std::string res;
+        toString(arg, format, res);
+        return res;
+    }
+
     template<int prec, typename roundPolicy>
     std::string toString(const decimal<prec, roundPolicy> &arg, const basic_decimal_format &format) {
         std::string res;
@@ -2006,22 +4608,78 @@ bool fromStream(StreamType &input, const basic_decimal_format &format, decimal_t
         return res;
     }
 
+    /// Exports decimal to string in scientific notation, e.g. "1.25e-3" or "6e5".
+    /// Output can be read by fromString() without loss of precision.
+    template<int prec, typename roundPolicy>
+    std::string toStringWithExponent(const decimal<prec, roundPolicy> &arg,
+                                     const basic_decimal_format &format = basic_decimal_format()) {
+        if (format.has_unicode_separators()) {
+            const unicode_format_spec unicode = format.unicode_spec();
+            char ascii[decimal_formatter::max_chars];
+            char buffer[max_unicode_units];
+            const decimal_formatter formatter(details::ascii_spec(unicode));
+            return std::string(buffer, details::encode_ascii(ascii, formatter.format_exponent(arg, ascii), unicode,
+                                                             buffer));
+        }
+        return toStringWithExponent(arg, format.spec());
+    }
+
+    template<int prec, typename roundPolicy>
+    std::string toStringWithExponent(const decimal<prec, roundPolicy> &arg, const format_spec &format) {
+        char buffer[decimal_formatter::max_chars];
+        const decimal_formatter formatter(format);
+        return std::string(buffer, formatter.format_exponent(arg, buffer));
+    }
+
     // input
+    template<class traits, int prec, typename roundPolicy>
+    std::basic_istream<char, traits> &
+    operator>>(std::basic_istream<char, traits> & is,
+            decimal<prec, roundPolicy> & d) {
+        if (!fromStream(is, d))
+            d.setUnbiased(0);
+        return is;
+    }
+
+    // input from wide stream, separators of numpunct<charT> are compared as code points
     template<class charT, class traits, int prec, typename roundPolicy>
     std::basic_istream<charT, traits> &
     operator>>(std::basic_istream<charT, traits> & is,
             decimal<prec, roundPolicy> & d) {
-        if (!fromStream(is, d))
+        const unicode_format_spec format = details::unicode_spec_from_locale<charT>(is.getloc());
+        details::unicode_stream_reader<std::basic_istream<charT, traits> > input(is, format);
+        if (!fromStream(input, details::ascii_spec(format), d))
             d.setUnbiased(0);
         return is;
     }
 
     // output
+    template<class traits, int prec, typename roundPolicy>
+    std::basic_ostream<char, traits> &
+    operator<<(std::basic_ostream<char, traits> & os,
+            const decimal<prec, roundPolicy> & d) {
+        toStream(d, os);
+        return os;
+    }
+
+    // output to wide stream, written at once with stream width and fill
     template<class charT, class traits, int prec, typename roundPolicy>
     std::basic_ostream<charT, traits> &
     operator<<(std::basic_ostream<charT, traits> & os,
             const decimal<prec, roundPolicy> & d) {
-        toStream(d, os);
+        charT buffer[max_unicode_units];
+        const std::streamsize length =
+                toString(d, details::unicode_spec_from_locale<charT>(os.getloc()), buffer) - buffer;
+        const std::streamsize padding = os.width() > length ? os.width() - length : 0;
+        const bool left = (os.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+        for (std::streamsize i = 0; !left && i < padding; ++i) {
+            os.put(os.fill());
+        }
+        os.write(buffer, length);
+        for (std::streamsize i = 0; left && i < padding; ++i) {
+            os.put(os.fill());
+        }
+        os.width(0);
         return os;
     }
 
@@ -2031,39 +4689,186 @@ bool fromStream(StreamType &input, const basic_decimal_format &format, decimal_t
     /// '.' is locale-dependent decimal point character
     /// bbbb is stream of digits before decimal point
     /// aaaa is stream of digits after decimal point
+    /// Imports decimal from buffer of chars (not required to be zero-terminated),
+    /// using format of global locale. See also fromString(const std::string &).
     template<typename T>
-    T fromString(const std::string &str) {
-        std::istringstream is(str);
+    T fromString(const char *str, std::size_t size, const format_spec &format) {
         T t;
+        fromString(str, size, format, t);
+        return t;
+    }
 
-        if (!fromStream(is, t)) {
-            t.setUnbiased(0);
+    template<typename T>
+    T fromString(const char *str, std::size_t size, const basic_decimal_format &format) {
+        T t;
+        fromString(str, size, format, t);
+        return t;
+    }
+
+    template<typename T>
+    T fromString(const char *str, std::size_t size) {
+        details::buffer_reader input(str, str + size);
+        return fromString<T>(str, size, format_spec_from_stream(input));
+    }
+
+    template<typename T>
+    void fromString(const char *str, std::size_t size, T &out) {
+        out = fromString<T>(str, size);
+    }
+
+    /// Version of fromString() which reports errors, output is 0 on error.
+    /// \result Returns true if conversion succeeded
+    template<typename T>
+    bool fromString(const char *str, std::size_t size, const format_spec &format, T &out) {
+        int sign, afterDigits;
+        int64 before, after;
+
+        // short plain fields are handled by fixed-width parser, the rest by stream parser
+        if (details::parse_fixed(str, size, format.decimal_point, sign, before, after, afterDigits)) {
+            return details::pack_parsed(before, after, afterDigits, out);
         }
 
-        return t;
+        details::buffer_reader input(str, str + size);
+        return fromStream(input, format, out);
+    }
+
+    /// Imports decimal from text in UTF-8 (char, char8_t), UTF-16 (char16_t) or UTF-32
+    /// (char32_t, wchar_t on most platforms), see toString(const decimal &, const unicode_format_spec &, CharT *).
+    /// \result Returns true if conversion succeeded
+    template<typename CharT, typename T>
+    bool fromString(const CharT *str, std::size_t size, const unicode_format_spec &format, T &out) {
+        const CharT *pos = str;
+        const CharT *end = str + size;
+        const format_spec ascii = details::ascii_spec(format);
+        // short fields are converted at once and handled as plain chars
+        char buffer[decimal_formatter::max_chars];
+        std::size_t length = 0;
+        while (pos != end && length < sizeof(buffer)) {
+            buffer[length++] = details::ascii_char(details::decode_code_point(pos, end), format);
+        }
+        if (pos == end) {
+            return fromString(buffer, length, ascii, out);
+        }
+
+        details::unicode_buffer_reader<CharT> input(str, end, format);
+        return fromStream(input, ascii, out);
+    }
+
+    template<typename T>
+    bool fromString(const char *str, std::size_t size, const basic_decimal_format &format, T &out) {
+        if (format.has_unicode_separators()) {
+            return fromString(str, size, format.unicode_spec(), out);
+        }
+        return fromString(str, size, format.spec(), out);
+    }
+
+    template<typename T>
+    T fromString(const char *str) {
+        return fromString<T>(str, std::strlen(str));
+    }
+
+    template<typename T>
+    T fromString(const std::string &str) {
+        return fromString<T>(str.data(), str.size());
+    }
+
+    template<typename T>
+    T fromString(const std::string &str, const format_spec &format) {
+        return fromString<T>(str.data(), str.size(), format);
     }
 
     template<typename T>
     T fromString(const std::string &str, const basic_decimal_format &format) {
-        std::istringstream is(str);
-        T t;
+        return fromString<T>(str.data(), str.size(), format);
+    }
 
-        if (!fromStream(is, format, t)) {
-            t.setUnbiased(0);
-        }
+#if DEC_USE_STRING_VIEW
+    template<typename T>
+    T fromString(std::string_view str) {
+        return fromString<T>(str.data(), str.size());
+    }
 
-        return t;
+    template<typename T>
+    T fromString(std::string_view str, const format_spec &format) {
+        return fromString<T>(str.data(), str.size(), format);
     }
 
+    template<typename T>
+    T fromString(std::string_view str, const basic_decimal_format &format) {
+        return fromString<T>(str.data(), str.size(), format);
+    }
+#endif
+
     template<typename T>
     void fromString(const std::string &str, const basic_decimal_format &format, T &out) {
         out = fromString<T>(str, format);
     }
 
+    template<typename T>
+    void fromString(const std::string &str, const format_spec &format, T &out) {
+        out = fromString<T>(str, format);
+    }
+
     template<typename T>
     void fromString(const std::string &str, T &out) {
         out = fromString<T>(str);
     }
 
+    template<typename T, typename CharT>
+    T fromString(const std::basic_string<CharT> &str, const unicode_format_spec &format) {
+        T t;
+        fromString(str.data(), str.size(), format, t);
+        return t;
+    }
+
+// ----------------------------------------------------------------------------
+// Explicit instantiation
+// ----------------------------------------------------------------------------
+// Library target "decimal" (src/decimal.cpp) instantiates the most common types with
+// DEC_INSTANTIATE_TEMPLATES, code linked with it defines DEC_EXTERN_TEMPLATES
+// to skip instantiating them again. Configuration macros must be the same in both.
+#if !defined(DEC_NO_CPP11) && (defined(DEC_EXTERN_TEMPLATES) || defined(DEC_INSTANTIATE_TEMPLATES))
+
+#ifdef DEC_INSTANTIATE_TEMPLATES
+#define DEC_TEMPLATE_INSTANCE template
+#else
+#define DEC_TEMPLATE_INSTANCE extern template
+#endif
+
+#define DEC_INSTANTIATE_DECIMAL(prec, policy) \
+    DEC_TEMPLATE_INSTANCE class decimal<prec, policy>; \
+    DEC_TEMPLATE_INSTANCE std::string toString(const decimal<prec, policy> &); \
+    DEC_TEMPLATE_INSTANCE std::string toString(const decimal<prec, policy> &, const basic_decimal_format &); \
+    DEC_TEMPLATE_INSTANCE std::string toString(const decimal<prec, policy> &, const format_spec &); \
+    DEC_TEMPLATE_INSTANCE bool fromString(const char *, std::size_t, const format_spec &, \
+                                          decimal<prec, policy> &); \
+    DEC_TEMPLATE_INSTANCE bool fromString(const char *, std::size_t, const basic_decimal_format &, \
+                                          decimal<prec, policy> &); \
+    DEC_TEMPLATE_INSTANCE decimal<prec, policy> fromString<decimal<prec, policy> >(const std::string &); \
+    DEC_TEMPLATE_INSTANCE std::ostream &operator<<(std::ostream &, const decimal<prec, policy> &); \
+    DEC_TEMPLATE_INSTANCE std::istream &operator>>(std::istream &, decimal<prec, policy> &);
+
+#define DEC_INSTANTIATE_PRECISIONS(policy) \
+    DEC_INSTANTIATE_DECIMAL(2, policy) \
+    DEC_INSTANTIATE_DECIMAL(4, policy) \
+    DEC_INSTANTIATE_DECIMAL(6, policy) \
+    DEC_INSTANTIATE_DECIMAL(8, policy)
+
+    DEC_INSTANTIATE_PRECISIONS(def_round_policy)
+    DEC_INSTANTIATE_PRECISIONS(null_round_policy)
+    DEC_INSTANTIATE_PRECISIONS(half_down_round_policy)
+    DEC_INSTANTIATE_PRECISIONS(half_up_round_policy)
+    DEC_INSTANTIATE_PRECISIONS(half_even_round_policy)
+    DEC_INSTANTIATE_PRECISIONS(ceiling_round_policy)
+    DEC_INSTANTIATE_PRECISIONS(floor_round_policy)
+    DEC_INSTANTIATE_PRECISIONS(round_down_round_policy)
+    DEC_INSTANTIATE_PRECISIONS(round_up_round_policy)
+
+#undef DEC_INSTANTIATE_PRECISIONS
+#undef DEC_INSTANTIATE_DECIMAL
+#undef DEC_TEMPLATE_INSTANCE
+
+#endif // explicit instantiation
+
 } // namespace
 #endif // _DECIMAL_H__
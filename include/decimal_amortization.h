@@ -0,0 +1,170 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_amortization.h
+// Purpose:     Loan amortization and compound interest schedules
+//              calculated on decimal values.
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_AMORTIZATION_H__
+#define _DECIMAL_AMORTIZATION_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_amortization.h
+///
+/// Annuity (equal payment) schedules with rounding performed in every period.
+///
+/// Sample usage:
+///   using namespace dec;
+///   annuity_plan<2, 8> plan(decimal<8>("0.005"), 360);
+///   amortization_entry<2> rows[360];
+///   plan.schedule(decimal<2>(100000), rows);
+///
+/// Plan is immutable after construction, so one plan can be shared by many
+/// loans and used from many threads at the same time.
+
+#include "decimal.h"
+
+#include <cstddef>
+
+namespace DEC_NAMESPACE {
+
+/// Single period of amortization schedule
+template<int Prec, class RoundPolicy = def_round_policy>
+struct amortization_entry {
+    typedef decimal<Prec, RoundPolicy> amount_type;
+
+    amount_type payment;
+    amount_type interest;
+    amount_type principal;
+    /// balance after the payment
+    amount_type balance;
+};
+
+/// Precalculated data for loans with the same periodic rate and number of periods.
+/// Amounts use AmountPrec decimal points, rate uses RatePrec decimal points.
+/// Every calculated amount is rounded using RoundPolicy.
+template<int AmountPrec, int RatePrec, class RoundPolicy = def_round_policy>
+class annuity_plan {
+public:
+    typedef decimal<AmountPrec, RoundPolicy> amount_type;
+    typedef decimal<RatePrec, RoundPolicy> rate_type;
+    typedef amortization_entry<AmountPrec, RoundPolicy> entry_type;
+
+    /// Creates plan for periodic rate (e.g. 0.005 for 6% p.a. paid monthly)
+    /// and number of periods (must be positive).
+    annuity_plan(const rate_type &periodicRate, int periods) :
+            m_rate(periodicRate.getUnbiased()), m_periods(periods), m_factor(0),
+            m_maxDirect(m_rate != 0 ? DEC_MAX_INT64 / (m_rate < 0 ? -m_rate : m_rate) : DEC_MAX_INT64) {
+        static_assert(RatePrec <= max_decimal_points, "rate precision too high");
+        // payment = principal * r / (1 - (1 + r)^-n),
+        // factor is calculated once, with max precision and arithmetic rounding
+        typedef decimal<max_decimal_points> factor_type;
+        factor_type rate;
+        rate.setUnbiased(m_rate * DecimalFactorDiff<max_decimal_points - RatePrec>::value);
+        if (m_rate == 0) {
+            m_factor = 0;
+        } else {
+            const factor_type discount = (factor_type(1) + rate).pow(-periods);
+            m_factor = dec_utils<def_round_policy>::multDiv(rate.getUnbiased(),
+                    factor_type::getPrecFactor(),
+                    factor_type::getPrecFactor() - discount.getUnbiased());
+        }
+    }
+
+    int periods() const {
+        return m_periods;
+    }
+
+    rate_type rate() const {
+        rate_type result;
+        result.setUnbiased(m_rate);
+        return result;
+    }
+
+    /// Returns payment for each period (the last one can be different, see schedule())
+    amount_type payment(const amount_type &principal) const {
+        amount_type result;
+        if (m_rate == 0) {
+            int64 value;
+            RoundPolicy::div_rounded(value, principal.getUnbiased(), m_periods);
+            result.setUnbiased(value);
+        } else {
+            result.setUnbiased(dec_utils<RoundPolicy>::multDiv(principal.getUnbiased(), m_factor,
+                    DecimalFactor<max_decimal_points>::value));
+        }
+        return result;
+    }
+
+    /// Calculates payments for many loans.
+    void payments(const amount_type *principals, amount_type *output, std::size_t count) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            output[i] = payment(principals[i]);
+        }
+    }
+
+    /// Writes periods() entries to output.
+    /// Interest is rounded in every period, the last payment is adjusted
+    /// so that final balance is zero.
+    /// \result Returns total interest
+    amount_type schedule(const amount_type &principal, entry_type *output) const {
+        const int64 paymentValue = payment(principal).getUnbiased();
+        int64 balance = principal.getUnbiased();
+        int64 totalInterest = 0;
+
+        for (int i = 0; i < m_periods; ++i) {
+            const int64 interest = periodInterest(balance);
+            int64 principalPart = paymentValue - interest;
+            if (i == m_periods - 1 || principalPart > balance) {
+                principalPart = balance;
+            }
+            balance -= principalPart;
+            totalInterest += interest;
+
+            entry_type &entry = output[i];
+            entry.payment.setUnbiased(interest + principalPart);
+            entry.interest.setUnbiased(interest);
+            entry.principal.setUnbiased(principalPart);
+            entry.balance.setUnbiased(balance);
+        }
+
+        amount_type result;
+        result.setUnbiased(totalInterest);
+        return result;
+    }
+
+    /// Writes periods() balances of deposit with interest added and rounded in every period.
+    /// \result Returns final balance
+    amount_type accrue(const amount_type &principal, amount_type *output) const {
+        int64 balance = principal.getUnbiased();
+        for (int i = 0; i < m_periods; ++i) {
+            balance += periodInterest(balance);
+            output[i].setUnbiased(balance);
+        }
+        amount_type result;
+        result.setUnbiased(balance);
+        return result;
+    }
+
+private:
+    int64 periodInterest(int64 balance) const {
+        int64 result;
+        if (balance <= m_maxDirect && balance >= -m_maxDirect &&
+            RoundPolicy::div_rounded(result, balance * m_rate, DecimalFactor<RatePrec>::value)) {
+            return result;
+        }
+        return dec_utils<RoundPolicy>::multDiv(balance, m_rate, DecimalFactor<RatePrec>::value);
+    }
+
+    int64 m_rate;
+    int m_periods;
+    // r / (1 - (1 + r)^-n) with max_decimal_points precision
+    int64 m_factor;
+    // max balance for which balance * rate does not overflow
+    int64 m_maxDirect;
+};
+
+} // namespace
+
+#endif // _DECIMAL_AMORTIZATION_H__
@@ -0,0 +1,846 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_bulk.h
+// Purpose:     Operations on arrays of decimal values.
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_BULK_H__
+#define _DECIMAL_BULK_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_bulk.h
+///
+/// Array versions of element-wise operations. Precision differences are resolved
+/// at compile time and loops are free of data-dependent branches, so that compiler
+/// can use constant division and vector instructions where available.
+/// Every function has a scalar reference version (suffix "_reference")
+/// which gives bit-exact the same results.
+///
+/// Sample usage:
+///   dec::decimal<6> prices[100];
+///   dec::decimal<2> rounded[100];
+///   dec::rescale(prices, rounded, 100);
+///
+///   // rows with price between 100 and 101 and quantity above 5
+///   dec::bitmap_word selected[2], byQty[2];
+///   dec::compare_between(prices, 100, dec::decimal<2>(100), dec::decimal<2>(101), selected);
+///   dec::compare(quantities, 100, dec::compare_greater, dec::decimal<0>(5), byQty);
+///   dec::bitmap_and(selected, byQty, selected, dec::bitmap_words(100));
+
+#include "decimal.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace DEC_NAMESPACE {
+
+/// Comparison of array elements with constant, see compare()
+enum compare_op {
+    compare_less,
+    compare_less_equal,
+    compare_greater,
+    compare_greater_equal,
+    compare_equal,
+    compare_not_equal
+};
+
+namespace details {
+
+    /// Division used by reference versions. Built-in policies round without branches
+    /// on data in div_rounded(), so they are compared with div_rounded_reference().
+    template<class RoundPolicy>
+    struct div_reference {
+        static bool div_rounded(int64 &output, int64 a, int64 b) {
+            return RoundPolicy::div_rounded(output, a, b);
+        }
+    };
+
+#define DEC_DEFINE_DIV_REFERENCE(policy) \
+    template<> \
+    struct div_reference<policy> { \
+        static bool div_rounded(int64 &output, int64 a, int64 b) { \
+            return policy::div_rounded_reference(output, a, b); \
+        } \
+    };
+
+    // null_round_policy and round_down_round_policy do not branch at all
+    DEC_DEFINE_DIV_REFERENCE(def_round_policy)
+    DEC_DEFINE_DIV_REFERENCE(half_up_round_policy)
+    DEC_DEFINE_DIV_REFERENCE(half_down_round_policy)
+    DEC_DEFINE_DIV_REFERENCE(half_even_round_policy)
+    DEC_DEFINE_DIV_REFERENCE(ceiling_round_policy)
+    DEC_DEFINE_DIV_REFERENCE(floor_round_policy)
+    DEC_DEFINE_DIV_REFERENCE(round_up_round_policy)
+
+#undef DEC_DEFINE_DIV_REFERENCE
+
+    // element access for arrays of decimals and arrays of unbiased values
+    inline int64 get_unbiased(int64 value) {
+        return value;
+    }
+
+    inline void set_unbiased(int64 &output, int64 value) {
+        output = value;
+    }
+
+    template<int Prec, class RoundPolicy>
+    inline int64 get_unbiased(const decimal<Prec, RoundPolicy> &value) {
+        return value.getUnbiased();
+    }
+
+    template<int Prec, class RoundPolicy>
+    inline void set_unbiased(decimal<Prec, RoundPolicy> &output, int64 value) {
+        output.setUnbiased(value);
+    }
+
+    template<int FromPrec, int ToPrec, class RoundPolicy, bool Widen = (ToPrec >= FromPrec)>
+    struct rescale_kernel {
+        // ToPrec >= FromPrec
+        static DEC_CONSTEXPR int64 factor = DecimalFactorDiff<ToPrec - FromPrec>::value;
+
+        template<class InputType, class OutputType>
+        static std::size_t run(const InputType *input, OutputType *output, std::size_t count, bool *overflow) {
+            const int64 upperLimit = DEC_MAX_INT64 / factor;
+            const int64 lowerLimit = DEC_MIN_INT64 / factor;
+            std::size_t overflowCount = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                const int64 value = get_unbiased(input[i]);
+                const int64 failed = static_cast<int64>((value > upperLimit) | (value < lowerLimit));
+                // product is calculated as unsigned, overflowed values are masked out
+                set_unbiased(output[i],
+                             static_cast<int64>(static_cast<uint64>(value) * static_cast<uint64>(factor))
+                             & (failed - 1));
+                overflowCount += static_cast<std::size_t>(failed);
+                if (overflow != NULL) {
+                    overflow[i] = (failed != 0);
+                }
+            }
+            return overflowCount;
+        }
+
+        template<class InputType, class OutputType>
+        static std::size_t reference(const InputType *input, OutputType *output, std::size_t count,
+                                     bool *overflow) {
+            std::size_t overflowCount = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                const int64 value = get_unbiased(input[i]);
+                const bool failed = dec_utils<RoundPolicy>::isMultOverflow(value, factor);
+                set_unbiased(output[i], failed ? 0 : value * factor);
+                if (failed) {
+                    ++overflowCount;
+                }
+                if (overflow != NULL) {
+                    overflow[i] = failed;
+                }
+            }
+            return overflowCount;
+        }
+    };
+
+    template<int FromPrec, int ToPrec, class RoundPolicy>
+    struct rescale_kernel<FromPrec, ToPrec, RoundPolicy, false> {
+        static DEC_CONSTEXPR int64 divisor = DecimalFactorDiff<FromPrec - ToPrec>::value;
+
+        template<class Kernel, class InputType, class OutputType>
+        static std::size_t divide(const InputType *input, OutputType *output, std::size_t count, bool *overflow) {
+            std::size_t overflowCount = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                int64 result;
+                const bool failed = !Kernel::div_rounded(result, get_unbiased(input[i]), divisor);
+                set_unbiased(output[i], failed ? 0 : result);
+                overflowCount += static_cast<std::size_t>(failed);
+                if (overflow != NULL) {
+                    overflow[i] = failed;
+                }
+            }
+            return overflowCount;
+        }
+
+        template<class InputType, class OutputType>
+        static std::size_t run(const InputType *input, OutputType *output, std::size_t count, bool *overflow) {
+            return divide<RoundPolicy>(input, output, count, overflow);
+        }
+
+        template<class InputType, class OutputType>
+        static std::size_t reference(const InputType *input, OutputType *output, std::size_t count,
+                                     bool *overflow) {
+            return divide<div_reference<RoundPolicy> >(input, output, count, overflow);
+        }
+    };
+
+    // selects rescale kernel for policy given at runtime
+    template<int FromPrec, int ToPrec, class InputType, class OutputType>
+    struct rescale_visitor {
+        typedef std::size_t result_type;
+
+        rescale_visitor(const InputType *input, OutputType *output, std::size_t count, bool *overflow) :
+                m_input(input), m_output(output), m_count(count), m_overflow(overflow) {
+        }
+
+        template<class RoundPolicy>
+        std::size_t operator()(const RoundPolicy &) const {
+            return rescale_kernel<FromPrec, ToPrec, RoundPolicy>::run(m_input, m_output, m_count, m_overflow);
+        }
+
+        const InputType *m_input;
+        OutputType *m_output;
+        std::size_t m_count;
+        bool *m_overflow;
+    };
+
+    /// Predicate on unbiased values: (value - low <= width) != inverted, computed on unsigned values.
+    /// Every comparison with constant (also of different precision) is exactly
+    /// expressed as inclusive range of values in array precision.
+    struct range_predicate {
+        uint64 low;
+        uint64 width;
+        // 0 or ~0, xor-ed with result
+        uint64 inverted;
+        bool empty;
+
+        range_predicate() : low(static_cast<uint64>(DEC_MIN_INT64)), width(~static_cast<uint64>(0)),
+                            inverted(0), empty(false) {
+        }
+
+        void set(int64 first, int64 last) {
+            low = static_cast<uint64>(first);
+            width = static_cast<uint64>(last) - static_cast<uint64>(first);
+            empty = first > last;
+        }
+
+        /// Limits range to [first, last]
+        void intersect(int64 first, int64 last) {
+            const int64 currentFirst = static_cast<int64>(low);
+            const int64 currentLast = static_cast<int64>(low + width);
+            set(first > currentFirst ? first : currentFirst, last < currentLast ? last : currentLast);
+        }
+
+        uint64 test(int64 value) const {
+            return static_cast<uint64>((static_cast<uint64>(value) - low) <= width) ^ (inverted & 1);
+        }
+    };
+
+    /// Constant of precision Prec2 expressed in precision Prec:
+    /// floor and ceiling of exact value, overflow is -1 / +1 if value is below / above int64 range.
+    template<int Prec, int Prec2, bool Widen = (Prec >= Prec2)>
+    struct scaled_constant {
+        // Prec >= Prec2
+        scaled_constant(int64 value) : overflow(0), exact(true) {
+            const int64 factor = DecimalFactorDiff<Prec - Prec2>::value;
+            if (dec_utils<def_round_policy>::isMultOverflow(value, factor)) {
+                overflow = (value < 0) ? -1 : 1;
+                floorValue = ceilValue = 0;
+            } else {
+                floorValue = ceilValue = value * factor;
+            }
+        }
+
+        int64 floorValue;
+        int64 ceilValue;
+        int overflow;
+        bool exact;
+    };
+
+    template<int Prec, int Prec2>
+    struct scaled_constant<Prec, Prec2, false> {
+        scaled_constant(int64 value) : overflow(0) {
+            const int64 factor = DecimalFactorDiff<Prec2 - Prec>::value;
+            const int64 quotient = value / factor;
+            const int64 remainder = value % factor;
+            floorValue = quotient - ((remainder < 0) ? 1 : 0);
+            ceilValue = quotient + ((remainder > 0) ? 1 : 0);
+            exact = (remainder == 0);
+        }
+
+        int64 floorValue;
+        int64 ceilValue;
+        int overflow;
+        bool exact;
+    };
+
+    /// Builds predicate equivalent to "element op constant"
+    template<int Prec, int Prec2>
+    range_predicate make_predicate(compare_op op, int64 constant) {
+        const scaled_constant<Prec, Prec2> scaled(constant);
+        range_predicate result;
+        const bool all = (scaled.overflow > 0 && (op == compare_less || op == compare_less_equal)) ||
+                         (scaled.overflow < 0 && (op == compare_greater || op == compare_greater_equal));
+        if (scaled.overflow != 0 && !all) {
+            // no element matches (or all for not_equal)
+            result.set(0, -1);
+            result.inverted = (op == compare_not_equal) ? ~static_cast<uint64>(0) : 0;
+            return result;
+        }
+        if (all) {
+            return result;
+        }
+
+        switch (op) {
+            case compare_less:
+                if (scaled.ceilValue == DEC_MIN_INT64) {
+                    result.set(0, -1);
+                } else {
+                    result.set(DEC_MIN_INT64, scaled.ceilValue - 1);
+                }
+                break;
+            case compare_less_equal:
+                result.set(DEC_MIN_INT64, scaled.floorValue);
+                break;
+            case compare_greater:
+                if (scaled.floorValue == DEC_MAX_INT64) {
+                    result.set(0, -1);
+                } else {
+                    result.set(scaled.floorValue + 1, DEC_MAX_INT64);
+                }
+                break;
+            case compare_greater_equal:
+                result.set(scaled.ceilValue, DEC_MAX_INT64);
+                break;
+            case compare_equal:
+            case compare_not_equal:
+                if (scaled.exact) {
+                    result.set(scaled.floorValue, scaled.floorValue);
+                } else {
+                    result.set(0, -1);
+                }
+                result.inverted = (op == compare_not_equal) ? ~static_cast<uint64>(0) : 0;
+                break;
+        }
+        return result;
+    }
+
+    template<class InputType>
+    std::size_t compare_kernel(const InputType *input, std::size_t count, const range_predicate &predicate,
+                               uint64 *bitmap) {
+        if (predicate.empty) {
+            // result is constant
+            const uint64 fill = predicate.inverted;
+            std::size_t selected = 0;
+            for (std::size_t word = 0; word * 64 < count; ++word) {
+                const std::size_t bits = (count - word * 64 < 64) ? count - word * 64 : 64;
+                bitmap[word] = (bits == 64) ? fill : (fill & ((static_cast<uint64>(1) << bits) - 1));
+                selected += (fill != 0) ? bits : 0;
+            }
+            return selected;
+        }
+
+        std::size_t selected = 0;
+        for (std::size_t first = 0; first < count; first += 64) {
+            const std::size_t bits = (count - first < 64) ? count - first : 64;
+            uint64 word = 0;
+            for (std::size_t i = 0; i < bits; ++i) {
+                const uint64 bit = predicate.test(get_unbiased(input[first + i]));
+                word |= bit << i;
+                selected += static_cast<std::size_t>(bit);
+            }
+            bitmap[first / 64] = word;
+        }
+        return selected;
+    }
+
+    template<class InputType>
+    std::size_t select_kernel(const InputType *input, std::size_t count, const range_predicate &predicate,
+                              std::size_t *rows) {
+        std::size_t selected = 0;
+        if (predicate.empty) {
+            if (predicate.inverted != 0) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    rows[i] = i;
+                }
+                selected = count;
+            }
+            return selected;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            rows[selected] = i;
+            selected += static_cast<std::size_t>(predicate.test(get_unbiased(input[i])));
+        }
+        return selected;
+    }
+
+    /// Exact comparison of values with different precisions, using scalar operators
+    template<int Prec, int Prec2, class RoundPolicy, class RoundPolicy2>
+    bool compare_reference(const decimal<Prec, RoundPolicy> &value, compare_op op,
+                           const decimal<Prec2, RoundPolicy2> &constant) {
+        // both values in precision max(Prec, Prec2), overflow means that value is outside of int64 range
+        int lhsOverflow = 0, rhsOverflow = 0;
+        int64 lhs = value.getUnbiased();
+        int64 rhs = constant.getUnbiased();
+        if (Prec2 > Prec) {
+            const int64 factor = DecimalFactorDiff<(Prec2 > Prec) ? Prec2 - Prec : 0>::value;
+            if (dec_utils<RoundPolicy>::isMultOverflow(lhs, factor)) {
+                lhsOverflow = (lhs < 0) ? -1 : 1;
+            } else {
+                lhs *= factor;
+            }
+        } else {
+            const int64 factor = DecimalFactorDiff<(Prec > Prec2) ? Prec - Prec2 : 0>::value;
+            if (dec_utils<RoundPolicy>::isMultOverflow(rhs, factor)) {
+                rhsOverflow = (rhs < 0) ? -1 : 1;
+            } else {
+                rhs *= factor;
+            }
+        }
+        // -1, 0, 1
+        const int order = (lhsOverflow != rhsOverflow) ? ((lhsOverflow < rhsOverflow) ? -1 : 1)
+                                                       : ((lhs < rhs) ? -1 : ((lhs > rhs) ? 1 : 0));
+        switch (op) {
+            case compare_less:
+                return order < 0;
+            case compare_less_equal:
+                return order <= 0;
+            case compare_greater:
+                return order > 0;
+            case compare_greater_equal:
+                return order >= 0;
+            case compare_equal:
+                return order == 0;
+            case compare_not_equal:
+                return order != 0;
+        }
+        return false;
+    }
+
+    template<int Prec, class RoundPolicy>
+    bool compare_reference(const decimal<Prec, RoundPolicy> &value, compare_op op,
+                           const decimal<Prec, RoundPolicy> &constant) {
+        switch (op) {
+            case compare_less:
+                return value < constant;
+            case compare_less_equal:
+                return value <= constant;
+            case compare_greater:
+                return value > constant;
+            case compare_greater_equal:
+                return value >= constant;
+            case compare_equal:
+                return value == constant;
+            case compare_not_equal:
+                return value != constant;
+        }
+        return false;
+    }
+
+
+    /// Rounding of double as RoundPolicy::round(), with selects instead of branches
+    /// and calls of floor() and ceil() for built-in policies. Valid for |value| < 2^62,
+    /// results are the same.
+    template<class RoundPolicy>
+    struct fp_round_kernel {
+        static int64 round(double value) {
+            return RoundPolicy::round(value);
+        }
+    };
+
+#ifndef DEC_EXTERNAL_ROUND
+    template<>
+    struct fp_round_kernel<def_round_policy> {
+        static int64 round(double value) {
+            // as value - 0.5 for negative values, -0.0 + 0.5 and -0.0 - 0.5 are both truncated to 0
+            return static_cast<int64>(value + copysign(0.5, value));
+        }
+    };
+#endif
+
+    template<>
+    struct fp_round_kernel<null_round_policy> {
+        static int64 round(double value) {
+            return static_cast<int64>(value);
+        }
+    };
+
+    template<>
+    struct fp_round_kernel<round_down_round_policy> : public fp_round_kernel<null_round_policy> {
+    };
+
+    // value = truncated + rest, rest is exact and has sign of value;
+    // floor(value) = truncated - (rest < 0), ceil(value) = truncated + (rest > 0)
+    struct fp_split {
+        explicit fp_split(double value) : truncated(static_cast<int64>(value)),
+                                          rest(value - static_cast<double>(truncated)) {
+        }
+
+        int64 floor() const {
+            return truncated - static_cast<int64>(rest < 0.0);
+        }
+
+        int64 ceil() const {
+            return truncated + static_cast<int64>(rest > 0.0);
+        }
+
+        // fraction calculated by half_*_round_policy::round(), |rest|
+        double fraction() const {
+            return (rest < 0.0) ? -rest : rest;
+        }
+
+        int64 truncated;
+        double rest;
+    };
+
+    template<>
+    struct fp_round_kernel<ceiling_round_policy> {
+        static int64 round(double value) {
+            return fp_split(value).ceil();
+        }
+    };
+
+    template<>
+    struct fp_round_kernel<floor_round_policy> {
+        static int64 round(double value) {
+            return fp_split(value).floor();
+        }
+    };
+
+    template<>
+    struct fp_round_kernel<round_up_round_policy> {
+        static int64 round(double value) {
+            const fp_split split(value);
+            return (value >= 0.0) ? split.ceil() : split.floor();
+        }
+    };
+
+    template<>
+    struct fp_round_kernel<half_down_round_policy> {
+        static int64 round(double value) {
+            const fp_split split(value);
+            const bool up = (value >= 0.0) ? (split.fraction() > 0.5) : (split.fraction() < 0.5);
+            return up ? split.ceil() : split.floor();
+        }
+    };
+
+    template<>
+    struct fp_round_kernel<half_up_round_policy> {
+        static int64 round(double value) {
+            const fp_split split(value);
+            const bool up = (value >= 0.0) ? (split.fraction() >= 0.5) : (split.fraction() <= 0.5);
+            return up ? split.ceil() : split.floor();
+        }
+    };
+
+    template<>
+    struct fp_round_kernel<half_even_round_policy> {
+        static int64 round(double value) {
+            const fp_split split(value);
+            // ties go away from zero when truncated value is odd
+            const double fraction = split.fraction();
+            const bool away = (fraction > 0.5) | ((fraction == 0.5) & ((split.truncated & 1) != 0));
+            const int64 step = static_cast<int64>(away);
+            return split.truncated + ((value < 0.0) ? -step : step);
+        }
+    };
+
+    /// Converts doubles as decimal::setAsDouble(), values for which result does not fit
+    /// in int64 (also infinities and NaN) are set to 0 and marked in outOfRange bitmap.
+    template<int Prec, class RoundPolicy, class OutputType>
+    std::size_t from_doubles_kernel(const double *input, OutputType *output, std::size_t count,
+                                    uint64 *outOfRange) {
+        const int64 factor = DecimalFactor<Prec>::value;
+        const double doubleFactor = static_cast<double>(factor);
+        const int64 upperLimit = DEC_MAX_INT64 / factor;
+        const int64 lowerLimit = DEC_MIN_INT64 / factor;
+        std::size_t failedCount = 0;
+        for (std::size_t first = 0; first < count; first += 64) {
+            const std::size_t bits = (count - first < 64) ? count - first : 64;
+            // flags are packed to bitmap in separate loop, so that conversion can be vectorized
+            int64 failed[64];
+            for (std::size_t i = 0; i < bits; ++i) {
+                const double value = input[first + i];
+                // |value| < 2^63 compared on bits, false for infinities and NaN; larger values
+                // can not be truncated to int64, value is selected by mask as branch would
+                // prevent vectorization
+                uint64 valueBits;
+                std::memcpy(&valueBits, &value, sizeof(value));
+                const bool inLimit = (valueBits & 0x7fffffffffffffffULL) < 0x43e0000000000000ULL;
+                valueBits &= static_cast<uint64>(0) - static_cast<uint64>(inLimit);
+                double safeValue;
+                std::memcpy(&safeValue, &valueBits, sizeof(safeValue));
+                const int64 intPart = static_cast<int64>(safeValue);
+                const double fracPart = safeValue - static_cast<double>(intPart);
+                const int64 rounded = fp_round_kernel<RoundPolicy>::round(doubleFactor * fracPart);
+                // calculated as unsigned, overflowed values are masked out
+                const int64 product = static_cast<int64>(static_cast<uint64>(intPart) * static_cast<uint64>(factor));
+                const int64 sum = static_cast<int64>(static_cast<uint64>(product) + static_cast<uint64>(rounded));
+                // sum overflows when both terms have sign different than sum
+                const int64 sumFailed = static_cast<int64>(static_cast<uint64>((product ^ sum) & (rounded ^ sum)) >> 63);
+                const int64 elementFailed = static_cast<int64>(!inLimit) | static_cast<int64>(intPart > upperLimit) |
+                                            static_cast<int64>(intPart < lowerLimit) | sumFailed;
+                set_unbiased(output[first + i], sum & (elementFailed - 1));
+                failed[i] = elementFailed;
+            }
+            uint64 word = 0;
+            for (std::size_t i = 0; i < bits; ++i) {
+                word |= static_cast<uint64>(failed[i]) << i;
+                failedCount += static_cast<std::size_t>(failed[i]);
+            }
+            if (outOfRange != NULL) {
+                outOfRange[first / 64] = word;
+            }
+        }
+        return failedCount;
+    }
+
+    template<int Prec, class RoundPolicy, class OutputType>
+    std::size_t from_doubles_reference(const double *input, OutputType *output, std::size_t count,
+                                       uint64 *outOfRange) {
+        const int64 factor = DecimalFactor<Prec>::value;
+        std::size_t failedCount = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const double value = input[i];
+            bool failed = true;
+            decimal<Prec, RoundPolicy> result(0);
+            if (value > -9223372036854775808.0 && value < 9223372036854775808.0) {
+                const int64 intPart = static_cast<int64>(value);
+                if (!dec_utils<RoundPolicy>::isMultOverflow(intPart, factor)) {
+                    const int64 product = intPart * factor;
+                    const int64 rounded = RoundPolicy::round(static_cast<double>(factor) *
+                                                             (value - static_cast<double>(intPart)));
+                    if ((rounded >= 0) ? (product <= DEC_MAX_INT64 - rounded) : (product >= DEC_MIN_INT64 - rounded)) {
+                        result.setAsDouble(value);
+                        failed = false;
+                    }
+                }
+            }
+            set_unbiased(output[i], result.getUnbiased());
+            if (outOfRange != NULL) {
+                if (i % 64 == 0) {
+                    outOfRange[i / 64] = 0;
+                }
+                outOfRange[i / 64] |= static_cast<uint64>(failed) << (i % 64);
+            }
+            failedCount += failed ? 1 : 0;
+        }
+        return failedCount;
+    }
+
+    /// Converts as decimal::getAsDouble()
+    template<int Prec, class InputType>
+    void to_doubles_kernel(const InputType *input, double *output, std::size_t count) {
+        const double factor = static_cast<double>(DecimalFactor<Prec>::value);
+        for (std::size_t i = 0; i < count; ++i) {
+            output[i] = static_cast<double>(get_unbiased(input[i])) / factor;
+        }
+    }
+} // namespace details
+
+/// Converts unbiased values from FromPrec to ToPrec precision.
+/// Values are rounded using RoundPolicy when precision is reduced.
+/// Values which do not fit in output precision are set to 0 and marked in optional overflow array.
+/// Input and output can be the same array.
+/// \result Returns number of values which did not fit in output precision
+template<int FromPrec, int ToPrec, class RoundPolicy>
+std::size_t rescale_unbiased(const int64 *input, int64 *output, std::size_t count, bool *overflow = NULL) {
+    return details::rescale_kernel<FromPrec, ToPrec, RoundPolicy>::run(input, output, count, overflow);
+}
+
+/// Scalar reference version of rescale_unbiased, uses div_rounded_reference() of built-in policies.
+template<int FromPrec, int ToPrec, class RoundPolicy>
+std::size_t rescale_unbiased_reference(const int64 *input, int64 *output, std::size_t count,
+                                       bool *overflow = NULL) {
+    return details::rescale_kernel<FromPrec, ToPrec, RoundPolicy>::reference(input, output, count, overflow);
+}
+
+/// Converts array of decimals to different precision, see rescale_unbiased().
+template<int FromPrec, int ToPrec, class RoundPolicy>
+std::size_t rescale(const decimal<FromPrec, RoundPolicy> *input, decimal<ToPrec, RoundPolicy> *output,
+                    std::size_t count, bool *overflow = NULL) {
+    return details::rescale_kernel<FromPrec, ToPrec, RoundPolicy>::run(input, output, count, overflow);
+}
+
+/// Version of rescale_unbiased() with rounding policy selected at runtime.
+/// Policy is resolved once per call, the loop is the same as for template policy.
+template<int FromPrec, int ToPrec>
+std::size_t rescale_unbiased(const int64 *input, int64 *output, std::size_t count, runtime_round_policy policy,
+                             bool *overflow = NULL) {
+    const details::rescale_visitor<FromPrec, ToPrec, int64, int64> visitor(input, output, count, overflow);
+    return visit_round_policy(policy, visitor);
+}
+
+/// Version of rescale() with rounding policy selected at runtime,
+/// RoundPolicy of decimal type is not used.
+template<int FromPrec, int ToPrec, class RoundPolicy>
+std::size_t rescale(const decimal<FromPrec, RoundPolicy> *input, decimal<ToPrec, RoundPolicy> *output,
+                    std::size_t count, runtime_round_policy policy, bool *overflow = NULL) {
+    const details::rescale_visitor<FromPrec, ToPrec, decimal<FromPrec, RoundPolicy>,
+            decimal<ToPrec, RoundPolicy> > visitor(input, output, count, overflow);
+    return visit_round_policy(policy, visitor);
+}
+
+template<int FromPrec, int ToPrec, class RoundPolicy>
+std::size_t rescale_reference(const decimal<FromPrec, RoundPolicy> *input, decimal<ToPrec, RoundPolicy> *output,
+                              std::size_t count, bool *overflow = NULL) {
+    return details::rescale_kernel<FromPrec, ToPrec, RoundPolicy>::reference(input, output, count, overflow);
+}
+
+/// Word of selection bitmap, bit i % 64 of word i / 64 describes element i
+typedef details::uint64 bitmap_word;
+
+/// Number of words in bitmap for count elements
+inline std::size_t bitmap_words(std::size_t count) {
+    return (count + 63) / 64;
+}
+
+/// Compares every element with constant (exactly, also for different precisions),
+/// bit i % 64 of bitmap[i / 64] is set if input[i] op constant is true.
+/// Constant is converted to precision of input once, elements are compared as raw
+/// integers without branches. Unused bits of the last word are cleared.
+/// \result Returns number of selected elements
+template<int Prec, class RoundPolicy, int Prec2, class RoundPolicy2>
+std::size_t compare(const decimal<Prec, RoundPolicy> *input, std::size_t count, compare_op op,
+                    const decimal<Prec2, RoundPolicy2> &constant, bitmap_word *bitmap) {
+    return details::compare_kernel(input, count, details::make_predicate<Prec, Prec2>(op, constant.getUnbiased()),
+                                   bitmap);
+}
+
+/// Selects elements in range [low, high], see compare().
+template<int Prec, class RoundPolicy, int Prec2, class RoundPolicy2>
+std::size_t compare_between(const decimal<Prec, RoundPolicy> *input, std::size_t count,
+                            const decimal<Prec2, RoundPolicy2> &low, const decimal<Prec2, RoundPolicy2> &high,
+                            bitmap_word *bitmap) {
+    details::range_predicate predicate =
+            details::make_predicate<Prec, Prec2>(compare_greater_equal, low.getUnbiased());
+    const details::range_predicate upper =
+            details::make_predicate<Prec, Prec2>(compare_less_equal, high.getUnbiased());
+    if (!predicate.empty && !upper.empty) {
+        predicate.intersect(static_cast<int64>(upper.low), static_cast<int64>(upper.low + upper.width));
+    } else {
+        predicate.set(0, -1);
+    }
+    return details::compare_kernel(input, count, predicate, bitmap);
+}
+
+/// Writes indexes of elements for which input[i] op constant is true to rows
+/// (which must have space for count indexes), see compare().
+/// \result Returns number of written indexes
+template<int Prec, class RoundPolicy, int Prec2, class RoundPolicy2>
+std::size_t select(const decimal<Prec, RoundPolicy> *input, std::size_t count, compare_op op,
+                   const decimal<Prec2, RoundPolicy2> &constant, std::size_t *rows) {
+    return details::select_kernel(input, count, details::make_predicate<Prec, Prec2>(op, constant.getUnbiased()),
+                                  rows);
+}
+
+/// Scalar reference version of compare(), uses comparison operators of decimal
+/// (values of different precisions are compared exactly in the higher precision).
+template<int Prec, class RoundPolicy, int Prec2, class RoundPolicy2>
+std::size_t compare_reference(const decimal<Prec, RoundPolicy> *input, std::size_t count, compare_op op,
+                              const decimal<Prec2, RoundPolicy2> &constant, bitmap_word *bitmap) {
+    std::size_t selected = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i % 64 == 0) {
+            bitmap[i / 64] = 0;
+        }
+        if (details::compare_reference(input[i], op, constant)) {
+            bitmap[i / 64] |= static_cast<bitmap_word>(1) << (i % 64);
+            ++selected;
+        }
+    }
+    return selected;
+}
+
+template<int Prec, class RoundPolicy, int Prec2, class RoundPolicy2>
+std::size_t compare_between_reference(const decimal<Prec, RoundPolicy> *input, std::size_t count,
+                                      const decimal<Prec2, RoundPolicy2> &low,
+                                      const decimal<Prec2, RoundPolicy2> &high, bitmap_word *bitmap) {
+    std::size_t selected = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i % 64 == 0) {
+            bitmap[i / 64] = 0;
+        }
+        if (details::compare_reference(input[i], compare_greater_equal, low) &&
+            details::compare_reference(input[i], compare_less_equal, high)) {
+            bitmap[i / 64] |= static_cast<bitmap_word>(1) << (i % 64);
+            ++selected;
+        }
+    }
+    return selected;
+}
+
+template<int Prec, class RoundPolicy, int Prec2, class RoundPolicy2>
+std::size_t select_reference(const decimal<Prec, RoundPolicy> *input, std::size_t count, compare_op op,
+                             const decimal<Prec2, RoundPolicy2> &constant, std::size_t *rows) {
+    std::size_t selected = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (details::compare_reference(input[i], op, constant)) {
+            rows[selected++] = i;
+        }
+    }
+    return selected;
+}
+
+/// output = lhs & rhs, output can be the same as lhs or rhs
+inline void bitmap_and(const bitmap_word *lhs, const bitmap_word *rhs, bitmap_word *output, std::size_t words) {
+    for (std::size_t i = 0; i < words; ++i) {
+        output[i] = lhs[i] & rhs[i];
+    }
+}
+
+/// output = lhs | rhs, output can be the same as lhs or rhs
+inline void bitmap_or(const bitmap_word *lhs, const bitmap_word *rhs, bitmap_word *output, std::size_t words) {
+    for (std::size_t i = 0; i < words; ++i) {
+        output[i] = lhs[i] | rhs[i];
+    }
+}
+
+/// Writes indexes of set bits (in increasing order) to rows.
+/// \result Returns number of written indexes
+inline std::size_t bitmap_to_indexes(const bitmap_word *bitmap, std::size_t words, std::size_t *rows) {
+    std::size_t selected = 0;
+    for (std::size_t word = 0; word < words; ++word) {
+        for (bitmap_word bits = bitmap[word]; bits != 0; bits &= bits - 1) {
+            rows[selected++] = word * 64 + static_cast<std::size_t>(details::count_trailing_zeros(bits));
+        }
+    }
+    return selected;
+}
+
+/// Converts doubles to decimals, giving the same results as decimal::setAsDouble().
+/// Values which do not fit in decimal (also infinities and NaN) are set to 0 and bit
+/// i % 64 of optional outOfRange[i / 64] is set for them, unused bits of the last
+/// word are cleared. Rounding of built-in policies is done without branches.
+/// \result Returns number of values out of range
+template<int Prec, class RoundPolicy>
+std::size_t from_doubles(const double *input, decimal<Prec, RoundPolicy> *output, std::size_t count,
+                         bitmap_word *outOfRange = NULL) {
+    return details::from_doubles_kernel<Prec, RoundPolicy>(input, output, count, outOfRange);
+}
+
+/// Version of from_doubles() writing unbiased values in Prec precision.
+template<int Prec, class RoundPolicy>
+std::size_t from_doubles_unbiased(const double *input, int64 *output, std::size_t count,
+                                  bitmap_word *outOfRange = NULL) {
+    return details::from_doubles_kernel<Prec, RoundPolicy>(input, output, count, outOfRange);
+}
+
+/// Scalar reference version of from_doubles(), uses decimal::setAsDouble().
+template<int Prec, class RoundPolicy>
+std::size_t from_doubles_reference(const double *input, decimal<Prec, RoundPolicy> *output, std::size_t count,
+                                   bitmap_word *outOfRange = NULL) {
+    return details::from_doubles_reference<Prec, RoundPolicy>(input, output, count, outOfRange);
+}
+
+/// Converts decimals to doubles, giving the same results as decimal::getAsDouble().
+template<int Prec, class RoundPolicy>
+void to_doubles(const decimal<Prec, RoundPolicy> *input, double *output, std::size_t count) {
+    details::to_doubles_kernel<Prec>(input, output, count);
+}
+
+/// Version of to_doubles() reading unbiased values in Prec precision.
+template<int Prec>
+void to_doubles_unbiased(const int64 *input, double *output, std::size_t count) {
+    details::to_doubles_kernel<Prec>(input, output, count);
+}
+
+/// Scalar reference version of to_doubles(), uses decimal::getAsDouble().
+template<int Prec, class RoundPolicy>
+void to_doubles_reference(const decimal<Prec, RoundPolicy> *input, double *output, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        output[i] = input[i].getAsDouble();
+    }
+}
+
+} // namespace
+
+#endif // _DECIMAL_BULK_H__
@@ -0,0 +1,385 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_column.h
+// Purpose:     Compressed column of decimal values (frame of reference,
+//              bit packing and dictionary encoding).
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_COLUMN_H__
+#define _DECIMAL_COLUMN_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_column.h
+///
+/// Values are split into blocks of block_size values. Each block is stored as:
+///   - frame of reference: (value - min) / factor packed with minimal number of bits,
+///     where factor is GCD of differences (tick size for tick-aligned prices), or
+///   - dictionary: sorted distinct values and packed indexes,
+/// whichever is smaller. Block headers keep min and max, so scans can skip blocks
+/// and values can be accessed randomly.
+///
+/// Unpacking loops have fixed bit width per block and no data-dependent branches,
+/// so compiler can use vector instructions where available.
+///
+/// Sample usage:
+///   std::vector<dec::decimal<4> > prices = ...;
+///   dec::compressed_column<4> column(&prices[0], prices.size());
+///   dec::decimal<4> total = column.sum();
+///   std::vector<std::size_t> rows;
+///   column.filter_range(dec::decimal<4>("100"), dec::decimal<4>("101"), rows);
+
+#include "decimal.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace DEC_NAMESPACE {
+
+namespace details {
+
+    /// Mask for values with given number of bits (0-64)
+    inline uint64 bit_mask(int bits) {
+        return (bits >= 64) ? ~static_cast<uint64>(0) : ((static_cast<uint64>(1) << bits) - 1);
+    }
+
+    inline int bits_required(uint64 value) {
+        int result = 0;
+        while (value != 0) {
+            value >>= 1;
+            ++result;
+        }
+        return result;
+    }
+
+    /// Number of words used for count values of given width, including padding
+    /// which lets unpack() read two words without checking bounds.
+    inline std::size_t packed_words(std::size_t count, int bits) {
+        return count * static_cast<std::size_t>(bits) / 64 + 2;
+    }
+
+    /// Writes codes LSB-first, output must be zeroed and have packed_words() size
+    inline void pack_bits(const uint64 *codes, std::size_t count, int bits, uint64 *output) {
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t bit = i * static_cast<std::size_t>(bits);
+            const int shift = static_cast<int>(bit & 63);
+            output[bit >> 6] |= codes[i] << shift;
+            if (shift + bits > 64) {
+                output[(bit >> 6) + 1] |= codes[i] >> (64 - shift);
+            }
+        }
+    }
+
+    inline uint64 unpack(const uint64 *data, std::size_t index, int bits, uint64 mask) {
+        const std::size_t bit = index * static_cast<std::size_t>(bits);
+        const int shift = static_cast<int>(bit & 63);
+        const uint64 low = data[bit >> 6] >> shift;
+        // two shifts, so that shift == 0 gives 0
+        const uint64 high = (data[(bit >> 6) + 1] << 1) << (63 - shift);
+        return (low | high) & mask;
+    }
+
+} // namespace details
+
+/// Read-only compressed column of decimal values, see decimal_column.h
+template<int Prec, class RoundPolicy = def_round_policy>
+class compressed_column {
+    typedef details::uint64 uint64;
+
+public:
+    typedef decimal<Prec, RoundPolicy> value_type;
+
+    enum { block_size = 1024 };
+
+    compressed_column() : m_size(0) {
+    }
+
+    compressed_column(const value_type *values, std::size_t count) : m_size(0) {
+        assign(values, count);
+    }
+
+    /// Replaces content with count values
+    void assign(const value_type *values, std::size_t count) {
+        m_blocks.clear();
+        m_data.clear();
+        m_size = count;
+
+        std::vector<uint64> codes;
+        std::vector<int64> sorted;
+        for (std::size_t first = 0; first < count; first += block_size) {
+            const std::size_t left = count - first;
+            append_block(values + first, left < block_size ? left : static_cast<std::size_t>(block_size),
+                         codes, sorted);
+        }
+    }
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    std::size_t block_count() const {
+        return m_blocks.size();
+    }
+
+    /// Number of bytes used by compressed data and block headers
+    std::size_t memory_size() const {
+        return m_data.size() * sizeof(uint64) + m_blocks.size() * sizeof(block_header);
+    }
+
+    /// Returns true if block is stored as dictionary
+    bool is_dictionary(std::size_t block) const {
+        return m_blocks[block].dictionarySize > 0;
+    }
+
+    /// Random access, index must be lower than size()
+    value_type operator[](std::size_t index) const {
+        const block_header &header = m_blocks[index / block_size];
+        const uint64 code = details::unpack(packed(header), index % block_size, header.bits,
+                                            details::bit_mask(header.bits));
+        return make(decode(header, code));
+    }
+
+    /// Writes values of block to output (block_size values or less for the last block)
+    void decompress_block(std::size_t block, value_type *output) const {
+        const block_header &header = m_blocks[block];
+        const std::size_t count = block_length(block);
+        const uint64 *data = packed(header);
+        const uint64 mask = details::bit_mask(header.bits);
+        const int bits = header.bits;
+        if (header.dictionarySize > 0) {
+            const uint64 *dictionary = &m_data[header.offset];
+            for (std::size_t i = 0; i < count; ++i) {
+                output[i].setUnbiased(static_cast<int64>(dictionary[details::unpack(data, i, bits, mask)]));
+            }
+        } else {
+            const uint64 base = static_cast<uint64>(header.min);
+            const uint64 factor = header.factor;
+            for (std::size_t i = 0; i < count; ++i) {
+                output[i].setUnbiased(static_cast<int64>(base + details::unpack(data, i, bits, mask) * factor));
+            }
+        }
+    }
+
+    /// Writes all size() values to output
+    void decompress(value_type *output) const {
+        for (std::size_t block = 0; block < m_blocks.size(); ++block) {
+            decompress_block(block, output + block * block_size);
+        }
+    }
+
+    /// Sum of all values, calculated on codes.
+    /// Overflow wraps in the same way as for sum of int64 values.
+    value_type sum() const {
+        uint64 total = 0;
+        for (std::size_t block = 0; block < m_blocks.size(); ++block) {
+            const block_header &header = m_blocks[block];
+            const std::size_t count = block_length(block);
+            const uint64 *data = packed(header);
+            const uint64 mask = details::bit_mask(header.bits);
+            const int bits = header.bits;
+            if (header.dictionarySize > 0) {
+                const uint64 *dictionary = &m_data[header.offset];
+                for (std::size_t i = 0; i < count; ++i) {
+                    total += dictionary[details::unpack(data, i, bits, mask)];
+                }
+            } else {
+                uint64 codeSum = 0;
+                for (std::size_t i = 0; i < count; ++i) {
+                    codeSum += details::unpack(data, i, bits, mask);
+                }
+                total += static_cast<uint64>(header.min) * count + codeSum * header.factor;
+            }
+        }
+        return make(static_cast<int64>(total));
+    }
+
+    /// Minimal value, 0 for empty column
+    value_type min() const {
+        int64 result = m_blocks.empty() ? 0 : m_blocks[0].min;
+        for (std::size_t block = 1; block < m_blocks.size(); ++block) {
+            result = (m_blocks[block].min < result) ? m_blocks[block].min : result;
+        }
+        return make(result);
+    }
+
+    /// Maximal value, 0 for empty column
+    value_type max() const {
+        int64 result = m_blocks.empty() ? 0 : m_blocks[0].max;
+        for (std::size_t block = 1; block < m_blocks.size(); ++block) {
+            result = (m_blocks[block].max > result) ? m_blocks[block].max : result;
+        }
+        return make(result);
+    }
+
+    /// Appends indexes of values in range [low, high] to rows, in increasing order.
+    /// Blocks outside of the range are skipped using headers, other blocks are
+    /// compared on codes without decoding values.
+    /// \result Returns number of appended indexes
+    std::size_t filter_range(const value_type &low, const value_type &high, std::vector<std::size_t> &rows) const {
+        const std::size_t initialSize = rows.size();
+        const int64 lowValue = low.getUnbiased();
+        const int64 highValue = high.getUnbiased();
+        std::vector<std::size_t> found(block_size);
+
+        for (std::size_t block = 0; block < m_blocks.size(); ++block) {
+            const block_header &header = m_blocks[block];
+            if (lowValue > highValue || header.max < lowValue || header.min > highValue) {
+                continue;
+            }
+
+            uint64 lowCode, highCode;
+            code_range(header, lowValue, highValue, lowCode, highCode);
+            if (lowCode > highCode) {
+                continue;
+            }
+
+            // code in [lowCode, highCode], without branches
+            const std::size_t count = block_length(block);
+            const uint64 *data = packed(header);
+            const uint64 mask = details::bit_mask(header.bits);
+            const uint64 width = highCode - lowCode;
+            const std::size_t first = block * block_size;
+            std::size_t foundCount = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                found[foundCount] = first + i;
+                foundCount += (details::unpack(data, i, header.bits, mask) - lowCode <= width) ? 1 : 0;
+            }
+            rows.insert(rows.end(), found.begin(), found.begin() + static_cast<std::ptrdiff_t>(foundCount));
+        }
+        return rows.size() - initialSize;
+    }
+
+private:
+    struct block_header {
+        int64 min;
+        int64 max;
+        // frame of reference: value = min + code * factor
+        uint64 factor;
+        // dictionary values (if any) followed by packed codes
+        std::size_t offset;
+        // 0 - frame of reference
+        unsigned int dictionarySize;
+        int bits;
+    };
+
+    static value_type make(int64 unbiased) {
+        value_type result;
+        result.setUnbiased(unbiased);
+        return result;
+    }
+
+    std::size_t block_length(std::size_t block) const {
+        return (block + 1 < m_blocks.size()) ? static_cast<std::size_t>(block_size)
+                                             : m_size - block * block_size;
+    }
+
+    const uint64 *packed(const block_header &header) const {
+        return &m_data[header.offset + header.dictionarySize];
+    }
+
+    int64 decode(const block_header &header, uint64 code) const {
+        if (header.dictionarySize > 0) {
+            return static_cast<int64>(m_data[header.offset + code]);
+        }
+        return static_cast<int64>(static_cast<uint64>(header.min) + code * header.factor);
+    }
+
+    // range of codes for values in [low, high], which overlaps [min, max]
+    void code_range(const block_header &header, int64 low, int64 high, uint64 &lowCode, uint64 &highCode) const {
+        if (header.dictionarySize > 0) {
+            const int64 *dictionary = reinterpret_cast<const int64 *>(&m_data[header.offset]);
+            const int64 *dictionaryEnd = dictionary + header.dictionarySize;
+            lowCode = static_cast<uint64>(std::lower_bound(dictionary, dictionaryEnd, low) - dictionary);
+            highCode = static_cast<uint64>(std::upper_bound(dictionary, dictionaryEnd, high) - dictionary);
+            if (highCode == 0) {
+                lowCode = 1;
+            } else {
+                --highCode;
+            }
+            return;
+        }
+
+        const uint64 base = static_cast<uint64>(header.min);
+        if (low <= header.min) {
+            lowCode = 0;
+        } else {
+            // rounded up
+            const uint64 difference = static_cast<uint64>(low) - base;
+            lowCode = difference / header.factor + ((difference % header.factor != 0) ? 1 : 0);
+        }
+        if (high >= header.max) {
+            highCode = (static_cast<uint64>(header.max) - base) / header.factor;
+        } else {
+            highCode = (static_cast<uint64>(high) - base) / header.factor;
+        }
+    }
+
+    void append_block(const value_type *values, std::size_t count, std::vector<uint64> &codes,
+                      std::vector<int64> &sorted) {
+        block_header header;
+        header.min = values[0].getUnbiased();
+        header.max = header.min;
+        for (std::size_t i = 1; i < count; ++i) {
+            const int64 value = values[i].getUnbiased();
+            header.min = (value < header.min) ? value : header.min;
+            header.max = (value > header.max) ? value : header.max;
+        }
+
+        const uint64 base = static_cast<uint64>(header.min);
+        uint64 factor = 0;
+        for (std::size_t i = 0; i < count && factor != 1; ++i) {
+            factor = details::gcd_unsigned(static_cast<uint64>(values[i].getUnbiased()) - base, factor);
+        }
+        header.factor = (factor == 0) ? 1 : factor;
+        const int frameBits = details::bits_required((static_cast<uint64>(header.max) - base) / header.factor);
+
+        sorted.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            sorted[i] = values[i].getUnbiased();
+        }
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        const int dictionaryBits = details::bits_required(sorted.size() - 1);
+
+        codes.resize(count);
+        header.offset = m_data.size();
+        // sizes in bits
+        if (sorted.size() * 64 + count * static_cast<std::size_t>(dictionaryBits) <
+            count * static_cast<std::size_t>(frameBits)) {
+            header.dictionarySize = static_cast<unsigned int>(sorted.size());
+            header.bits = dictionaryBits;
+            for (std::size_t i = 0; i < count; ++i) {
+                codes[i] = static_cast<uint64>(std::lower_bound(sorted.begin(), sorted.end(),
+                                                                values[i].getUnbiased()) - sorted.begin());
+            }
+            for (std::size_t i = 0; i < sorted.size(); ++i) {
+                m_data.push_back(static_cast<uint64>(sorted[i]));
+            }
+        } else {
+            header.dictionarySize = 0;
+            header.bits = frameBits;
+            for (std::size_t i = 0; i < count; ++i) {
+                codes[i] = (static_cast<uint64>(values[i].getUnbiased()) - base) / header.factor;
+            }
+        }
+
+        const std::size_t packedOffset = m_data.size();
+        m_data.resize(packedOffset + details::packed_words(count, header.bits), 0);
+        details::pack_bits(&codes[0], count, header.bits, &m_data[packedOffset]);
+        m_blocks.push_back(header);
+    }
+
+    std::vector<block_header> m_blocks;
+    std::vector<uint64> m_data;
+    std::size_t m_size;
+};
+
+} // namespace
+
+#endif // _DECIMAL_COLUMN_H__
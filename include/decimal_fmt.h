@@ -0,0 +1,311 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_fmt.h
+// Purpose:     Formatter specializations for std::format and {fmt}
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_FMT_H__
+#define _DECIMAL_FMT_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_fmt.h
+///
+/// Specializations of std::formatter (when <format> is available) and
+/// fmt::formatter (when {fmt} was included before this header or DEC_USE_FMT
+/// is defined) for decimal types. Values are written directly to output iterator.
+///
+/// Format specification:
+///   [[fill]align][sign][0][width][,][.precision][L][e]
+/// where
+///   align      '<', '>' (default) or '^'
+///   sign       '-' (default), '+' or ' '
+///   0          pad with zeros after sign (when align is not given)
+///   ,          group thousands with ',' (decimal point is '.')
+///   precision  number of decimal digits displayed, value is rounded using
+///              rounding policy of decimal type when precision is lower than type's one
+///   L          use decimal point, thousands separator and grouping of locale
+///   e          scientific notation, e.g. "1.25e-3" (grouping is not used)
+///
+/// Sample usage:
+///   std::string s = fmt::format("{:>12,.2}", dec::decimal<4>("12345.6789"));
+///   // s == "   12,345.68"
+
+#include "decimal.h"
+
+#include <locale>
+
+#if !defined(DEC_USE_FMT) && defined(FMT_VERSION)
+#define DEC_USE_FMT
+#endif
+
+#ifdef DEC_USE_FMT
+#include <fmt/format.h>
+#endif
+
+#if defined(__has_include) && (__cplusplus >= 202002L)
+#if __has_include(<format>)
+#include <format>
+#endif
+#endif
+
+#if __cplusplus >= 201402L
+#define DEC_CONSTEXPR14 constexpr
+#else
+#define DEC_CONSTEXPR14
+#endif
+
+namespace DEC_NAMESPACE {
+
+namespace details {
+
+    /// Parsed format specification, see description of decimal_fmt.h
+    struct fmt_spec {
+        char fill;
+        char align;
+        char sign;
+        bool zero;
+        bool grouping;
+        bool locale;
+        bool exponent;
+        int width;
+        // -1 - precision of decimal type
+        int precision;
+
+        DEC_CONSTEXPR14 fmt_spec() : fill(' '), align('\0'), sign('-'), zero(false), grouping(false),
+                                     locale(false), exponent(false), width(0), precision(-1) {
+        }
+    };
+
+    template<typename Iterator>
+    DEC_CONSTEXPR14 bool fmt_parse_int(Iterator &pos, Iterator end, int &output) {
+        if (pos == end || *pos < '0' || *pos > '9') {
+            return false;
+        }
+        int value = 0;
+        while (pos != end && *pos >= '0' && *pos <= '9') {
+            value = value * 10 + (*pos - '0');
+            if (value > 1000000) {
+                return false;
+            }
+            ++pos;
+        }
+        output = value;
+        return true;
+    }
+
+    DEC_CONSTEXPR14 inline bool fmt_is_align(char c) {
+        return c == '<' || c == '>' || c == '^';
+    }
+
+    /// Parses specification up to closing '}' or end.
+    /// \result Returns false on syntax error, pos points to the first unparsed char
+    template<typename Iterator>
+    DEC_CONSTEXPR14 bool fmt_parse_spec(Iterator &pos, Iterator end, fmt_spec &spec) {
+        if (pos == end || *pos == '}') {
+            return true;
+        }
+
+        // [[fill]align]
+        Iterator next = pos;
+        ++next;
+        if (next != end && fmt_is_align(static_cast<char>(*next)) && *pos != '{' && *pos != '}') {
+            spec.fill = static_cast<char>(*pos);
+            spec.align = static_cast<char>(*next);
+            pos = ++next;
+        } else if (fmt_is_align(static_cast<char>(*pos))) {
+            spec.align = static_cast<char>(*pos);
+            ++pos;
+        }
+
+        if (pos != end && (*pos == '+' || *pos == '-' || *pos == ' ')) {
+            spec.sign = static_cast<char>(*pos);
+            ++pos;
+        }
+
+        if (pos != end && *pos == '0') {
+            spec.zero = true;
+            ++pos;
+        }
+
+        if (pos != end && *pos >= '1' && *pos <= '9' && !fmt_parse_int(pos, end, spec.width)) {
+            return false;
+        }
+
+        if (pos != end && *pos == ',') {
+            spec.grouping = true;
+            ++pos;
+        }
+
+        if (pos != end && *pos == '.') {
+            ++pos;
+            if (!fmt_parse_int(pos, end, spec.precision)) {
+                return false;
+            }
+        }
+
+        if (pos != end && *pos == 'L') {
+            spec.locale = true;
+            ++pos;
+        }
+
+        if (pos != end && *pos == 'e') {
+            spec.exponent = true;
+            ++pos;
+        }
+
+        return pos == end || *pos == '}';
+    }
+
+    template<typename OutputIt>
+    OutputIt fmt_fill(OutputIt out, char fill, int count) {
+        for (int i = 0; i < count; ++i) {
+            *out++ = fill;
+        }
+        return out;
+    }
+
+    /// Writes value formatted according to spec, separators are taken from formatter.
+    template<typename OutputIt, int Prec, class RoundPolicy>
+    OutputIt fmt_write(OutputIt out, const decimal<Prec, RoundPolicy> &value, const fmt_spec &spec,
+                       const decimal_formatter &formatter) {
+        int64 unbiased = value.getUnbiased();
+        int precision = Prec;
+        int extraZeros = 0;
+        if (spec.precision >= 0 && spec.precision < Prec) {
+            unbiased = dec_utils<RoundPolicy>::multDiv(unbiased, 1,
+                    dec_utils<RoundPolicy>::pow10(Prec - spec.precision));
+            precision = spec.precision;
+        } else if (spec.precision > Prec && !spec.exponent) {
+            extraZeros = spec.precision - Prec;
+        }
+
+        const bool negative = unbiased < 0;
+        const uint64 absValue = negative ? (0 - static_cast<uint64>(unbiased)) : static_cast<uint64>(unbiased);
+        const uint64 factor = static_cast<uint64>(dec_utils<RoundPolicy>::pow10(precision));
+
+        char buffer[decimal_formatter::max_chars];
+        const char *begin = buffer;
+        const char *end;
+        if (spec.exponent) {
+            end = formatter.format_exponent_unbiased(unbiased, precision, buffer);
+            // sign is written below
+            begin += negative ? 1 : 0;
+        } else {
+            end = formatter.format_unpacked(false, absValue / factor, absValue % factor, precision, buffer);
+        }
+
+        const char signChar = negative ? '-' : (spec.sign == '+' ? '+' : (spec.sign == ' ' ? ' ' : '\0'));
+        const bool addPoint = (extraZeros > 0 && precision == 0);
+        const int length = static_cast<int>(end - begin) + (signChar != '\0' ? 1 : 0) + (addPoint ? 1 : 0) +
+                           extraZeros;
+        const int padding = spec.width > length ? spec.width - length : 0;
+
+        int before = 0, after = 0, zeros = 0;
+        if (spec.align == '<') {
+            after = padding;
+        } else if (spec.align == '^') {
+            before = padding / 2;
+            after = padding - before;
+        } else if (spec.align == '\0' && spec.zero) {
+            zeros = padding;
+        } else {
+            before = padding;
+        }
+
+        out = fmt_fill(out, spec.fill, before);
+        if (signChar != '\0') {
+            *out++ = signChar;
+        }
+        out = fmt_fill(out, '0', zeros);
+        for (const char *pos = begin; pos != end; ++pos) {
+            *out++ = *pos;
+        }
+        if (addPoint) {
+            *out++ = formatter.decimal_point();
+        }
+        out = fmt_fill(out, '0', extraZeros);
+        return fmt_fill(out, spec.fill, after);
+    }
+
+    /// Returns formatter for spec without locale flag
+    inline decimal_formatter fmt_formatter(const fmt_spec &spec) {
+        return spec.grouping ? decimal_formatter(make_format_spec('.', ',')) : decimal_formatter();
+    }
+
+    /// Returns formatter for spec with locale flag, ',' flag forces grouping by 3 digits
+    inline decimal_formatter fmt_formatter(const fmt_spec &spec, const std::locale &locale) {
+        const decimal_formatter localeFormatter(locale);
+        if (spec.grouping && !localeFormatter.thousands_grouping()) {
+            return decimal_formatter(make_format_spec(localeFormatter.decimal_point(), localeFormatter.thousands_sep()));
+        }
+        return localeFormatter;
+    }
+
+} // namespace details
+
+} // namespace
+
+#ifdef DEC_USE_FMT
+namespace fmt {
+
+template<int Prec, class RoundPolicy>
+struct formatter<DEC_NAMESPACE::decimal<Prec, RoundPolicy>, char> {
+    DEC_NAMESPACE::details::fmt_spec m_spec;
+
+    template<typename ParseContext>
+    DEC_CONSTEXPR14 typename ParseContext::iterator parse(ParseContext &ctx) {
+        typename ParseContext::iterator pos = ctx.begin();
+        if (!DEC_NAMESPACE::details::fmt_parse_spec(pos, ctx.end(), m_spec)) {
+            throw fmt::format_error("invalid format specification for decimal");
+        }
+        return pos;
+    }
+
+    template<typename FormatContext>
+    typename FormatContext::iterator format(const DEC_NAMESPACE::decimal<Prec, RoundPolicy> &value,
+                                            FormatContext &ctx) const {
+        if (m_spec.locale) {
+            return DEC_NAMESPACE::details::fmt_write(ctx.out(), value, m_spec,
+                    DEC_NAMESPACE::details::fmt_formatter(m_spec, ctx.locale().template get<std::locale>()));
+        }
+        return DEC_NAMESPACE::details::fmt_write(ctx.out(), value, m_spec,
+                DEC_NAMESPACE::details::fmt_formatter(m_spec));
+    }
+};
+
+} // namespace fmt
+#endif // DEC_USE_FMT
+
+#ifdef __cpp_lib_format
+namespace std {
+
+template<int Prec, class RoundPolicy>
+struct formatter<DEC_NAMESPACE::decimal<Prec, RoundPolicy>, char> {
+    DEC_NAMESPACE::details::fmt_spec m_spec;
+
+    constexpr std::format_parse_context::iterator parse(std::format_parse_context &ctx) {
+        std::format_parse_context::iterator pos = ctx.begin();
+        if (!DEC_NAMESPACE::details::fmt_parse_spec(pos, ctx.end(), m_spec)) {
+            throw std::format_error("invalid format specification for decimal");
+        }
+        return pos;
+    }
+
+    template<typename FormatContext>
+    typename FormatContext::iterator format(const DEC_NAMESPACE::decimal<Prec, RoundPolicy> &value,
+                                            FormatContext &ctx) const {
+        if (m_spec.locale) {
+            return DEC_NAMESPACE::details::fmt_write(ctx.out(), value, m_spec,
+                    DEC_NAMESPACE::details::fmt_formatter(m_spec, ctx.locale()));
+        }
+        return DEC_NAMESPACE::details::fmt_write(ctx.out(), value, m_spec,
+                DEC_NAMESPACE::details::fmt_formatter(m_spec));
+    }
+};
+
+} // namespace std
+#endif // __cpp_lib_format
+
+#endif // _DECIMAL_FMT_H__
@@ -0,0 +1,54 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_fwd.h
+// Purpose:     Forward declarations of decimal types.
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_FWD_H__
+#define _DECIMAL_FWD_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_fwd.h
+///
+/// Declares decimal template, rounding policies and predefined types without
+/// including decimal.h and standard stream headers. Enough for headers which
+/// only pass decimals by reference or pointer; can be included before or
+/// after decimal.h.
+///
+/// Sample usage:
+///   #include "decimal_fwd.h"
+///
+///   struct order;
+///   void set_price(order &target, const dec::decimal<4> &price);
+
+#ifndef DEC_NAMESPACE
+#define DEC_NAMESPACE dec
+#endif // DEC_NAMESPACE
+
+namespace DEC_NAMESPACE {
+
+class null_round_policy;
+class def_round_policy;
+class half_down_round_policy;
+class half_up_round_policy;
+class half_even_round_policy;
+class ceiling_round_policy;
+class floor_round_policy;
+class round_down_round_policy;
+class round_up_round_policy;
+
+// default argument can be given only once, decimal.h declares it otherwise
+#ifndef _DECIMAL_H__
+template<int Prec, class RoundPolicy = def_round_policy>
+class decimal;
+#endif
+
+typedef decimal<2> decimal2;
+typedef decimal<4> decimal4;
+typedef decimal<6> decimal6;
+
+} // namespace
+
+#endif // _DECIMAL_FWD_H__
@@ -0,0 +1,361 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_fx.h
+// Purpose:     Table of currency rates with cached cross rates and exact
+//              conversion of amounts between any two currencies.
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_FX_H__
+#define _DECIMAL_FX_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_fx.h
+///
+/// Rates are given against one pivot currency (units of currency for one unit
+/// of pivot). publish() calculates cross rates of all pairs as reduced ratios
+/// rate[to] / rate[from], so conversion is exact triangulation: one wide
+/// multiplication and one division rounded by policy of the result type,
+/// instead of rounding after every decimal_cast and operator*.
+///
+/// Readers never wait: they use the snapshot of rates current when they
+/// started (RCU-style). publish() replaces the snapshot and reuses memory of
+/// the previous one after all readers which could see it have finished.
+///
+/// Sample usage:
+///   enum { USD, EUR, JPY };
+///   dec::fx_rate_table<8> rates(3, USD);
+///   rates.set_rate(EUR, dec::decimal<8>("0.92"));
+///   rates.set_rate(JPY, dec::decimal<8>("151.2345"));
+///   rates.publish();
+///   dec::decimal<0> yen;
+///   if (rates.convert(dec::decimal<2>("1234.56"), EUR, JPY, yen)) ...
+///
+/// Readers and writers are synchronized only in C++11 mode, with DEC_NO_CPP11
+/// the table can be used by one thread.
+
+#include "decimal.h"
+
+#include <cstddef>
+#include <vector>
+
+#ifndef DEC_NO_CPP11
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace DEC_NAMESPACE {
+
+namespace details {
+
+    /// Calculates output = round(value * numerator * 10^shift / denominator),
+    /// numerator and denominator must be positive, shift must be in [-38, 38].
+    template<class RoundPolicy>
+    bool mul_ratio_rounded(int64 &output, int64 value, int64 numerator, int64 denominator, int shift) {
+        const bool negative = value < 0;
+        const uint128 product = uint128::mul(abs_unsigned(value), static_cast<uint64>(numerator));
+        if (shift == 0) {
+            const uint128 divisor(static_cast<uint64>(denominator));
+            uint128 quot, rem;
+            uint128::divmod(product, divisor, quot, rem);
+            return round_sticky<RoundPolicy>(output, negative, quot, fraction_class(rem, divisor));
+        }
+
+        // product < 2^126, so scaled values fit in 256 bits
+        uint256 dividend(product);
+        uint256 divisor(uint128(static_cast<uint64>(denominator)));
+        if (shift > 0) {
+            uint256::mul(dividend, pow10_wide(shift), dividend);
+        } else {
+            uint256::mul(divisor, pow10_wide(-shift), divisor);
+        }
+        if (dividend.bitLength() <= 128 && divisor.bitLength() <= 128) {
+            const uint128 narrowDivisor = divisor.shiftedRight(0);
+            uint128 quot, rem;
+            uint128::divmod(dividend.shiftedRight(0), narrowDivisor, quot, rem);
+            return round_sticky<RoundPolicy>(output, negative, quot, fraction_class(rem, narrowDivisor));
+        }
+
+        uint256 quot, rem;
+        uint256::divmod(dividend, divisor, quot, rem);
+        if (quot.bitLength() > 64) {
+            return false;
+        }
+        const uint256 rest = divisor - rem;
+        const int fractionClass = rem.isZero() ? 0 : ((rem < rest) ? 1 : ((rem == rest) ? 2 : 3));
+        return round_sticky<RoundPolicy>(output, negative, quot.shiftedRight(0), fractionClass);
+    }
+
+} // namespace details
+
+/// Currency rates against pivot currency with cross rates of all pairs, see decimal_fx.h
+template<int RatePrec, class RoundPolicy = def_round_policy>
+class fx_rate_table {
+    // to = amount * numerator / denominator, denominator is 0 if any rate is missing
+    struct cross_rate {
+        int64 numerator;
+        int64 denominator;
+    };
+
+    struct snapshot {
+        unsigned long long version;
+        std::vector<cross_rate> crosses;
+    };
+
+public:
+    typedef decimal<RatePrec, RoundPolicy> rate_type;
+    typedef std::size_t currency;
+
+    /// Currencies are numbered from 0 to currencyCount - 1, pivot has rate 1
+    explicit fx_rate_table(std::size_t currencyCount, currency pivot = 0)
+        : m_rates(currencyCount, 0), m_pivot(pivot), m_spare(NULL) {
+#ifndef DEC_NO_CPP11
+        m_phase.store(0);
+        m_readers[0].store(0);
+        m_readers[1].store(0);
+#endif
+        if (pivot < currencyCount) {
+            m_rates[pivot] = rate_type(1).getUnbiased();
+        }
+        snapshot *initial = new snapshot();
+        initial->version = 0;
+        fill(*initial);
+        store_current(initial);
+    }
+
+    /// Readers must be finished before table is destroyed
+    ~fx_rate_table() {
+        delete load_current();
+        delete m_spare;
+    }
+
+    std::size_t currency_count() const {
+        return m_rates.size();
+    }
+
+    currency pivot() const {
+        return m_pivot;
+    }
+
+    /// Sets number of units of target currency for one unit of pivot currency.
+    /// New rate is used by readers after publish().
+    /// \result Returns false if currency is out of range, is pivot or rate is not positive
+    bool set_rate(currency target, const rate_type &rate) {
+        if (target >= m_rates.size() || target == m_pivot || rate.getUnbiased() <= 0) {
+            return false;
+        }
+        writer_lock lock(*this);
+        m_rates[target] = rate.getUnbiased();
+        return true;
+    }
+
+    /// Removes rate of currency, conversions from and to it fail after publish()
+    bool clear_rate(currency target) {
+        if (target >= m_rates.size() || target == m_pivot) {
+            return false;
+        }
+        writer_lock lock(*this);
+        m_rates[target] = 0;
+        return true;
+    }
+
+    /// Makes rates given by set_rate() and clear_rate() visible to readers.
+    /// Waits until all readers which use the previous snapshot have finished.
+    void publish() {
+        writer_lock lock(*this);
+        snapshot *next = (m_spare != NULL) ? m_spare : new snapshot();
+        m_spare = NULL;
+        snapshot *previous = load_current();
+        next->version = previous->version + 1;
+        fill(*next);
+        store_current(next);
+        wait_for_readers();
+        m_spare = previous;
+    }
+
+    /// Consistent view of rates for a series of conversions. Publishing waits
+    /// for readers, so reader should be short-lived and must not be kept by
+    /// thread which calls publish().
+    class reader {
+    public:
+        explicit reader(const fx_rate_table &table) : m_table(table) {
+#ifndef DEC_NO_CPP11
+            m_phase = table.m_phase.load() & 1;
+            table.m_readers[m_phase].fetch_add(1);
+#endif
+            m_snapshot = table.load_current();
+        }
+
+        ~reader() {
+#ifndef DEC_NO_CPP11
+            m_table.m_readers[m_phase].fetch_sub(1);
+#endif
+        }
+
+        /// Number of publish() calls which created rates used by reader
+        unsigned long long version() const {
+            return m_snapshot->version;
+        }
+
+        /// Converts amount from one currency to another, rounding once using
+        /// policy of output type.
+        /// \result Returns false if currency is out of range, has no rate
+        ///         or result does not fit in output
+        template<int Prec, class AmountRoundPolicy, int ResultPrec, class ResultRoundPolicy>
+        bool convert(const decimal<Prec, AmountRoundPolicy> &amount, currency from, currency to,
+                     decimal<ResultPrec, ResultRoundPolicy> &output) const {
+            const cross_rate *rate = find(from, to);
+            int64 result;
+            if (rate == NULL || !details::mul_ratio_rounded<ResultRoundPolicy>(
+                    result, amount.getUnbiased(), rate->numerator, rate->denominator, ResultPrec - Prec)) {
+                return false;
+            }
+            output.setUnbiased(result);
+            return true;
+        }
+
+        /// Calculates number of units of to for one unit of from, rounded to output precision
+        /// \result Returns false if currency is out of range, has no rate or rate does not fit in output
+        template<int ResultPrec, class ResultRoundPolicy>
+        bool cross(currency from, currency to, decimal<ResultPrec, ResultRoundPolicy> &output) const {
+            const cross_rate *rate = find(from, to);
+            int64 result;
+            if (rate == NULL || !details::mul_ratio_rounded<ResultRoundPolicy>(
+                    result, 1, rate->numerator, rate->denominator, ResultPrec)) {
+                return false;
+            }
+            output.setUnbiased(result);
+            return true;
+        }
+
+    private:
+        reader(const reader &);
+        reader &operator=(const reader &);
+
+        const cross_rate *find(currency from, currency to) const {
+            const std::size_t count = m_table.m_rates.size();
+            if (from >= count || to >= count) {
+                return NULL;
+            }
+            const cross_rate *result = &m_snapshot->crosses[from * count + to];
+            return (result->denominator != 0) ? result : NULL;
+        }
+
+        const fx_rate_table &m_table;
+        const snapshot *m_snapshot;
+#ifndef DEC_NO_CPP11
+        unsigned m_phase;
+#endif
+    };
+
+    /// See reader::convert(), uses current rates
+    template<int Prec, class AmountRoundPolicy, int ResultPrec, class ResultRoundPolicy>
+    bool convert(const decimal<Prec, AmountRoundPolicy> &amount, currency from, currency to,
+                 decimal<ResultPrec, ResultRoundPolicy> &output) const {
+        const reader view(*this);
+        return view.convert(amount, from, to, output);
+    }
+
+    /// See reader::cross(), uses current rates
+    template<int ResultPrec, class ResultRoundPolicy>
+    bool cross(currency from, currency to, decimal<ResultPrec, ResultRoundPolicy> &output) const {
+        const reader view(*this);
+        return view.cross(from, to, output);
+    }
+
+    /// Number of publish() calls
+    unsigned long long version() const {
+        const reader view(*this);
+        return view.version();
+    }
+
+private:
+#ifndef DEC_NO_CPP11
+    typedef std::lock_guard<std::mutex> writer_guard;
+
+    struct writer_lock : public writer_guard {
+        explicit writer_lock(fx_rate_table &table) : writer_guard(table.m_writerMutex) {
+        }
+    };
+
+    snapshot *load_current() const {
+        return m_current.load();
+    }
+
+    void store_current(snapshot *value) {
+        m_current.store(value);
+    }
+
+    // Two phase changes: readers which started before the first one are counted in
+    // the old phase, readers which started between them could still load previous
+    // snapshot, so both phases have to drain.
+    void wait_for_readers() {
+        for (int i = 0; i < 2; ++i) {
+            const unsigned oldPhase = m_phase.fetch_add(1) & 1;
+            while (m_readers[oldPhase].load() != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+#else
+    struct writer_lock {
+        explicit writer_lock(fx_rate_table &) {
+        }
+    };
+
+    snapshot *load_current() const {
+        return m_current;
+    }
+
+    void store_current(snapshot *value) {
+        m_current = value;
+    }
+
+    void wait_for_readers() {
+    }
+#endif
+
+    fx_rate_table(const fx_rate_table &);
+    fx_rate_table &operator=(const fx_rate_table &);
+
+    void fill(snapshot &target) const {
+        const std::size_t count = m_rates.size();
+        target.crosses.resize(count * count);
+        for (std::size_t from = 0; from < count; ++from) {
+            for (std::size_t to = 0; to < count; ++to) {
+                cross_rate &cross = target.crosses[from * count + to];
+                const int64 numerator = m_rates[to];
+                const int64 denominator = m_rates[from];
+                if (numerator == 0 || denominator == 0) {
+                    cross.numerator = 0;
+                    cross.denominator = 0;
+                    continue;
+                }
+                // smaller factors keep conversion in 128 bits
+                const int64 divisor = static_cast<int64>(details::gcd_unsigned(static_cast<details::uint64>(numerator),
+                                                                               static_cast<details::uint64>(denominator)));
+                cross.numerator = numerator / divisor;
+                cross.denominator = denominator / divisor;
+            }
+        }
+    }
+
+    // pending rates (unbiased), 0 - missing
+    std::vector<int64> m_rates;
+    currency m_pivot;
+    snapshot *m_spare;
+#ifndef DEC_NO_CPP11
+    std::atomic<snapshot *> m_current;
+    std::atomic<unsigned> m_phase;
+    mutable std::atomic<std::size_t> m_readers[2];
+    std::mutex m_writerMutex;
+#else
+    snapshot *m_current;
+#endif
+};
+
+} // namespace
+
+#endif // _DECIMAL_FX_H__
@@ -0,0 +1,293 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_json.h
+// Purpose:     Reading and writing decimal values as JSON numbers,
+//              adapter for SAX-style JSON parsers.
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_JSON_H__
+#define _DECIMAL_JSON_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_json.h
+///
+/// Numbers are read straight from JSON text (no std::string, stream or double),
+/// with exponent and rounding using policy of output type. Numbers given as
+/// JSON strings (e.g. "4.00000000") are accepted as well.
+///
+/// Sample usage:
+///   dec::decimal<8> price;
+///   const char *next = dec::read_json(pos, end, price);
+///   if (next == NULL) ... // not a number
+///
+///   char buffer[dec::max_json_chars];
+///   char *bufferEnd = dec::write_json(price, buffer); // "4.5"
+
+#include "decimal.h"
+
+#include <cstddef>
+#include <string>
+
+namespace DEC_NAMESPACE {
+
+/// Size of buffer required by write_json()
+enum { max_json_chars = decimal_formatter::max_chars + 2 };
+
+namespace details {
+
+    /// Number scanned from JSON text: (-1)^negative * (mantissa + tail) * 10^exponent,
+    /// where tail < 1 is not stored, sticky tells if it is non-zero.
+    struct json_number {
+        uint64 mantissa;
+        int exponent;
+        bool negative;
+        bool sticky;
+    };
+
+    inline bool json_is_digit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    /// Scans JSON number token: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    /// At least 19 significant digits are stored exactly.
+    /// \result Returns pointer past the token or NULL if there is no valid number at pos
+    inline const char *json_scan_number(const char *pos, const char *end, json_number &number) {
+        // mantissa * 10 + 9 fits in uint64
+        const uint64 limit = (~static_cast<uint64>(0) - 9) / 10;
+        const int maxExponent = 100000;
+
+        number.mantissa = 0;
+        number.exponent = 0;
+        number.negative = false;
+        number.sticky = false;
+
+        if (pos != end && *pos == '-') {
+            number.negative = true;
+            ++pos;
+        }
+
+        if (pos == end || !json_is_digit(*pos)) {
+            return NULL;
+        }
+
+        if (*pos == '0') {
+            ++pos;
+        } else {
+            for (; pos != end && json_is_digit(*pos); ++pos) {
+                if (number.mantissa <= limit) {
+                    number.mantissa = number.mantissa * 10 + static_cast<uint64>(*pos - '0');
+                } else {
+                    ++number.exponent;
+                    number.sticky = number.sticky || (*pos != '0');
+                }
+            }
+        }
+
+        if (pos != end && *pos == '.') {
+            ++pos;
+            if (pos == end || !json_is_digit(*pos)) {
+                return NULL;
+            }
+            for (; pos != end && json_is_digit(*pos); ++pos) {
+                if (number.mantissa <= limit) {
+                    number.mantissa = number.mantissa * 10 + static_cast<uint64>(*pos - '0');
+                    --number.exponent;
+                } else {
+                    number.sticky = number.sticky || (*pos != '0');
+                }
+            }
+        }
+
+        if (pos != end && (*pos == 'e' || *pos == 'E')) {
+            ++pos;
+            bool negativeExponent = false;
+            if (pos != end && (*pos == '+' || *pos == '-')) {
+                negativeExponent = (*pos == '-');
+                ++pos;
+            }
+            if (pos == end || !json_is_digit(*pos)) {
+                return NULL;
+            }
+            int exponent = 0;
+            for (; pos != end && json_is_digit(*pos); ++pos) {
+                if (exponent < maxExponent) {
+                    exponent = exponent * 10 + (*pos - '0');
+                }
+            }
+            number.exponent += negativeExponent ? -exponent : exponent;
+        }
+
+        return pos;
+    }
+
+    /// Converts scanned number to unbiased value with given precision.
+    /// \result Returns false if value does not fit in int64
+    template<class RoundPolicy>
+    bool json_pack(int64 &output, const json_number &number, int precision) {
+        if (number.mantissa == 0) {
+            output = 0;
+            return true;
+        }
+
+        const int scale = number.exponent + precision;
+        if (scale > 0 || (scale == 0 && !number.sticky)) {
+            // sticky digits were dropped only from values above 10^18, so they overflow here
+            const uint128 limit(static_cast<uint64>(DEC_MAX_INT64) + (number.negative ? 1 : 0));
+            if (scale > 19) {
+                return false;
+            }
+            const uint128 value = uint128(number.mantissa) * pow10_wide(scale);
+            if (value > limit) {
+                return false;
+            }
+            output = number.negative ? static_cast<int64>(0 - value.lo()) : static_cast<int64>(value.lo());
+            return true;
+        }
+
+        const int n = -scale;
+        uint128 quot;
+        int fractionClass;
+        if (n > 38) {
+            // mantissa < 10^20, so quotient is below half
+            fractionClass = 1;
+        } else {
+            const uint128 divisor = pow10_wide(n);
+            uint128 rem;
+            uint128::divmod(uint128(number.mantissa), divisor, quot, rem);
+            fractionClass = fraction_class(rem, divisor);
+            // dropped digits move exact or half fraction slightly up
+            if (number.sticky && (fractionClass == 0 || fractionClass == 2)) {
+                ++fractionClass;
+            }
+        }
+        return round_sticky<RoundPolicy>(output, number.negative, quot, fractionClass);
+    }
+
+} // namespace details
+
+/// Reads JSON number (or JSON string containing number) starting at begin.
+/// Value is rounded using rounding policy of output type.
+/// \param[out] output decimal value, 0 on error
+/// \result Returns pointer past the token or NULL if token is not a valid number
+///         or value does not fit in output
+template<int Prec, class RoundPolicy>
+const char *read_json(const char *begin, const char *end, decimal<Prec, RoundPolicy> &output) {
+    const bool quoted = (begin != end && *begin == '"');
+    details::json_number number;
+    const char *pos = details::json_scan_number(quoted ? begin + 1 : begin, end, number);
+    int64 value;
+    if (pos != NULL && quoted) {
+        pos = (pos != end && *pos == '"') ? pos + 1 : NULL;
+    }
+    if (pos == NULL || !details::json_pack<RoundPolicy>(value, number, Prec)) {
+        output.setUnbiased(0);
+        return NULL;
+    }
+    output.setUnbiased(value);
+    return pos;
+}
+
+/// Reads the whole buffer as JSON number, e.g. raw number token from JSON parser.
+/// \result Returns true if conversion succeeded
+template<int Prec, class RoundPolicy>
+bool read_json(const char *str, std::size_t size, decimal<Prec, RoundPolicy> &output) {
+    const char *end = str + size;
+    if (read_json(str, end, output) != end) {
+        output.setUnbiased(0);
+        return false;
+    }
+    return true;
+}
+
+/// Writes value as canonical JSON number: without trailing zeros after decimal point
+/// and without exponent, e.g. "-12.5" or "3". Optionally the number is quoted.
+/// Buffer must have at least max_json_chars size, terminating zero is not written.
+/// \result Returns pointer past the last written char
+template<int Prec, class RoundPolicy>
+char *write_json(const decimal<Prec, RoundPolicy> &value, char *buffer, bool quoted = false) {
+    char *pos = buffer;
+    if (quoted) {
+        *pos++ = '"';
+    }
+    pos = decimal_formatter().format(value, pos);
+    if (Prec > 0) {
+        while (pos[-1] == '0') {
+            --pos;
+        }
+        if (pos[-1] == '.') {
+            --pos;
+        }
+    }
+    if (quoted) {
+        *pos++ = '"';
+    }
+    return pos;
+}
+
+/// Appends value as JSON number, see write_json().
+template<int Prec, class RoundPolicy>
+std::string &append_json(const decimal<Prec, RoundPolicy> &value, std::string &output, bool quoted = false) {
+    char buffer[max_json_chars];
+    output.append(buffer, write_json(value, buffer, quoted));
+    return output;
+}
+
+/// Adapter for SAX-style JSON parsers, which converts number events to decimal values.
+/// Handler receives every number as on_decimal(const decimal<Prec, RoundPolicy> &),
+/// other events (objects, arrays, strings etc.) are handled by Handler itself.
+/// Numbers which cannot be converted stop parsing (callback returns false).
+///
+/// Supported parsers:
+///   - RapidJSON with kParseNumbersAsStringsFlag - RawNumber()
+///   - nlohmann::json SAX interface - number_float(), number_integer(), number_unsigned()
+///   - any parser which provides raw number text - number(str, length)
+template<class Handler, int Prec, class RoundPolicy = def_round_policy>
+class json_sax_adapter : public Handler {
+public:
+    typedef decimal<Prec, RoundPolicy> value_type;
+
+    json_sax_adapter() : Handler() {
+    }
+
+    explicit json_sax_adapter(const Handler &handler) : Handler(handler) {
+    }
+
+    Handler &handler() {
+        return *this;
+    }
+
+    /// Raw number text
+    bool number(const char *str, std::size_t length) {
+        value_type value;
+        return read_json(str, length, value) && Handler::on_decimal(value);
+    }
+
+    // RapidJSON
+    template<typename SizeType>
+    bool RawNumber(const char *str, SizeType length, bool) {
+        return number(str, static_cast<std::size_t>(length));
+    }
+
+    // nlohmann::json, raw text is given for floating point numbers only
+    template<typename Float, typename String>
+    bool number_float(Float, const String &raw) {
+        return number(raw.data(), raw.size());
+    }
+
+    bool number_integer(int64 integer) {
+        value_type value;
+        return value.setWithExponent(integer, 0) && Handler::on_decimal(value);
+    }
+
+    bool number_unsigned(details::uint64 integer) {
+        value_type value;
+        return integer <= static_cast<details::uint64>(DEC_MAX_INT64) &&
+               value.setWithExponent(static_cast<int64>(integer), 0) && Handler::on_decimal(value);
+    }
+};
+
+} // namespace
+
+#endif // _DECIMAL_JSON_H__
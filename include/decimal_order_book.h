@@ -0,0 +1,401 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_order_book.h
+// Purpose:     Order book aggregated by price level, built from order
+//              messages (add, modify, cancel).
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_ORDER_BOOK_H__
+#define _DECIMAL_ORDER_BOOK_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_order_book.h
+///
+/// Prices are stored as integer tick indexes (unbiased price / tick size),
+/// quantities as unbiased values summed per level. Each side keeps its levels
+/// in one sorted array with the best level at the end, so that most updates,
+/// which are near the top of book, find their level by short linear scan and
+/// move only a few elements. Orders are kept in open-addressing hash table
+/// indexed by order id.
+///
+/// Memory is allocated only when number of orders or levels exceeds reserved
+/// capacity, so after reserve() replay of messages does not allocate.
+///
+/// Sample usage:
+///   dec::order_book<4, 2> book(dec::decimal<4>("0.0005"));
+///   book.reserve(100000, 1000);
+///   book.add(1, dec::book_bid, dec::decimal<4>("101.2500"), dec::decimal<2>("10"));
+///   book.modify(1, dec::decimal<2>("7.5"));
+///   dec::order_book<4, 2>::level top[5];
+///   std::size_t count = book.snapshot(dec::book_bid, 5, top);
+///   book.cancel(1);
+
+#include "decimal.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace DEC_NAMESPACE {
+
+/// Side of order book
+enum book_side {
+    book_bid,
+    book_ask
+};
+
+/// Price levels of bids and asks with aggregated quantity, see decimal_order_book.h
+template<int PricePrec, int QtyPrec, class RoundPolicy = def_round_policy>
+class order_book {
+    typedef details::uint64 uint64;
+
+public:
+    typedef decimal<PricePrec, RoundPolicy> price_type;
+    typedef decimal<QtyPrec, RoundPolicy> quantity_type;
+    typedef uint64 order_id;
+
+    /// Price level returned by snapshot()
+    struct level {
+        price_type price;
+        quantity_type quantity;
+        std::size_t orders;
+    };
+
+    /// Tick size must be positive, prices of orders must be its multiples
+    explicit order_book(const price_type &tickSize)
+        : m_tick(tickSize.getUnbiased() > 0 ? tickSize.getUnbiased() : 1), m_orderCount(0), m_shift(64) {
+    }
+
+    price_type tick_size() const {
+        price_type result;
+        result.setUnbiased(m_tick);
+        return result;
+    }
+
+    /// Preallocates memory for given number of live orders and levels per side
+    void reserve(std::size_t orders, std::size_t levels) {
+        if (orders * 2 > m_orders.size()) {
+            rehash(orders * 2);
+        }
+        for (int side = 0; side < 2; ++side) {
+            m_levels[side].reserve(levels);
+        }
+    }
+
+    /// Removes all orders, keeps allocated memory
+    void clear() {
+        for (std::size_t i = 0; i < m_orders.size(); ++i) {
+            m_orders[i].used = false;
+        }
+        m_orderCount = 0;
+        m_levels[book_bid].clear();
+        m_levels[book_ask].clear();
+    }
+
+    std::size_t order_count() const {
+        return m_orderCount;
+    }
+
+    std::size_t level_count(book_side side) const {
+        return m_levels[side].size();
+    }
+
+    bool empty() const {
+        return m_orderCount == 0;
+    }
+
+    /// Adds new order.
+    /// \result Returns false if id is already used, price is not multiple of tick size,
+    ///         quantity is not positive or total quantity of level would overflow
+    bool add(order_id id, book_side side, const price_type &price, const quantity_type &quantity) {
+        int64 key;
+        if (!price_key(side, price, key) || quantity.getUnbiased() <= 0 || find_order(id) != npos) {
+            return false;
+        }
+        if (!add_to_level(side, key, quantity.getUnbiased())) {
+            return false;
+        }
+        if ((m_orderCount + 1) * 2 > m_orders.size()) {
+            rehash((m_orderCount + 1) * 2);
+        }
+        order_slot &slot = m_orders[free_slot(id)];
+        slot.id = id;
+        slot.key = key;
+        slot.quantity = quantity.getUnbiased();
+        slot.side = side;
+        slot.used = true;
+        ++m_orderCount;
+        return true;
+    }
+
+    /// Changes quantity of order, price and position in level are kept.
+    /// \result Returns false if order does not exist, quantity is not positive
+    ///         or total quantity of level would overflow
+    bool modify(order_id id, const quantity_type &quantity) {
+        const std::size_t index = find_order(id);
+        if (index == npos || quantity.getUnbiased() <= 0) {
+            return false;
+        }
+        order_slot &slot = m_orders[index];
+        level_entry &entry = *find_level(slot.side, slot.key);
+        const int64 difference = quantity.getUnbiased() - slot.quantity;
+        if (difference > 0 && entry.quantity > DEC_MAX_INT64 - difference) {
+            return false;
+        }
+        entry.quantity += difference;
+        slot.quantity = quantity.getUnbiased();
+        return true;
+    }
+
+    /// Changes price and quantity of order, moving it to other level if needed.
+    /// \result Returns false if order does not exist or new values are invalid,
+    ///         order is not changed in this case
+    bool modify(order_id id, const price_type &price, const quantity_type &quantity) {
+        const std::size_t index = find_order(id);
+        if (index == npos) {
+            return false;
+        }
+        order_slot &slot = m_orders[index];
+        int64 key;
+        if (!price_key(slot.side, price, key)) {
+            return false;
+        }
+        if (key == slot.key) {
+            return modify(id, quantity);
+        }
+        if (quantity.getUnbiased() <= 0 || !add_to_level(slot.side, key, quantity.getUnbiased())) {
+            return false;
+        }
+        remove_from_level(slot.side, slot.key, slot.quantity);
+        slot.key = key;
+        slot.quantity = quantity.getUnbiased();
+        return true;
+    }
+
+    /// Removes order.
+    /// \result Returns false if order does not exist
+    bool cancel(order_id id) {
+        const std::size_t index = find_order(id);
+        if (index == npos) {
+            return false;
+        }
+        remove_from_level(m_orders[index].side, m_orders[index].key, m_orders[index].quantity);
+        erase_slot(index);
+        --m_orderCount;
+        return true;
+    }
+
+    /// Finds order with given id.
+    /// \result Returns false if order does not exist
+    bool find(order_id id, book_side &side, price_type &price, quantity_type &quantity) const {
+        const std::size_t index = find_order(id);
+        if (index == npos) {
+            return false;
+        }
+        const order_slot &slot = m_orders[index];
+        side = slot.side;
+        price = key_price(slot.side, slot.key);
+        quantity.setUnbiased(slot.quantity);
+        return true;
+    }
+
+    /// Writes best level of side to output.
+    /// \result Returns false if side is empty
+    bool best(book_side side, level &output) const {
+        return snapshot(side, 1, &output) == 1;
+    }
+
+    /// Writes up to depth best levels of side to output, best first
+    /// \result Returns number of written levels
+    std::size_t snapshot(book_side side, std::size_t depth, level *output) const {
+        const std::vector<level_entry> &levels = m_levels[side];
+        const std::size_t count = (depth < levels.size()) ? depth : levels.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            const level_entry &entry = levels[levels.size() - 1 - i];
+            output[i].price = key_price(side, entry.key);
+            output[i].quantity.setUnbiased(entry.quantity);
+            output[i].orders = entry.orders;
+        }
+        return count;
+    }
+
+private:
+    // key is tick index for bids and negated tick index for asks,
+    // so that on both sides the best level has the highest key
+    struct level_entry {
+        int64 key;
+        int64 quantity;
+        std::size_t orders;
+    };
+
+    struct key_less {
+        bool operator()(const level_entry &entry, int64 key) const {
+            return entry.key < key;
+        }
+    };
+
+    struct order_slot {
+        order_id id;
+        int64 key;
+        int64 quantity;
+        book_side side;
+        bool used;
+    };
+
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    enum { top_scan_levels = 64 };
+
+    bool price_key(book_side side, const price_type &price, int64 &key) const {
+        const int64 unbiased = price.getUnbiased();
+        const int64 tick = unbiased / m_tick;
+        // DEC_MIN_INT64 cannot be negated
+        if (unbiased % m_tick != 0 || tick == DEC_MIN_INT64) {
+            return false;
+        }
+        key = (side == book_bid) ? tick : -tick;
+        return true;
+    }
+
+    price_type key_price(book_side side, int64 key) const {
+        price_type result;
+        result.setUnbiased(((side == book_bid) ? key : -key) * m_tick);
+        return result;
+    }
+
+    // Index of first level with key not lower than given one. Most updates are near
+    // the top of book (end of array), where linear scan is faster than binary search,
+    // which mispredicts on almost every step.
+    static std::size_t level_index(const std::vector<level_entry> &levels, int64 key) {
+        std::size_t index = levels.size();
+        const std::size_t scanEnd = (index > top_scan_levels) ? index - top_scan_levels : 0;
+        while (index > scanEnd && levels[index - 1].key >= key) {
+            --index;
+        }
+        if (index > scanEnd || index == 0) {
+            return index;
+        }
+        return static_cast<std::size_t>(std::lower_bound(levels.begin(), levels.begin() + static_cast<std::ptrdiff_t>(index),
+                                                         key, key_less()) - levels.begin());
+    }
+
+    level_entry *find_level(book_side side, int64 key) {
+        std::vector<level_entry> &levels = m_levels[side];
+        return &levels[level_index(levels, key)];
+    }
+
+    bool add_to_level(book_side side, int64 key, int64 quantity) {
+        std::vector<level_entry> &levels = m_levels[side];
+        typename std::vector<level_entry>::iterator it =
+                levels.begin() + static_cast<std::ptrdiff_t>(level_index(levels, key));
+        if (it != levels.end() && it->key == key) {
+            if (it->quantity > DEC_MAX_INT64 - quantity) {
+                return false;
+            }
+            it->quantity += quantity;
+            ++it->orders;
+            return true;
+        }
+        level_entry entry;
+        entry.key = key;
+        entry.quantity = quantity;
+        entry.orders = 1;
+        levels.insert(it, entry);
+        return true;
+    }
+
+    void remove_from_level(book_side side, int64 key, int64 quantity) {
+        level_entry *entry = find_level(side, key);
+        if (--entry->orders == 0) {
+            std::vector<level_entry> &levels = m_levels[side];
+            levels.erase(levels.begin() + (entry - &levels[0]));
+        } else {
+            entry->quantity -= quantity;
+        }
+    }
+
+    // Fibonacci hashing, table size is power of two
+    std::size_t home_slot(order_id id) const {
+        return static_cast<std::size_t>((id * 11400714819323198485ULL) >> m_shift);
+    }
+
+    std::size_t find_order(order_id id) const {
+        if (m_orders.empty()) {
+            return npos;
+        }
+        const std::size_t mask = m_orders.size() - 1;
+        for (std::size_t index = home_slot(id);; index = (index + 1) & mask) {
+            const order_slot &slot = m_orders[index];
+            if (!slot.used) {
+                return npos;
+            }
+            if (slot.id == id) {
+                return index;
+            }
+        }
+    }
+
+    std::size_t free_slot(order_id id) const {
+        const std::size_t mask = m_orders.size() - 1;
+        std::size_t index = home_slot(id);
+        while (m_orders[index].used) {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    // backward shift deletion, so that linear probing does not need tombstones
+    void erase_slot(std::size_t index) {
+        const std::size_t mask = m_orders.size() - 1;
+        std::size_t next = index;
+        for (;;) {
+            next = (next + 1) & mask;
+            if (!m_orders[next].used) {
+                break;
+            }
+            // distance from home slot, entry can be moved only towards it
+            const std::size_t home = home_slot(m_orders[next].id);
+            if (((next - home) & mask) >= ((next - index) & mask)) {
+                m_orders[index] = m_orders[next];
+                index = next;
+            }
+        }
+        m_orders[index].used = false;
+    }
+
+    void rehash(std::size_t minSize) {
+        std::size_t size = 16;
+        int shift = 60;
+        while (size < minSize) {
+            size *= 2;
+            --shift;
+        }
+        std::vector<order_slot> old;
+        old.swap(m_orders);
+        order_slot empty;
+        empty.id = 0;
+        empty.key = 0;
+        empty.quantity = 0;
+        empty.side = book_bid;
+        empty.used = false;
+        m_orders.assign(size, empty);
+        m_shift = shift;
+        for (std::size_t i = 0; i < old.size(); ++i) {
+            if (old[i].used) {
+                m_orders[free_slot(old[i].id)] = old[i];
+            }
+        }
+    }
+
+    int64 m_tick;
+    std::vector<level_entry> m_levels[2];
+    std::vector<order_slot> m_orders;
+    std::size_t m_orderCount;
+    int m_shift;
+};
+
+} // namespace
+
+#endif // _DECIMAL_ORDER_BOOK_H__
@@ -0,0 +1,569 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_reader.h
+// Purpose:     Parallel reader of decimal columns from memory-mapped
+//              text (CSV) files.
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_READER_H__
+#define _DECIMAL_READER_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_reader.h
+///
+/// File is mapped into memory in windows of limited size (so files larger than RAM
+/// can be read), every window is split into chunks at line boundaries and chunks
+/// are parsed by worker threads. Fields are parsed directly from mapped memory.
+///
+/// Sample usage:
+///   std::vector<std::size_t> columns;
+///   columns.push_back(2); // price
+///   columns.push_back(3); // quantity
+///   dec::decimal_file_reader<4> reader("prices.csv", columns);
+///   std::vector<std::vector<dec::decimal<4> > > values;
+///   if (!reader.read_columns(values)) ...
+///
+/// Threads are used only in C++11 mode, DEC_NO_CPP11 gives sequential reader.
+/// Memory mapping is implemented for POSIX systems and Windows.
+
+#include "decimal.h"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef DEC_NO_CPP11
+#include <atomic>
+#include <thread>
+#endif
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace DEC_NAMESPACE {
+
+/// Options of decimal_file_reader
+struct decimal_reader_options {
+    /// field separator
+    char separator;
+    char decimal_point;
+    /// first line contains column names
+    bool skip_header;
+    /// number of worker threads, 0 - number of hardware threads
+    unsigned threads;
+    /// number of bytes mapped at once, extended when single line is longer
+    std::size_t window_size;
+    /// number of bytes parsed by single task
+    std::size_t chunk_size;
+
+    decimal_reader_options() : separator(','), decimal_point('.'), skip_header(false), threads(0),
+                               window_size(64 * 1024 * 1024), chunk_size(1024 * 1024) {
+    }
+};
+
+namespace details {
+
+    /// Read-only file mapping, one window mapped at a time.
+    class mapped_file {
+    public:
+        mapped_file() : m_size(0), m_view(NULL), m_viewSize(0) {
+#if defined(_WIN32)
+            m_file = INVALID_HANDLE_VALUE;
+            m_mapping = NULL;
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            m_granularity = info.dwAllocationGranularity;
+#else
+            m_file = -1;
+            m_granularity = static_cast<uint64>(sysconf(_SC_PAGESIZE));
+#endif
+        }
+
+        ~mapped_file() {
+            close();
+        }
+
+        bool open(const char *path) {
+            close();
+#if defined(_WIN32)
+            m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                 FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+            LARGE_INTEGER size;
+            if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size)) {
+                close();
+                return false;
+            }
+            m_size = static_cast<uint64>(size.QuadPart);
+            if (m_size > 0) {
+                m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if (m_mapping == NULL) {
+                    close();
+                    return false;
+                }
+            }
+#else
+            m_file = ::open(path, O_RDONLY);
+            struct stat info;
+            if (m_file < 0 || fstat(m_file, &info) != 0) {
+                close();
+                return false;
+            }
+            m_size = static_cast<uint64>(info.st_size);
+#endif
+            return true;
+        }
+
+        bool is_open() const {
+#if defined(_WIN32)
+            return m_file != INVALID_HANDLE_VALUE;
+#else
+            return m_file >= 0;
+#endif
+        }
+
+        uint64 size() const {
+            return m_size;
+        }
+
+        /// Maps [offset, offset + length) replacing previous window.
+        /// \result Returns pointer to byte at offset or NULL on error
+        const char *map(uint64 offset, std::size_t length) {
+            unmap();
+            const uint64 start = offset - offset % m_granularity;
+            const std::size_t shift = static_cast<std::size_t>(offset - start);
+            m_viewSize = length + shift;
+#if defined(_WIN32)
+            m_view = MapViewOfFile(m_mapping, FILE_MAP_READ, static_cast<DWORD>(start >> 32),
+                                   static_cast<DWORD>(start & 0xFFFFFFFFu), m_viewSize);
+#else
+            m_view = mmap(NULL, m_viewSize, PROT_READ, MAP_PRIVATE, m_file, static_cast<off_t>(start));
+            if (m_view == MAP_FAILED) {
+                m_view = NULL;
+            } else {
+                madvise(m_view, m_viewSize, MADV_SEQUENTIAL);
+            }
+#endif
+            return m_view != NULL ? static_cast<const char *>(m_view) + shift : NULL;
+        }
+
+        void unmap() {
+            if (m_view != NULL) {
+#if defined(_WIN32)
+                UnmapViewOfFile(m_view);
+#else
+                munmap(m_view, m_viewSize);
+#endif
+                m_view = NULL;
+            }
+        }
+
+        void close() {
+            unmap();
+#if defined(_WIN32)
+            if (m_mapping != NULL) {
+                CloseHandle(m_mapping);
+                m_mapping = NULL;
+            }
+            if (m_file != INVALID_HANDLE_VALUE) {
+                CloseHandle(m_file);
+                m_file = INVALID_HANDLE_VALUE;
+            }
+#else
+            if (m_file >= 0) {
+                ::close(m_file);
+                m_file = -1;
+            }
+#endif
+            m_size = 0;
+        }
+
+    private:
+        // not copyable
+        mapped_file(const mapped_file &);
+        mapped_file &operator=(const mapped_file &);
+
+#if defined(_WIN32)
+        HANDLE m_file;
+        HANDLE m_mapping;
+#else
+        int m_file;
+#endif
+        uint64 m_granularity;
+        uint64 m_size;
+        void *m_view;
+        std::size_t m_viewSize;
+    };
+
+    /// \result Returns pointer past the first '\n' at or after pos, end if there is none
+    inline const char *next_line(const char *pos, const char *end) {
+        const void *found = std::memchr(pos, '\n', static_cast<std::size_t>(end - pos));
+        return found != NULL ? static_cast<const char *>(found) + 1 : end;
+    }
+
+    /// Parses selected fields of lines in [begin, end), passes every row to sink.
+    template<class DecimalType>
+    class line_parser {
+    public:
+        line_parser(const std::vector<int> &slots, std::size_t columnCount, const decimal_reader_options &options) :
+                m_slots(slots), m_format(make_format_spec(options.decimal_point)), m_separator(options.separator),
+                m_values(columnCount), m_rows(0), m_errors(0) {
+        }
+
+        template<class Sink>
+        void parse(const char *begin, const char *end, Sink &sink) {
+            const std::size_t usedColumns = m_slots.size();
+            DecimalType *values = m_values.empty() ? NULL : &m_values[0];
+
+            const char *line = begin;
+            while (line < end) {
+                const char *lineEnd = next_line(line, end);
+                const char *contentEnd = lineEnd;
+                if (contentEnd > line && contentEnd[-1] == '\n') {
+                    --contentEnd;
+                }
+                if (contentEnd > line && contentEnd[-1] == '\r') {
+                    --contentEnd;
+                }
+
+                if (contentEnd > line) {
+                    std::size_t column = 0;
+                    const char *field = line;
+                    while (column < usedColumns) {
+                        const void *separator = std::memchr(field, m_separator,
+                                                            static_cast<std::size_t>(contentEnd - field));
+                        const char *fieldEnd = separator != NULL ? static_cast<const char *>(separator) : contentEnd;
+                        const int slot = m_slots[column];
+                        if (slot >= 0) {
+                            if (!fromString(field, static_cast<std::size_t>(fieldEnd - field), m_format,
+                                            values[slot])) {
+                                ++m_errors;
+                            }
+                        }
+                        ++column;
+                        if (separator == NULL) {
+                            break;
+                        }
+                        field = fieldEnd + 1;
+                    }
+
+                    // missing fields
+                    for (; column < usedColumns; ++column) {
+                        if (m_slots[column] >= 0) {
+                            values[m_slots[column]] = DecimalType(0);
+                            ++m_errors;
+                        }
+                    }
+
+                    sink(static_cast<const DecimalType *>(values), m_values.size());
+                    ++m_rows;
+                }
+                line = lineEnd;
+            }
+        }
+
+        std::size_t rows() const {
+            return m_rows;
+        }
+
+        std::size_t errors() const {
+            return m_errors;
+        }
+
+    private:
+        // slot (output index) for every column up to the last selected one, -1 if not selected
+        const std::vector<int> &m_slots;
+        const format_spec m_format;
+        const char m_separator;
+        std::vector<DecimalType> m_values;
+        std::size_t m_rows;
+        std::size_t m_errors;
+    };
+
+    /// Appends rows to column vectors
+    template<class DecimalType>
+    struct column_sink {
+        explicit column_sink(std::vector<std::vector<DecimalType> > &columns) : m_columns(columns) {
+        }
+
+        void operator()(const DecimalType *values, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                m_columns[i].push_back(values[i]);
+            }
+        }
+
+        std::vector<std::vector<DecimalType> > &m_columns;
+    };
+
+    /// Task which parses every chunk into its own columns,
+    /// columns are appended to output in chunk order after the window is parsed.
+    template<class DecimalType>
+    struct column_task {
+        typedef std::vector<std::vector<DecimalType> > columns_type;
+
+        explicit column_task(columns_type &output) : m_output(output) {
+        }
+
+        void begin_window(std::size_t chunkCount) {
+            m_chunks.resize(chunkCount);
+        }
+
+        void operator()(std::size_t chunk, const char *begin, const char *end, line_parser<DecimalType> &parser) {
+            columns_type &columns = m_chunks[chunk];
+            columns.assign(m_output.size(), std::vector<DecimalType>());
+            column_sink<DecimalType> sink(columns);
+            parser.parse(begin, end, sink);
+        }
+
+        void end_window() {
+            for (std::size_t i = 0; i < m_chunks.size(); ++i) {
+                for (std::size_t c = 0; c < m_output.size(); ++c) {
+                    m_output[c].insert(m_output[c].end(), m_chunks[i][c].begin(), m_chunks[i][c].end());
+                }
+            }
+        }
+
+        columns_type &m_output;
+        std::vector<columns_type> m_chunks;
+    };
+
+    /// Task which passes rows to user callback
+    template<class DecimalType, class Callback>
+    struct callback_task {
+        explicit callback_task(Callback &callback) : m_callback(callback) {
+        }
+
+        void begin_window(std::size_t) {
+        }
+
+        void operator()(std::size_t, const char *begin, const char *end, line_parser<DecimalType> &parser) {
+            parser.parse(begin, end, m_callback);
+        }
+
+        void end_window() {
+        }
+
+        Callback &m_callback;
+    };
+
+} // namespace details
+
+/// Reads selected columns of decimal values from text file, one row per line.
+/// Empty lines are skipped, fields which cannot be parsed and missing fields
+/// are set to 0 and counted as errors.
+template<int Prec, class RoundPolicy = def_round_policy>
+class decimal_file_reader {
+public:
+    typedef decimal<Prec, RoundPolicy> value_type;
+
+    /// Opens file, columns are zero-based indexes of fields read (in order of output).
+    decimal_file_reader(const std::string &path, const std::vector<std::size_t> &columns,
+                        const decimal_reader_options &options = decimal_reader_options()) :
+            m_columnCount(columns.size()), m_options(options), m_rows(0), m_errors(0) {
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            if (columns[i] >= m_slots.size()) {
+                m_slots.resize(columns[i] + 1, -1);
+            }
+            m_slots[columns[i]] = static_cast<int>(i);
+        }
+        if (m_options.chunk_size == 0) {
+            m_options.chunk_size = 1;
+        }
+        if (m_options.window_size < m_options.chunk_size) {
+            m_options.window_size = m_options.chunk_size;
+        }
+        m_file.open(path.c_str());
+    }
+
+    bool is_open() const {
+        return m_file.is_open();
+    }
+
+    /// Number of rows read by the last call
+    std::size_t rows() const {
+        return m_rows;
+    }
+
+    /// Number of fields which could not be read in the last call
+    std::size_t errors() const {
+        return m_errors;
+    }
+
+    /// Reads whole file, output[i] receives values of column columns[i] in file order.
+    /// \result Returns false if file could not be read
+    bool read_columns(std::vector<std::vector<value_type> > &output) {
+        output.assign(m_columnCount, std::vector<value_type>());
+        details::column_task<value_type> task(output);
+        return read(task);
+    }
+
+    /// Calls callback(const value_type *values, std::size_t count) for every row,
+    /// values are in order of columns given in constructor.
+    /// With more than one thread callback is called concurrently and rows of
+    /// different chunks are not passed in file order.
+    /// \result Returns false if file could not be read
+    template<class Callback>
+    bool for_each_row(Callback &callback) {
+        details::callback_task<value_type, Callback> task(callback);
+        return read(task);
+    }
+
+private:
+    template<class Task>
+    bool read(Task &task) {
+        m_rows = 0;
+        m_errors = 0;
+        if (!m_file.is_open()) {
+            return false;
+        }
+
+        const details::uint64 fileSize = m_file.size();
+        details::uint64 offset = 0;
+        std::size_t windowSize = m_options.window_size;
+        bool header = m_options.skip_header;
+
+        while (offset < fileSize) {
+            const details::uint64 left = fileSize - offset;
+            const std::size_t length = left < windowSize ? static_cast<std::size_t>(left) : windowSize;
+            const char *begin = m_file.map(offset, length);
+            if (begin == NULL) {
+                return false;
+            }
+            const char *end = begin + length;
+
+            // window ends after the last complete line
+            if (length < left) {
+                const char *last = end;
+                while (last > begin && last[-1] != '\n') {
+                    --last;
+                }
+                if (last == begin) {
+                    // line longer than window
+                    windowSize *= 2;
+                    continue;
+                }
+                end = last;
+            }
+            windowSize = m_options.window_size;
+
+            const char *start = begin;
+            if (header) {
+                start = details::next_line(begin, end);
+                header = false;
+            }
+
+            std::vector<const char *> bounds;
+            split(start, end, bounds);
+            task.begin_window(bounds.size() - 1);
+            run(task, bounds);
+            task.end_window();
+
+            offset += static_cast<details::uint64>(end - begin);
+        }
+        m_file.unmap();
+        return true;
+    }
+
+    // chunk boundaries at line starts, bounds.front() == begin, bounds.back() == end
+    void split(const char *begin, const char *end, std::vector<const char *> &bounds) const {
+        bounds.push_back(begin);
+        const char *pos = begin;
+        while (static_cast<std::size_t>(end - pos) > m_options.chunk_size) {
+            pos = details::next_line(pos + m_options.chunk_size, end);
+            bounds.push_back(pos);
+        }
+        if (pos != end) {
+            bounds.push_back(end);
+        }
+    }
+
+    template<class Task>
+    struct chunk_runner {
+        chunk_runner(Task &task, const std::vector<const char *> &bounds, const decimal_file_reader &owner) :
+                m_task(task), m_bounds(bounds),
+                m_parser(owner.m_slots, owner.m_columnCount, owner.m_options) {
+        }
+
+        void run_chunk(std::size_t chunk) {
+            m_task(chunk, m_bounds[chunk], m_bounds[chunk + 1], m_parser);
+        }
+
+        Task &m_task;
+        const std::vector<const char *> &m_bounds;
+        details::line_parser<value_type> m_parser;
+    };
+
+    template<class Task>
+    void run(Task &task, const std::vector<const char *> &bounds) {
+        const std::size_t chunkCount = bounds.size() - 1;
+        const std::size_t threads = thread_count(chunkCount);
+
+        if (threads <= 1) {
+            chunk_runner<Task> runner(task, bounds, *this);
+            for (std::size_t i = 0; i < chunkCount; ++i) {
+                runner.run_chunk(i);
+            }
+            add_counters(runner.m_parser);
+            return;
+        }
+
+#ifndef DEC_NO_CPP11
+        std::atomic<std::size_t> next(0);
+        std::vector<chunk_runner<Task> > runners(threads, chunk_runner<Task>(task, bounds, *this));
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t) {
+            chunk_runner<Task> *runner = &runners[t];
+            workers.push_back(std::thread([runner, &next, chunkCount]() {
+                for (std::size_t i = next++; i < chunkCount; i = next++) {
+                    runner->run_chunk(i);
+                }
+            }));
+        }
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers[t].join();
+            add_counters(runners[t].m_parser);
+        }
+#endif
+    }
+
+    std::size_t thread_count(std::size_t chunkCount) const {
+#ifdef DEC_NO_CPP11
+        (void) chunkCount;
+        return 1;
+#else
+        std::size_t threads = m_options.threads;
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        return threads < chunkCount ? threads : chunkCount;
+#endif
+    }
+
+    void add_counters(const details::line_parser<value_type> &parser) {
+        m_rows += parser.rows();
+        m_errors += parser.errors();
+    }
+
+    std::vector<int> m_slots;
+    std::size_t m_columnCount;
+    decimal_reader_options m_options;
+    details::mapped_file m_file;
+    std::size_t m_rows;
+    std::size_t m_errors;
+};
+
+} // namespace
+
+#endif // _DECIMAL_READER_H__
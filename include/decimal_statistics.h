@@ -0,0 +1,513 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal_statistics.h
+// Purpose:     Mean, variance, quantiles and VWAP of decimal values,
+//              calculated exactly on wide integer accumulators.
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#ifndef _DECIMAL_STATISTICS_H__
+#define _DECIMAL_STATISTICS_H__
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal_statistics.h
+///
+/// Accumulators keep exact sums (128-bit sum of values, 256-bit sum of squares
+/// and products), so results do not depend on order of values and are rounded
+/// only once, using rounding policy of output type. Standard deviation is
+/// the correctly rounded square root of exact variance.
+/// Accumulators can be filled in parallel and joined with merge().
+///
+/// Sample usage:
+///   dec::running_stats<2> stats;
+///   for (...) stats.add(price);
+///   dec::decimal<4> avg, sd;
+///   if (stats.mean(avg) && stats.stddev(sd)) ...
+///
+///   dec::vwap_accumulator<4, 0> vwap;
+///   vwap.add(price, quantity);
+///   dec::decimal<6> result;
+///   vwap.vwap(result);
+///
+///   dec::decimal<2> p95;
+///   dec::quantile(prices, count, dec::decimal<2>("0.95"), p95);
+///
+/// All functions return false when result is not defined (e.g. no values)
+/// or does not fit in output type.
+
+#include "decimal.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace DEC_NAMESPACE {
+
+namespace details {
+
+    /// Sign-extends value to 128 bits, negative values are stored in two's complement
+    inline uint128 stats_widen(int64 value) {
+        return uint128(value < 0 ? ~static_cast<uint64>(0) : 0, static_cast<uint64>(value));
+    }
+
+    inline bool stats_is_negative(const uint128 &value) {
+        return (value.hi() >> 63) != 0;
+    }
+
+    inline uint128 stats_abs(const uint128 &value) {
+        return stats_is_negative(value) ? uint128() - value : value;
+    }
+
+    inline bool stats_is_negative(const uint256 &value) {
+        return value.bit(255);
+    }
+
+    inline uint256 stats_abs(const uint256 &value) {
+        return stats_is_negative(value) ? uint256() - value : value;
+    }
+
+    /// Calculates quot = floor(num * 10^shift / den) and rem = remainder over denOut,
+    /// where denOut = den * 10^-shift for negative shift (den otherwise).
+    /// \result Returns false if quotient does not fit in 128 bits
+    inline bool stats_scaled_divmod(const uint256 &num, const uint256 &den, int shift,
+                                    uint128 &quot, uint256 &rem, uint256 &denOut) {
+        if (shift > 38 || shift < -38) {
+            return false;
+        }
+        uint256 q;
+        if (shift < 0) {
+            if (!uint256::mul(den, pow10_wide(-shift), denOut)) {
+                return false;
+            }
+            uint256::divmod(num, denOut, q, rem);
+        } else {
+            // divide first, so that scaled numerator never overflows
+            const uint128 factor = pow10_wide(shift);
+            uint256 r, q2, scaled;
+            uint256::divmod(num, den, q, r);
+            if (q.bitLength() > 128 || !uint256::mul(q, factor, q) || !uint256::mul(r, factor, scaled)) {
+                return false;
+            }
+            uint256::divmod(scaled, den, q2, rem);
+            q = q + q2;
+            denOut = den;
+        }
+        if (q.bitLength() > 128) {
+            return false;
+        }
+        quot = q.shiftedRight(0);
+        return true;
+    }
+
+    /// Calculates output = round(num * 10^shift / den), sign is applied before rounding
+    template<class RoundPolicy>
+    bool stats_round_ratio(int64 &output, bool negative, const uint256 &num, const uint256 &den, int shift) {
+        uint128 quot;
+        uint256 rem, divisor;
+        if (!stats_scaled_divmod(num, den, shift, quot, rem, divisor)) {
+            return false;
+        }
+        int fractionClass = 0;
+        if (!rem.isZero()) {
+            const uint256 rest = divisor - rem;
+            fractionClass = (rem < rest) ? 1 : ((rem == rest) ? 2 : 3);
+        }
+        return round_sticky<RoundPolicy>(output, negative, quot, fractionClass);
+    }
+
+    /// Calculates output = round(sqrt(num * 10^shift / den))
+    template<class RoundPolicy>
+    bool stats_round_sqrt(int64 &output, const uint256 &num, const uint256 &den, int shift) {
+        uint128 quot;
+        uint256 rem, divisor;
+        if (!stats_scaled_divmod(num, den, shift, quot, rem, divisor)) {
+            return false;
+        }
+        const uint128 root = isqrt(quot);
+        // x = quot + rem / divisor, compare it with (root + 1/2)^2 = root^2 + root + 1/4
+        const uint128 excess = quot - root * root;
+        int fractionClass;
+        if (excess.isZero() && rem.isZero()) {
+            // exact square, also zero
+            fractionClass = 0;
+        } else if (excess > root) {
+            fractionClass = 3;
+        } else if (excess < root) {
+            fractionClass = 1;
+        } else {
+            const uint256 rem4 = rem << 2;
+            fractionClass = (rem4 < divisor) ? 1 : ((rem4 == divisor) ? 2 : 3);
+        }
+        return round_sticky<RoundPolicy>(output, false, root, fractionClass);
+    }
+
+    /// Selects quantile p / 10^pPrec (linear interpolation between closest ranks)
+    /// from values in [begin, end), which are reordered.
+    /// Result has precision prec + shift.
+    template<class RoundPolicy>
+    bool stats_quantile(int64 *begin, int64 *end, int64 p, int pPrec, int shift, int64 &output) {
+        const uint64 scale = static_cast<uint64>(dec_utils<RoundPolicy>::pow10(pPrec));
+        if (begin == end || p < 0 || static_cast<uint64>(p) > scale) {
+            return false;
+        }
+
+        // rank h = (count - 1) * p, split into integer and fractional part
+        const uint64 last = static_cast<uint64>(end - begin) - 1;
+        uint64 fraction;
+        const uint128 rank = uint128::mul(last, static_cast<uint64>(p)).divSmall(scale, fraction);
+        int64 *lower = begin + static_cast<std::ptrdiff_t>(rank.lo());
+        std::nth_element(begin, lower, end);
+
+        // value = lower + (upper - lower) * fraction / scale
+        uint128 num = uint128::mul(abs_unsigned(*lower), scale);
+        if (*lower < 0) {
+            num = uint128() - num;
+        }
+        if (fraction != 0) {
+            const int64 upper = *std::min_element(lower + 1, end);
+            const uint64 diff = static_cast<uint64>(upper) - static_cast<uint64>(*lower);
+            num = num + uint128::mul(diff, fraction);
+        }
+        return stats_round_ratio<RoundPolicy>(output, stats_is_negative(num), uint256(stats_abs(num)),
+                                              uint256(uint128(scale)), shift);
+    }
+
+} // namespace details
+
+/// Streaming accumulator of count, sum, sum of squares, minimum and maximum.
+/// Exact for any number of values (up to 2^64).
+template<int Prec, class RoundPolicy = def_round_policy>
+class running_stats {
+public:
+    typedef decimal<Prec, RoundPolicy> value_type;
+
+    running_stats() : m_count(0), m_min(0), m_max(0) {
+    }
+
+    void add(const value_type &value) {
+        const int64 unbiased = value.getUnbiased();
+        const details::uint64 absValue = details::abs_unsigned(unbiased);
+        m_sum = m_sum + details::stats_widen(unbiased);
+        m_sumSquares = m_sumSquares + details::uint256(details::uint128::mul(absValue, absValue));
+        m_min = (m_count == 0 || unbiased < m_min) ? unbiased : m_min;
+        m_max = (m_count == 0 || unbiased > m_max) ? unbiased : m_max;
+        ++m_count;
+    }
+
+    void add(const value_type *values, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            add(values[i]);
+        }
+    }
+
+    /// Adds all values collected by other accumulator (e.g. in another thread)
+    void merge(const running_stats &other) {
+        if (other.m_count == 0) {
+            return;
+        }
+        m_min = (m_count == 0 || other.m_min < m_min) ? other.m_min : m_min;
+        m_max = (m_count == 0 || other.m_max > m_max) ? other.m_max : m_max;
+        m_count += other.m_count;
+        m_sum = m_sum + other.m_sum;
+        m_sumSquares = m_sumSquares + other.m_sumSquares;
+    }
+
+    details::uint64 count() const {
+        return m_count;
+    }
+
+    bool empty() const {
+        return m_count == 0;
+    }
+
+    /// Minimum value, 0 if there are no values
+    value_type min() const {
+        value_type result;
+        result.setUnbiased(m_min);
+        return result;
+    }
+
+    /// Maximum value, 0 if there are no values
+    value_type max() const {
+        value_type result;
+        result.setUnbiased(m_max);
+        return result;
+    }
+
+    template<int ResultPrec, class ResultRoundPolicy>
+    bool sum(decimal<ResultPrec, ResultRoundPolicy> &output) const {
+        return ratio(output, details::uint256(details::uint128(1)), ResultPrec - Prec);
+    }
+
+    /// Arithmetic mean
+    template<int ResultPrec, class ResultRoundPolicy>
+    bool mean(decimal<ResultPrec, ResultRoundPolicy> &output) const {
+        return m_count != 0 &&
+               ratio(output, details::uint256(details::uint128(m_count)), ResultPrec - Prec);
+    }
+
+    /// Sample variance, sum((x - mean)^2) / (count - 1)
+    template<int ResultPrec, class ResultRoundPolicy>
+    bool variance(decimal<ResultPrec, ResultRoundPolicy> &output) const {
+        int64 unbiased;
+        if (m_count < 2 || !details::stats_round_ratio<ResultRoundPolicy>(
+                unbiased, false, deviations(), denominator(true), ResultPrec - 2 * Prec)) {
+            return false;
+        }
+        output.setUnbiased(unbiased);
+        return true;
+    }
+
+    /// Population variance, sum((x - mean)^2) / count
+    template<int ResultPrec, class ResultRoundPolicy>
+    bool population_variance(decimal<ResultPrec, ResultRoundPolicy> &output) const {
+        int64 unbiased;
+        if (m_count == 0 || !details::stats_round_ratio<ResultRoundPolicy>(
+                unbiased, false, deviations(), denominator(false), ResultPrec - 2 * Prec)) {
+            return false;
+        }
+        output.setUnbiased(unbiased);
+        return true;
+    }
+
+    /// Sample standard deviation, square root of variance()
+    template<int ResultPrec, class ResultRoundPolicy>
+    bool stddev(decimal<ResultPrec, ResultRoundPolicy> &output) const {
+        int64 unbiased;
+        if (m_count < 2 || !details::stats_round_sqrt<ResultRoundPolicy>(
+                unbiased, deviations(), denominator(true), 2 * (ResultPrec - Prec))) {
+            return false;
+        }
+        output.setUnbiased(unbiased);
+        return true;
+    }
+
+    /// Population standard deviation, square root of population_variance()
+    template<int ResultPrec, class ResultRoundPolicy>
+    bool population_stddev(decimal<ResultPrec, ResultRoundPolicy> &output) const {
+        int64 unbiased;
+        if (m_count == 0 || !details::stats_round_sqrt<ResultRoundPolicy>(
+                unbiased, deviations(), denominator(false), 2 * (ResultPrec - Prec))) {
+            return false;
+        }
+        output.setUnbiased(unbiased);
+        return true;
+    }
+
+private:
+    template<int ResultPrec, class ResultRoundPolicy>
+    bool ratio(decimal<ResultPrec, ResultRoundPolicy> &output, const details::uint256 &den, int shift) const {
+        int64 unbiased;
+        if (!details::stats_round_ratio<ResultRoundPolicy>(unbiased, details::stats_is_negative(m_sum),
+                details::uint256(details::stats_abs(m_sum)), den, shift)) {
+            return false;
+        }
+        output.setUnbiased(unbiased);
+        return true;
+    }
+
+    // count * sum(x^2) - sum(x)^2 = count * sum((x - mean)^2), never negative
+    details::uint256 deviations() const {
+        details::uint256 scaled;
+        details::uint256::mul(m_sumSquares, details::uint128(m_count), scaled);
+        const details::uint128 absSum = details::stats_abs(m_sum);
+        return scaled - details::uint256(absSum, absSum);
+    }
+
+    // count * count or count * (count - 1)
+    details::uint256 denominator(bool sample) const {
+        return details::uint256(details::uint128(m_count), details::uint128(sample ? m_count - 1 : m_count));
+    }
+
+    details::uint64 m_count;
+    details::uint128 m_sum;
+    details::uint256 m_sumSquares;
+    int64 m_min;
+    int64 m_max;
+};
+
+/// Streaming accumulator of volume weighted average price:
+/// sum(price * quantity) / sum(quantity), calculated exactly.
+template<int PricePrec, int QuantityPrec, class RoundPolicy = def_round_policy>
+class vwap_accumulator {
+public:
+    typedef decimal<PricePrec, RoundPolicy> price_type;
+    typedef decimal<QuantityPrec, RoundPolicy> quantity_type;
+
+    vwap_accumulator() : m_count(0) {
+    }
+
+    void add(const price_type &price, const quantity_type &quantity) {
+        const int64 p = price.getUnbiased();
+        const int64 q = quantity.getUnbiased();
+        const details::uint256 product(details::uint128::mul(details::abs_unsigned(p), details::abs_unsigned(q)));
+        m_notional = ((p < 0) != (q < 0)) ? m_notional - product : m_notional + product;
+        m_volume = m_volume + details::stats_widen(q);
+        ++m_count;
+    }
+
+    void add(const price_type *prices, const quantity_type *quantities, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            add(prices[i], quantities[i]);
+        }
+    }
+
+    /// Adds all trades collected by other accumulator (e.g. in another thread)
+    void merge(const vwap_accumulator &other) {
+        m_count += other.m_count;
+        m_notional = m_notional + other.m_notional;
+        m_volume = m_volume + other.m_volume;
+    }
+
+    details::uint64 count() const {
+        return m_count;
+    }
+
+    /// Total quantity
+    template<int ResultPrec, class ResultRoundPolicy>
+    bool volume(decimal<ResultPrec, ResultRoundPolicy> &output) const {
+        int64 unbiased;
+        if (!details::stats_round_ratio<ResultRoundPolicy>(unbiased, details::stats_is_negative(m_volume),
+                details::uint256(details::stats_abs(m_volume)), details::uint256(details::uint128(1)),
+                ResultPrec - QuantityPrec)) {
+            return false;
+        }
+        output.setUnbiased(unbiased);
+        return true;
+    }
+
+    /// Volume weighted average price, false if total quantity is zero
+    template<int ResultPrec, class ResultRoundPolicy>
+    bool vwap(decimal<ResultPrec, ResultRoundPolicy> &output) const {
+        int64 unbiased;
+        if (m_volume.isZero() || !details::stats_round_ratio<ResultRoundPolicy>(unbiased,
+                details::stats_is_negative(m_notional) != details::stats_is_negative(m_volume),
+                details::stats_abs(m_notional), details::uint256(details::stats_abs(m_volume)),
+                ResultPrec - PricePrec)) {
+            return false;
+        }
+        output.setUnbiased(unbiased);
+        return true;
+    }
+
+private:
+    details::uint64 m_count;
+    details::uint256 m_notional;
+    details::uint128 m_volume;
+};
+
+/// Collects values for exact quantiles. Values are kept as raw payload,
+/// selection reorders them, so queries are O(n) on average.
+template<int Prec, class RoundPolicy = def_round_policy>
+class exact_quantiles {
+public:
+    typedef decimal<Prec, RoundPolicy> value_type;
+
+    void add(const value_type &value) {
+        m_values.push_back(value.getUnbiased());
+    }
+
+    void add(const value_type *values, std::size_t count) {
+        m_values.reserve(m_values.size() + count);
+        for (std::size_t i = 0; i < count; ++i) {
+            m_values.push_back(values[i].getUnbiased());
+        }
+    }
+
+    /// Adds all values collected by other instance (e.g. in another thread)
+    void merge(const exact_quantiles &other) {
+        m_values.insert(m_values.end(), other.m_values.begin(), other.m_values.end());
+    }
+
+    std::size_t size() const {
+        return m_values.size();
+    }
+
+    void reserve(std::size_t count) {
+        m_values.reserve(count);
+    }
+
+    void clear() {
+        m_values.clear();
+    }
+
+    /// Quantile with linear interpolation between closest ranks
+    /// (value at rank (size - 1) * p), p must be in range [0, 1].
+    template<int PPrec, class PRoundPolicy, int ResultPrec, class ResultRoundPolicy>
+    bool quantile(const decimal<PPrec, PRoundPolicy> &p, decimal<ResultPrec, ResultRoundPolicy> &output) {
+        int64 unbiased;
+        if (m_values.empty() || !details::stats_quantile<ResultRoundPolicy>(&m_values[0],
+                &m_values[0] + m_values.size(), p.getUnbiased(), PPrec, ResultPrec - Prec, unbiased)) {
+            return false;
+        }
+        output.setUnbiased(unbiased);
+        return true;
+    }
+
+    template<int ResultPrec, class ResultRoundPolicy>
+    bool median(decimal<ResultPrec, ResultRoundPolicy> &output) {
+        return quantile(decimal<1>::buildWithExponent(5, -1), output);
+    }
+
+private:
+    std::vector<int64> m_values;
+};
+
+/// Arithmetic mean of array
+template<int Prec, class RoundPolicy, int ResultPrec, class ResultRoundPolicy>
+bool mean(const decimal<Prec, RoundPolicy> *values, std::size_t count,
+          decimal<ResultPrec, ResultRoundPolicy> &output) {
+    running_stats<Prec, RoundPolicy> stats;
+    stats.add(values, count);
+    return stats.mean(output);
+}
+
+/// Sample variance of array
+template<int Prec, class RoundPolicy, int ResultPrec, class ResultRoundPolicy>
+bool variance(const decimal<Prec, RoundPolicy> *values, std::size_t count,
+              decimal<ResultPrec, ResultRoundPolicy> &output) {
+    running_stats<Prec, RoundPolicy> stats;
+    stats.add(values, count);
+    return stats.variance(output);
+}
+
+/// Sample standard deviation of array
+template<int Prec, class RoundPolicy, int ResultPrec, class ResultRoundPolicy>
+bool stddev(const decimal<Prec, RoundPolicy> *values, std::size_t count,
+            decimal<ResultPrec, ResultRoundPolicy> &output) {
+    running_stats<Prec, RoundPolicy> stats;
+    stats.add(values, count);
+    return stats.stddev(output);
+}
+
+/// Volume weighted average price of trades
+template<int PricePrec, int QuantityPrec, class RoundPolicy, int ResultPrec, class ResultRoundPolicy>
+bool vwap(const decimal<PricePrec, RoundPolicy> *prices, const decimal<QuantityPrec, RoundPolicy> *quantities,
+          std::size_t count, decimal<ResultPrec, ResultRoundPolicy> &output) {
+    vwap_accumulator<PricePrec, QuantityPrec, RoundPolicy> accumulator;
+    accumulator.add(prices, quantities, count);
+    return accumulator.vwap(output);
+}
+
+/// Quantile of array, see exact_quantiles::quantile(). Array is not modified.
+template<int Prec, class RoundPolicy, int PPrec, class PRoundPolicy, int ResultPrec, class ResultRoundPolicy>
+bool quantile(const decimal<Prec, RoundPolicy> *values, std::size_t count, const decimal<PPrec, PRoundPolicy> &p,
+              decimal<ResultPrec, ResultRoundPolicy> &output) {
+    exact_quantiles<Prec, RoundPolicy> quantiles;
+    quantiles.add(values, count);
+    return quantiles.quantile(p, output);
+}
+
+/// Median of array, array is not modified.
+template<int Prec, class RoundPolicy, int ResultPrec, class ResultRoundPolicy>
+bool median(const decimal<Prec, RoundPolicy> *values, std::size_t count,
+            decimal<ResultPrec, ResultRoundPolicy> &output) {
+    exact_quantiles<Prec, RoundPolicy> quantiles;
+    quantiles.add(values, count);
+    return quantiles.median(output);
+}
+
+} // namespace
+
+#endif // _DECIMAL_STATISTICS_H__
@@ -0,0 +1,10 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal.cpp
+// Project:     decimal
+// Purpose:     Explicit instantiation of common decimal types, see
+//              DEC_EXTERN_TEMPLATES in decimal.h
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+#define DEC_INSTANTIATE_TEMPLATES
+#include "decimal.h"
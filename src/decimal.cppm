@@ -0,0 +1,103 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        decimal.cppm
+// Project:     decimal
+// Purpose:     C++20 module interface unit of decimal library
+// Licence:     BSD
+/////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// Description
+// ----------------------------------------------------------------------------
+/// \file decimal.cppm
+///
+/// Exports module "dec" with everything declared by decimal.h. Configuration
+/// macros (DEC_TYPE_LEVEL, DEC_EXTERNAL_INT64, DEC_NO_INT128 etc.) have to be
+/// given when the module is compiled, importers see them only as constants
+/// in namespace config, because macros are not exported.
+///
+/// Sample usage:
+///   import dec;
+///
+///   dec::decimal<2> value(143125);
+///   static_assert(dec::config::type_level == 2);
+
+module;
+
+// standard headers used by decimal.h, kept in global module fragment so that
+// they are not attached to module "dec"
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iosfwd>
+#include <istream>
+#include <limits>
+#include <locale>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+export module dec;
+
+export {
+#include "decimal.h"
+}
+
+export namespace DEC_NAMESPACE::config {
+
+/// Value of DEC_TYPE_LEVEL used to compile module
+inline constexpr int type_level = DEC_TYPE_LEVEL;
+/// True when compiler-provided 128-bit integers are used for wide intermediate results
+inline constexpr bool use_int128 = (DEC_USE_INT128 != 0);
+/// True when std::string_view overloads are available
+inline constexpr bool use_string_view = (DEC_USE_STRING_VIEW != 0);
+
+#ifdef DEC_ENABLE_STATS
+/// True when get_stats() counts slow paths and overflows
+inline constexpr bool stats_enabled = true;
+#else
+inline constexpr bool stats_enabled = false;
+#endif
+
+#ifdef DEC_EXTERNAL_INT64
+/// True when int64 is defined by user (DEC_INT64)
+inline constexpr bool external_int64 = true;
+#else
+inline constexpr bool external_int64 = false;
+#endif
+
+#ifdef DEC_EXTERNAL_ROUND
+/// True when rounding of def_round_policy is defined by user
+inline constexpr bool external_round = true;
+#else
+inline constexpr bool external_round = false;
+#endif
+
+#ifdef DEC_CROSS_DOUBLE
+/// True when double (instead of xdouble) is used for cross-conversions
+inline constexpr bool cross_double = true;
+#else
+inline constexpr bool cross_double = false;
+#endif
+
+/// True when operator<=> is provided (DEC_ALLOW_SPACESHIP_OPER)
+inline constexpr bool use_spaceship_oper = (DEC_USE_SPACESHIP_OPER != 0);
+
+#ifdef DEC_TRIVIAL_DEFAULT_CONSTRUCTIBLE
+/// True when default constructor does not initialize value
+inline constexpr bool trivial_default_constructible = true;
+#else
+inline constexpr bool trivial_default_constructible = false;
+#endif
+
+/// Replacements of DEC_MAX_INT64 and DEC_MIN_INT64
+inline constexpr int64 max_int64 = DEC_MAX_INT64;
+inline constexpr int64 min_int64 = DEC_MIN_INT64;
+
+} // namespace
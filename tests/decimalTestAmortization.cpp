@@ -0,0 +1,59 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal_amortization.h"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(decimalAnnuitySchedule)
+{
+    dec::annuity_plan<2, 8> plan(dec::decimal<8>("0.005"), 360);
+    dec::amortization_entry<2> rows[360];
+
+    BOOST_CHECK_EQUAL(plan.payment(dec::decimal<2>(100000)), dec::decimal<2>("599.55"));
+    BOOST_CHECK_EQUAL(plan.schedule(dec::decimal<2>(100000), rows), dec::decimal<2>("115838.45"));
+
+    BOOST_CHECK_EQUAL(rows[0].interest, dec::decimal<2>("500.00"));
+    BOOST_CHECK_EQUAL(rows[0].principal, dec::decimal<2>("99.55"));
+    BOOST_CHECK_EQUAL(rows[0].balance, dec::decimal<2>("99900.45"));
+    BOOST_CHECK_EQUAL(rows[359].payment, dec::decimal<2>("600.00"));
+    BOOST_CHECK_EQUAL(rows[359].balance, dec::decimal<2>(0));
+
+    dec::decimal<2> principalSum(0);
+    for (int i = 0; i < plan.periods(); ++i) {
+        principalSum += rows[i].principal;
+        BOOST_CHECK_EQUAL(rows[i].payment, rows[i].interest + rows[i].principal);
+    }
+    BOOST_CHECK_EQUAL(principalSum, dec::decimal<2>(100000));
+
+    dec::decimal<2> principals[2] = {dec::decimal<2>(100000), dec::decimal<2>(50000)};
+    dec::decimal<2> payments[2];
+    plan.payments(principals, payments, 2);
+    BOOST_CHECK_EQUAL(payments[0], dec::decimal<2>("599.55"));
+    BOOST_CHECK_EQUAL(payments[1], dec::decimal<2>("299.78"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalAnnuityZeroRate)
+{
+    dec::annuity_plan<2, 4> plan(dec::decimal<4>(0), 12);
+    dec::amortization_entry<2> rows[12];
+
+    BOOST_CHECK_EQUAL(plan.payment(dec::decimal<2>(1000)), dec::decimal<2>("83.33"));
+    BOOST_CHECK_EQUAL(plan.schedule(dec::decimal<2>(1000), rows), dec::decimal<2>(0));
+    BOOST_CHECK_EQUAL(rows[11].payment, dec::decimal<2>("83.37"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalCompoundInterest)
+{
+    dec::annuity_plan<2, 4> plan(dec::decimal<4>("0.01"), 12);
+    dec::decimal<2> balances[12];
+
+    BOOST_CHECK_EQUAL(plan.accrue(dec::decimal<2>(1000), balances), dec::decimal<2>("1126.84"));
+    BOOST_CHECK_EQUAL(balances[0], dec::decimal<2>("1010.00"));
+    BOOST_CHECK_EQUAL(balances[1], dec::decimal<2>("1020.10"));
+
+    dec::annuity_plan<2, 4, dec::floor_round_policy> floorPlan(dec::decimal<4, dec::floor_round_policy>("0.01"), 12);
+    dec::decimal<2, dec::floor_round_policy> floorBalances[12];
+    BOOST_CHECK_EQUAL(floorPlan.accrue(dec::decimal<2, dec::floor_round_policy>(1000), floorBalances),
+                      (dec::decimal<2, dec::floor_round_policy>("1126.78")));
+}
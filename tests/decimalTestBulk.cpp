@@ -0,0 +1,298 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal_bulk.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+
+    // values with all kinds of remainders, signs and magnitudes
+    std::vector<dec::int64> bulk_test_values() {
+        std::vector<dec::int64> result;
+        test_random random(1);
+        for (int i = 0; i < 2000; ++i) {
+            result.push_back(random.unbiased());
+        }
+        for (dec::int64 v = -1000; v <= 1000; ++v) {
+            result.push_back(v * 5);
+        }
+        result.push_back(DEC_MAX_INT64);
+        result.push_back(DEC_MIN_INT64);
+        result.push_back(DEC_MAX_INT64 - 3);
+        result.push_back(DEC_MIN_INT64 + 3);
+        return result;
+    }
+
+    template<int FromPrec, int ToPrec, class RoundPolicy>
+    void check_rescale() {
+        typedef dec::decimal<FromPrec, RoundPolicy> from_type;
+        typedef dec::decimal<ToPrec, RoundPolicy> to_type;
+
+        const std::vector<dec::int64> values = bulk_test_values();
+        const std::size_t count = values.size();
+        std::vector<from_type> input(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            input[i].setUnbiased(values[i]);
+        }
+
+        std::vector<to_type> output(count), expected(count);
+        bool *overflow = new bool[count];
+        bool *expectedOverflow = new bool[count];
+
+        const std::size_t failed = dec::rescale(&input[0], &output[0], count, overflow);
+        const std::size_t expectedFailed = dec::rescale_reference(&input[0], &expected[0], count, expectedOverflow);
+
+        BOOST_CHECK_EQUAL(failed, expectedFailed);
+        for (std::size_t i = 0; i < count; ++i) {
+            BOOST_CHECK_EQUAL(output[i].getUnbiased(), expected[i].getUnbiased());
+            BOOST_CHECK_EQUAL(overflow[i], expectedOverflow[i]);
+        }
+
+        delete[] overflow;
+        delete[] expectedOverflow;
+    }
+
+    template<class RoundPolicy>
+    void check_rescale_policy() {
+        check_rescale<6, 2, RoundPolicy>();
+        check_rescale<8, 0, RoundPolicy>();
+        check_rescale<1, 0, RoundPolicy>();
+        check_rescale<2, 6, RoundPolicy>();
+        check_rescale<4, 4, RoundPolicy>();
+    }
+
+    template<int Prec, int Prec2>
+    void check_compare() {
+        typedef dec::decimal<Prec> value_type;
+        typedef dec::decimal<Prec2> constant_type;
+
+        const std::vector<dec::int64> values = bulk_test_values();
+        const std::size_t count = values.size();
+        std::vector<value_type> input(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            input[i].setUnbiased(values[i]);
+        }
+
+        // constants from input, their neighbours and limits
+        std::vector<constant_type> constants;
+        for (std::size_t i = 0; i < count; i += 97) {
+            for (dec::int64 delta = -1; delta <= 1; ++delta) {
+                constant_type constant;
+                constant.setUnbiased(values[i] / 2 + delta);
+                constants.push_back(constant);
+            }
+        }
+        constants.push_back(constant_type(0));
+        constants.push_back(constant_type(5));
+
+        const std::size_t words = dec::bitmap_words(count);
+        std::vector<dec::bitmap_word> bitmap(words), expectedBitmap(words);
+        std::vector<std::size_t> rows(count), expectedRows(count);
+        const dec::compare_op ops[] = {dec::compare_less, dec::compare_less_equal, dec::compare_greater,
+                                       dec::compare_greater_equal, dec::compare_equal, dec::compare_not_equal};
+
+        for (std::size_t c = 0; c < constants.size(); ++c) {
+            for (std::size_t o = 0; o < sizeof(ops) / sizeof(ops[0]); ++o) {
+                const std::size_t selected = dec::compare(&input[0], count, ops[o], constants[c], &bitmap[0]);
+                BOOST_CHECK_EQUAL(selected, dec::compare_reference(&input[0], count, ops[o], constants[c],
+                                                                   &expectedBitmap[0]));
+                BOOST_CHECK(bitmap == expectedBitmap);
+
+                const std::size_t rowCount = dec::select(&input[0], count, ops[o], constants[c], &rows[0]);
+                BOOST_REQUIRE_EQUAL(rowCount, dec::select_reference(&input[0], count, ops[o], constants[c],
+                                                                    &expectedRows[0]));
+                BOOST_CHECK(std::equal(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(rowCount),
+                                       expectedRows.begin()));
+            }
+
+            const constant_type &high = constants[(c * 7) % constants.size()];
+            BOOST_CHECK_EQUAL(dec::compare_between(&input[0], count, constants[c], high, &bitmap[0]),
+                              dec::compare_between_reference(&input[0], count, constants[c], high,
+                                                             &expectedBitmap[0]));
+            BOOST_CHECK(bitmap == expectedBitmap);
+        }
+    }
+
+    // doubles with ties, all magnitudes, values near limits and not finite values
+    std::vector<double> bulk_test_doubles() {
+        std::vector<double> result;
+        test_random random(9);
+        for (int i = 0; i < 3000; ++i) {
+            const dec::details::uint64 bits = random.next();
+            const double mantissa = static_cast<double>(static_cast<dec::int64>(bits >> 11) - (1LL << 52));
+            result.push_back(std::ldexp(mantissa, static_cast<int>(bits % 90) - 95));
+        }
+        for (int v = -2000; v <= 2000; ++v) {
+            result.push_back(v / 8.0);
+            result.push_back(v / 1000.0);
+        }
+        result.push_back(9223372036854775807.0);
+        result.push_back(-9223372036854775808.0);
+        result.push_back(92233720368547758.0);
+        result.push_back(-92233720368547758.0);
+        result.push_back(9.2233720368547e16);
+        result.push_back(std::numeric_limits<double>::infinity());
+        result.push_back(-std::numeric_limits<double>::infinity());
+        result.push_back(std::numeric_limits<double>::quiet_NaN());
+        result.push_back(-0.0);
+        return result;
+    }
+
+    template<int Prec, class RoundPolicy>
+    void check_from_doubles() {
+        typedef dec::decimal<Prec, RoundPolicy> value_type;
+        const std::vector<double> input = bulk_test_doubles();
+        const std::size_t count = input.size();
+        std::vector<value_type> output(count), expected(count);
+        const std::size_t words = dec::bitmap_words(count);
+        std::vector<dec::bitmap_word> outOfRange(words), expectedOutOfRange(words);
+
+        const std::size_t failed = dec::from_doubles(&input[0], &output[0], count, &outOfRange[0]);
+        BOOST_CHECK_EQUAL(failed, dec::from_doubles_reference(&input[0], &expected[0], count,
+                                                              &expectedOutOfRange[0]));
+        BOOST_CHECK(outOfRange == expectedOutOfRange);
+        for (std::size_t i = 0; i < count; ++i) {
+            BOOST_CHECK_EQUAL(output[i].getUnbiased(), expected[i].getUnbiased());
+        }
+
+        std::vector<double> doubles(count), expectedDoubles(count);
+        dec::to_doubles(&output[0], &doubles[0], count);
+        dec::to_doubles_reference(&output[0], &expectedDoubles[0], count);
+        BOOST_CHECK(doubles == expectedDoubles);
+    }
+
+    template<class RoundPolicy>
+    void check_from_doubles_policy() {
+        check_from_doubles<0, RoundPolicy>();
+        check_from_doubles<2, RoundPolicy>();
+        check_from_doubles<4, RoundPolicy>();
+        check_from_doubles<9, RoundPolicy>();
+        check_from_doubles<18, RoundPolicy>();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(decimalRescale)
+{
+    dec::decimal<4> input[4] = {dec::decimal<4>("1.2345"), dec::decimal<4>("-1.2355"),
+                                dec::decimal<4>("0.0050"), dec::decimal<4>("-0.0049")};
+    dec::decimal<2> output[4];
+    BOOST_CHECK_EQUAL(dec::rescale(input, output, 4), 0u);
+    BOOST_CHECK_EQUAL(output[0], dec::decimal<2>("1.23"));
+    BOOST_CHECK_EQUAL(output[1], dec::decimal<2>("-1.24"));
+    BOOST_CHECK_EQUAL(output[2], dec::decimal<2>("0.01"));
+    BOOST_CHECK_EQUAL(output[3], dec::decimal<2>("0"));
+
+    dec::decimal<2> small[2] = {dec::decimal<2>("92233720368.54"), dec::decimal<2>("-1.5")};
+    dec::decimal<10> wide[2];
+    bool overflow[2];
+    BOOST_CHECK_EQUAL(dec::rescale(small, wide, 2, overflow), 1u);
+    BOOST_CHECK(overflow[0]);
+    BOOST_CHECK(!overflow[1]);
+    BOOST_CHECK_EQUAL(wide[0], dec::decimal<10>(0));
+    BOOST_CHECK_EQUAL(wide[1], dec::decimal<10>("-1.5"));
+
+    dec::int64 raw[3] = {12345, -12355, 5};
+    BOOST_CHECK_EQUAL((dec::rescale_unbiased<3, 1, dec::half_even_round_policy>(raw, raw, 3)), 0u);
+    BOOST_CHECK_EQUAL(raw[0], 123);
+    BOOST_CHECK_EQUAL(raw[1], -124);
+    BOOST_CHECK_EQUAL(raw[2], 0);
+}
+
+BOOST_AUTO_TEST_CASE(decimalRescaleMatchesReference)
+{
+    check_rescale_policy<dec::def_round_policy>();
+    check_rescale_policy<dec::null_round_policy>();
+    check_rescale_policy<dec::half_down_round_policy>();
+    check_rescale_policy<dec::half_up_round_policy>();
+    check_rescale_policy<dec::half_even_round_policy>();
+    check_rescale_policy<dec::ceiling_round_policy>();
+    check_rescale_policy<dec::floor_round_policy>();
+    check_rescale_policy<dec::round_down_round_policy>();
+    check_rescale_policy<dec::round_up_round_policy>();
+}
+
+BOOST_AUTO_TEST_CASE(decimalCompare)
+{
+    dec::decimal<2> prices[5] = {dec::decimal<2>("99.99"), dec::decimal<2>("100"), dec::decimal<2>("100.5"),
+                                 dec::decimal<2>("101"), dec::decimal<2>("101.01")};
+    dec::decimal<0> quantities[5] = {dec::decimal<0>(10), dec::decimal<0>(1), dec::decimal<0>(6),
+                                     dec::decimal<0>(7), dec::decimal<0>(20)};
+    dec::bitmap_word selected[1], byQuantity[1];
+
+    BOOST_CHECK_EQUAL(dec::compare_between(prices, 5, dec::decimal<0>(100), dec::decimal<0>(101), selected), 3u);
+    BOOST_CHECK_EQUAL(selected[0], 0xEu);
+    BOOST_CHECK_EQUAL(dec::compare(quantities, 5, dec::compare_greater, dec::decimal<0>(5), byQuantity), 4u);
+    dec::bitmap_and(selected, byQuantity, selected, dec::bitmap_words(5));
+
+    std::size_t rows[5];
+    BOOST_REQUIRE_EQUAL(dec::bitmap_to_indexes(selected, dec::bitmap_words(5), rows), 2u);
+    BOOST_CHECK_EQUAL(rows[0], 2u);
+    BOOST_CHECK_EQUAL(rows[1], 3u);
+
+    // constant with higher precision is not rounded
+    BOOST_CHECK_EQUAL(dec::compare(prices, 5, dec::compare_less, dec::decimal<4>("100.0001"), selected), 2u);
+    BOOST_CHECK_EQUAL(dec::compare(prices, 5, dec::compare_equal, dec::decimal<4>("100.5000"), selected), 1u);
+    BOOST_CHECK_EQUAL(dec::compare(prices, 5, dec::compare_equal, dec::decimal<4>("100.5001"), selected), 0u);
+    BOOST_CHECK_EQUAL(dec::compare(prices, 5, dec::compare_not_equal, dec::decimal<4>("100.5001"), selected), 5u);
+    BOOST_CHECK_EQUAL(selected[0], 0x1Fu);
+    BOOST_CHECK_EQUAL(dec::select(prices, 5, dec::compare_greater_equal, dec::decimal<4>("100.4999"), rows), 3u);
+    BOOST_CHECK_EQUAL(rows[0], 2u);
+}
+
+BOOST_AUTO_TEST_CASE(decimalCompareMatchesReference)
+{
+    check_compare<2, 2>();
+    check_compare<2, 4>();
+    check_compare<4, 2>();
+    check_compare<0, 18>();
+    check_compare<18, 0>();
+    check_compare<6, 9>();
+}
+
+BOOST_AUTO_TEST_CASE(decimalFromDoubles)
+{
+    const double input[] = {1.005, -2.5, 0.125, -0.125, 1e300, std::numeric_limits<double>::quiet_NaN(), 12.345};
+    dec::decimal<2> output[7];
+    dec::bitmap_word outOfRange[1];
+    BOOST_CHECK_EQUAL(dec::from_doubles(input, output, 7, outOfRange), 2u);
+    BOOST_CHECK_EQUAL(outOfRange[0], 0x30u);
+    BOOST_CHECK_EQUAL(output[0], dec::decimal<2>(1.005));
+    BOOST_CHECK_EQUAL(output[1], dec::decimal<2>("-2.5"));
+    BOOST_CHECK_EQUAL(output[2], dec::decimal<2>("0.13"));
+    BOOST_CHECK_EQUAL(output[3], dec::decimal<2>("-0.13"));
+    BOOST_CHECK_EQUAL(output[4], dec::decimal<2>(0));
+    BOOST_CHECK_EQUAL(output[6], dec::decimal<2>("12.35"));
+
+    dec::decimal<2, dec::half_even_round_policy> even[7];
+    BOOST_CHECK_EQUAL(dec::from_doubles(input, even, 7), 2u);
+    BOOST_CHECK_EQUAL(even[2], (dec::decimal<2, dec::half_even_round_policy>("0.12")));
+
+    dec::int64 unbiased[7];
+    BOOST_CHECK_EQUAL((dec::from_doubles_unbiased<2, dec::floor_round_policy>(input, unbiased, 7)), 2u);
+    BOOST_CHECK_EQUAL(unbiased[3], -13);
+
+    double doubles[7];
+    dec::to_doubles(output, doubles, 7);
+    BOOST_CHECK_EQUAL(doubles[1], -2.5);
+    dec::to_doubles_unbiased<2>(unbiased, doubles, 7);
+    BOOST_CHECK_EQUAL(doubles[3], -0.13);
+}
+
+BOOST_AUTO_TEST_CASE(decimalFromDoublesMatchesReference)
+{
+    check_from_doubles_policy<dec::def_round_policy>();
+    check_from_doubles_policy<dec::null_round_policy>();
+    check_from_doubles_policy<dec::half_down_round_policy>();
+    check_from_doubles_policy<dec::half_up_round_policy>();
+    check_from_doubles_policy<dec::half_even_round_policy>();
+    check_from_doubles_policy<dec::ceiling_round_policy>();
+    check_from_doubles_policy<dec::floor_round_policy>();
+    check_from_doubles_policy<dec::round_down_round_policy>();
+    check_from_doubles_policy<dec::round_up_round_policy>();
+}
@@ -0,0 +1,130 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal_column.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+namespace {
+
+    typedef dec::decimal<4> value_type;
+    typedef dec::compressed_column<4> column_type;
+
+    value_type make_value(dec::int64 unbiased) {
+        value_type result;
+        result.setUnbiased(unbiased);
+        return result;
+    }
+
+    // checks every access path against source values
+    void check_column(test_random &random, const std::vector<value_type> &values) {
+        const column_type column(values.empty() ? NULL : &values[0], values.size());
+        BOOST_REQUIRE_EQUAL(column.size(), values.size());
+
+        std::vector<value_type> output(values.size());
+        if (!values.empty()) {
+            column.decompress(&output[0]);
+        }
+        BOOST_CHECK(output == values);
+
+        dec::details::uint64 sum = 0;
+        value_type minValue = values.empty() ? value_type(0) : values[0];
+        value_type maxValue = minValue;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            BOOST_CHECK_EQUAL(column[i], values[i]);
+            sum += static_cast<dec::details::uint64>(values[i].getUnbiased());
+            minValue = std::min(minValue, values[i]);
+            maxValue = std::max(maxValue, values[i]);
+        }
+        BOOST_CHECK_EQUAL(column.sum().getUnbiased(), static_cast<dec::int64>(sum));
+        BOOST_CHECK_EQUAL(column.min(), minValue);
+        BOOST_CHECK_EQUAL(column.max(), maxValue);
+
+        for (int range = 0; range < 20 && !values.empty(); ++range) {
+            value_type low = values[static_cast<std::size_t>(random.below(static_cast<dec::int64>(values.size())))];
+            value_type high = values[static_cast<std::size_t>(random.below(static_cast<dec::int64>(values.size())))];
+            if (range % 4 == 1 && low.getUnbiased() > DEC_MIN_INT64 && high.getUnbiased() < DEC_MAX_INT64) {
+                low -= make_value(1);
+                high += make_value(1);
+            }
+            std::vector<std::size_t> expected;
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                if (values[i] >= low && values[i] <= high) {
+                    expected.push_back(i);
+                }
+            }
+            std::vector<std::size_t> rows;
+            BOOST_CHECK_EQUAL(column.filter_range(low, high, rows), expected.size());
+            BOOST_CHECK(rows == expected);
+        }
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(decimalColumnFrameOfReference)
+{
+    // tick-aligned prices: factor 25 (0.0025), small range
+    test_random random(3);
+    std::vector<value_type> values;
+    dec::int64 price = 1000000;
+    for (int i = 0; i < 5000; ++i) {
+        price += (random.below(9) - 4) * 25;
+        values.push_back(make_value(price));
+    }
+    check_column(random, values);
+
+    const column_type column(&values[0], values.size());
+    BOOST_CHECK_EQUAL(column.block_count(), 5u);
+    BOOST_CHECK(!column.is_dictionary(0));
+    // few bits per value instead of 64
+    BOOST_CHECK_LT(column.memory_size(), values.size() * sizeof(dec::int64) / 4);
+}
+
+BOOST_AUTO_TEST_CASE(decimalColumnDictionary)
+{
+    // few distinct, widely spread values
+    const dec::int64 levels[] = {-DEC_MAX_INT64, -5, 0, 7, 123456789, DEC_MAX_INT64};
+    test_random random(5);
+    std::vector<value_type> values;
+    for (int i = 0; i < 3000; ++i) {
+        values.push_back(make_value(levels[random.below(6)]));
+    }
+    check_column(random, values);
+
+    const column_type column(&values[0], values.size());
+    BOOST_CHECK(column.is_dictionary(0));
+    BOOST_CHECK(column.is_dictionary(2));
+}
+
+BOOST_AUTO_TEST_CASE(decimalColumnEdgeCases)
+{
+    test_random random(7);
+    std::vector<value_type> values;
+    check_column(random, values);
+    const column_type empty;
+    BOOST_CHECK(empty.empty());
+    BOOST_CHECK_EQUAL(empty.sum(), value_type(0));
+
+    // one value, constant block, partial last block
+    values.push_back(make_value(42));
+    check_column(random, values);
+    values.assign(1500, make_value(-17));
+    check_column(random, values);
+
+    // full 64-bit range, all distinct
+    values.clear();
+    for (int i = 0; i < 2100; ++i) {
+        values.push_back(make_value((i % 3 == 0) ? DEC_MIN_INT64 : (i % 3 == 1 ? DEC_MAX_INT64 :
+                                    static_cast<dec::int64>(random.next()))));
+    }
+    check_column(random, values);
+
+    // random values with varying width
+    values.clear();
+    for (int i = 0; i < 4096; ++i) {
+        values.push_back(make_value(random.below(static_cast<dec::int64>(1) << (i / 128 + 1)) - 1000));
+    }
+    check_column(random, values);
+}
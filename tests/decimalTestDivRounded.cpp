@@ -0,0 +1,91 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+    // counts differences, so that failure report is short
+    template<class RoundPolicy>
+    int compare_div(dec::int64 a, dec::int64 b) {
+        dec::int64 output = 1, expected = 1;
+        const bool ok = RoundPolicy::div_rounded(output, a, b);
+        const bool expectedOk = RoundPolicy::div_rounded_reference(expected, a, b);
+        if (ok != expectedOk || (ok && output != expected)) {
+            BOOST_TEST_MESSAGE("div_rounded(" << a << ", " << b << ") = " << output << ", expected " << expected);
+            return 1;
+        }
+        return 0;
+    }
+
+    template<class RoundPolicy>
+    int compare_small_range() {
+        int errors = 0;
+        for (dec::int64 b = -64; b <= 64; ++b) {
+            if (b == 0) {
+                continue;
+            }
+            for (dec::int64 a = -4096; a <= 4096; ++a) {
+                errors += compare_div<RoundPolicy>(a, b);
+            }
+        }
+        return errors;
+    }
+
+    template<class RoundPolicy>
+    int compare_large_range() {
+        int errors = 0;
+        test_random random(1);
+        for (int i = 0; i < 200000; ++i) {
+            const dec::int64 a = random.unbiased();
+            dec::int64 b = random.unbiased();
+            if (b == 0) {
+                b = 1;
+            }
+            errors += compare_div<RoundPolicy>(a, b);
+            // divisors used by rescaling, with values near limits
+            const dec::int64 factor = dec::dec_utils<dec::def_round_policy>::pow10(i % 19);
+            errors += compare_div<RoundPolicy>(a, factor);
+            errors += compare_div<RoundPolicy>(DEC_MAX_INT64 - (a & 0xffff), factor);
+            errors += compare_div<RoundPolicy>(DEC_MIN_INT64 + (a & 0xffff), factor);
+        }
+        const dec::int64 limits[] = {DEC_MIN_INT64, DEC_MIN_INT64 + 1, -1, 0, 1, DEC_MAX_INT64 - 1, DEC_MAX_INT64};
+        const std::size_t count = sizeof(limits) / sizeof(limits[0]);
+        for (std::size_t i = 0; i < count; ++i) {
+            for (std::size_t j = 0; j < count; ++j) {
+                if (limits[j] != 0) {
+                    errors += compare_div<RoundPolicy>(limits[i], limits[j]);
+                }
+            }
+        }
+        return errors;
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalDivRoundedSmallRange)
+{
+    using namespace dec;
+    BOOST_CHECK_EQUAL(compare_small_range<def_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_small_range<half_down_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_small_range<half_up_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_small_range<half_even_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_small_range<ceiling_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_small_range<floor_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_small_range<round_up_round_policy>(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(decimalDivRoundedLargeRange)
+{
+    using namespace dec;
+    BOOST_CHECK_EQUAL(compare_large_range<def_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_large_range<half_down_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_large_range<half_up_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_large_range<half_even_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_large_range<ceiling_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_large_range<floor_round_policy>(), 0);
+    BOOST_CHECK_EQUAL(compare_large_range<round_up_round_policy>(), 0);
+}
@@ -0,0 +1,107 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <string>
+
+namespace {
+
+    // field "-?\d{1,maxInt}(\.\d{0,maxFrac})?"
+    std::string random_field(test_random &random, int maxInt, int maxFrac, char point) {
+        std::string result;
+        if (random.below(2) == 0) {
+            result += '-';
+        }
+        const int intDigits = 1 + static_cast<int>(random.below(maxInt));
+        for (int i = 0; i < intDigits; ++i) {
+            result += static_cast<char>('0' + static_cast<int>(random.below(10)));
+        }
+        if (random.below(4) != 0) {
+            result += point;
+            const int fracDigits = static_cast<int>(random.below(maxFrac + 1));
+            for (int i = 0; i < fracDigits; ++i) {
+                // more fives and zeros to hit ties
+                const int r = static_cast<int>(random.below(14));
+                result += static_cast<char>(r < 10 ? '0' + r : (r < 12 ? '5' : '0'));
+            }
+        }
+        return result;
+    }
+
+    template<typename T>
+    void check_same_as_stream(test_random &random, int maxInt, int maxFrac, const dec::basic_decimal_format &format) {
+        for (int i = 0; i < 3000; ++i) {
+            const std::string field = random_field(random, maxInt, maxFrac, format.decimal_point());
+            std::istringstream input(field);
+            T expected;
+            if (!dec::fromStream(input, format, expected)) {
+                expected.setUnbiased(0);
+            }
+            BOOST_CHECK_EQUAL(dec::fromString<T>(field.data(), field.size(), format), expected);
+        }
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalFastParseAccepts)
+{
+    using namespace dec;
+    int sign, afterDigits;
+    int64 before, after;
+
+    BOOST_CHECK(details::parse_fixed("-9999999999.99999999", 20, '.', sign, before, after, afterDigits));
+    BOOST_CHECK_EQUAL(sign, -1);
+    BOOST_CHECK_EQUAL(before, -9999999999LL);
+    BOOST_CHECK_EQUAL(after, -99999999LL);
+    BOOST_CHECK_EQUAL(afterDigits, 8);
+
+    BOOST_CHECK(details::parse_fixed("123456789012345.000000000000001", 31, '.', sign, before, after, afterDigits));
+    BOOST_CHECK_EQUAL(before, 123456789012345LL);
+    BOOST_CHECK_EQUAL(after, 1);
+    BOOST_CHECK_EQUAL(afterDigits, 15);
+
+    BOOST_CHECK(details::parse_fixed("+7,5", 4, ',', sign, before, after, afterDigits));
+    BOOST_CHECK_EQUAL(before, 7);
+    BOOST_CHECK_EQUAL(after, 5);
+
+    BOOST_CHECK(details::parse_fixed("12.", 3, '.', sign, before, after, afterDigits));
+    BOOST_CHECK_EQUAL(afterDigits, 0);
+
+    // unusual input is left for stream parser
+    const char *rejected[] = { "", "-", ".5", " 1.5", "1.5 ", "1,234.5", "1.2.3", "1e5", "12a",
+                               "1234567890123456.5", "1.1234567890123456", "1.5\0" };
+    for (std::size_t i = 0; i < sizeof(rejected) / sizeof(rejected[0]); ++i) {
+        const std::size_t size = (i + 1 == sizeof(rejected) / sizeof(rejected[0])) ? 4 : std::strlen(rejected[i]);
+        BOOST_CHECK(!details::parse_fixed(rejected[i], size, '.', sign, before, after, afterDigits));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(decimalFastParseSameAsStream)
+{
+    using namespace dec;
+    const basic_decimal_format format;
+    test_random random(5);
+    check_same_as_stream<decimal<0> >(random, 15, 15, format);
+    check_same_as_stream<decimal<2> >(random, 15, 15, format);
+    check_same_as_stream<decimal<4> >(random, 12, 15, format);
+    check_same_as_stream<decimal<8> >(random, 10, 15, format);
+    check_same_as_stream<decimal<2, half_even_round_policy> >(random, 15, 10, format);
+    check_same_as_stream<decimal<2, floor_round_policy> >(random, 15, 10, format);
+    check_same_as_stream<decimal<3, ceiling_round_policy> >(random, 15, 10, format);
+    check_same_as_stream<decimal<3, round_down_round_policy> >(random, 15, 10, format);
+    check_same_as_stream<decimal<4> >(random, 12, 15, decimal_format(',', '.'));
+}
+
+BOOST_AUTO_TEST_CASE(decimalFastParseFallback)
+{
+    using namespace dec;
+    const decimal_format grouped('.', ',', true);
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >("1,234.567", 9, grouped), decimal<2>("1234.57"));
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >("  -1.255", 8, grouped), decimal<2>("-1.26"));
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >("12345678901234567.5", 19, grouped), decimal<2>("12345678901234567.5"));
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >("abc", 3, grouped), decimal<2>(0));
+}
@@ -0,0 +1,86 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include <fmt/format.h>
+#include "decimal_fmt.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+    struct grouped_punct : std::numpunct<char> {
+        char do_thousands_sep() const { return '.'; }
+        std::string do_grouping() const { return "\3"; }
+        char do_decimal_point() const { return ','; }
+    };
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalFmtDefault)
+{
+    using namespace dec;
+    BOOST_CHECK_EQUAL(fmt::format("{}", decimal<4>("12345.6789")), "12345.6789");
+    BOOST_CHECK_EQUAL(fmt::format("{}", decimal<2>("-0.05")), "-0.05");
+    BOOST_CHECK_EQUAL(fmt::format("{}", decimal<0>(42)), "42");
+    BOOST_CHECK_EQUAL(fmt::format("a={} b={}", decimal<2>(1), decimal<3>("2.5")), "a=1.00 b=2.500");
+
+    // the same as toString for all kinds of values
+    test_random random(11);
+    for (int i = 0; i < 200; ++i) {
+        decimal<6> value;
+        value.setUnbiased(random.unbiased());
+        BOOST_CHECK_EQUAL(fmt::format("{}", value), toString(value, basic_decimal_format()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(decimalFmtAlignment)
+{
+    using namespace dec;
+    const decimal<2> value("-1.5");
+    BOOST_CHECK_EQUAL(fmt::format("[{:8}]", value), "[   -1.50]");
+    BOOST_CHECK_EQUAL(fmt::format("[{:<8}]", value), "[-1.50   ]");
+    BOOST_CHECK_EQUAL(fmt::format("[{:*^9}]", value), "[**-1.50**]");
+    BOOST_CHECK_EQUAL(fmt::format("[{:08}]", value), "[-0001.50]");
+    BOOST_CHECK_EQUAL(fmt::format("[{:2}]", value), "[-1.50]");
+    BOOST_CHECK_EQUAL(fmt::format("[{:+}] [{: }] [{:+}]", decimal<1>(2), decimal<1>(2), value), "[+2.0] [ 2.0] [-1.50]");
+}
+
+BOOST_AUTO_TEST_CASE(decimalFmtPrecision)
+{
+    using namespace dec;
+    BOOST_CHECK_EQUAL(fmt::format("{:.2}", decimal<4>("2.1250")), "2.13");
+    BOOST_CHECK_EQUAL(fmt::format("{:.2}", decimal<4, half_even_round_policy>("2.1250")), "2.12");
+    BOOST_CHECK_EQUAL(fmt::format("{:.2}", decimal<4, floor_round_policy>("-2.1201")), "-2.13");
+    BOOST_CHECK_EQUAL(fmt::format("{:.0}", decimal<4>("-0.4999")), "0");
+    BOOST_CHECK_EQUAL(fmt::format("{:.4}", decimal<2>("1.5")), "1.5000");
+    BOOST_CHECK_EQUAL(fmt::format("{:.2}", decimal<0>(7)), "7.00");
+    BOOST_CHECK_EQUAL(fmt::format("{:>10,.1}", decimal<3>("1234567.891")), "1,234,567.9");
+    BOOST_CHECK_EQUAL(fmt::format("{:>12,.2}", decimal<4>("12345.6789")), "   12,345.68");
+}
+
+BOOST_AUTO_TEST_CASE(decimalFmtExponent)
+{
+    using namespace dec;
+    BOOST_CHECK_EQUAL(fmt::format("{:e}", decimal<5>("0.00125")), "1.25e-3");
+    BOOST_CHECK_EQUAL(fmt::format("{:.4e}", decimal<5>("0.00125")), "1.3e-3");
+    BOOST_CHECK_EQUAL(fmt::format("[{:>10e}]", decimal<2>(-600000)), "[      -6e5]");
+    BOOST_CHECK_EQUAL(fmt::format("[{:+08e}]", decimal<2>(600000)), "[+00006e5]");
+    BOOST_CHECK_EQUAL(fmt::format("{:e}", decimal<2>(0)), "0e0");
+}
+
+BOOST_AUTO_TEST_CASE(decimalFmtLocale)
+{
+    using namespace dec;
+    const std::locale locale(std::locale::classic(), new grouped_punct);
+    BOOST_CHECK_EQUAL(fmt::format(locale, "{:L}", decimal<2>("-1234567.5")), "-1.234.567,50");
+    BOOST_CHECK_EQUAL(fmt::format(locale, "{}", decimal<2>("-1234567.5")), "-1234567.50");
+    BOOST_CHECK_EQUAL(fmt::format(std::locale::classic(), "{:,L}", decimal<2>("1234.5")), "1,234.50");
+}
+
+BOOST_AUTO_TEST_CASE(decimalFmtInvalidSpec)
+{
+    using namespace dec;
+    BOOST_CHECK_THROW(fmt::format(fmt::runtime("{:x}"), decimal<2>(1)), fmt::format_error);
+    BOOST_CHECK_THROW(fmt::format(fmt::runtime("{:.}"), decimal<2>(1)), fmt::format_error);
+}
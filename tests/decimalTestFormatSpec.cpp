@@ -0,0 +1,109 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <type_traits>
+
+namespace {
+
+    DEC_CONSTEXPR dec::format_spec german_spec = {',', '.', true, {3}};
+    DEC_CONSTEXPR dec::format_spec indian_spec = {'.', ',', true, {3, 2}};
+
+    static_assert(std::is_trivially_copyable<dec::format_spec>::value, "format_spec must be trivially copyable");
+    static_assert(!std::is_polymorphic<dec::format_spec>::value, "format_spec must not have virtual functions");
+
+    template<const dec::format_spec &Format>
+    struct fixed_format_printer {
+        template<class T>
+        static std::string print(const T &value) {
+            return dec::toString(value, Format);
+        }
+    };
+
+    struct grouped_punct : std::numpunct<char> {
+        char do_thousands_sep() const { return ' '; }
+        std::string do_grouping() const { return "\3\2"; }
+        char do_decimal_point() const { return ','; }
+    };
+
+    void check_same_as_format(const dec::decimal_format &format) {
+        const dec::format_spec spec = format.spec();
+        test_random random(11);
+        for (int i = 0; i < 300; ++i) {
+            dec::decimal<4> value;
+            value.setUnbiased(random.unbiased());
+
+            const std::string text = dec::toString(value, spec);
+            BOOST_CHECK_EQUAL(text, dec::toString(value, format));
+            std::ostringstream stream;
+            dec::toStream(value, spec, stream);
+            BOOST_CHECK_EQUAL(stream.str(), text);
+            BOOST_CHECK_EQUAL(dec::toStringWithExponent(value, spec), dec::toStringWithExponent(value, format));
+
+            dec::decimal<4> parsed;
+            BOOST_CHECK(dec::fromString(text.data(), text.size(), spec, parsed));
+            BOOST_CHECK_EQUAL(parsed, value);
+            BOOST_CHECK_EQUAL(dec::fromString<dec::decimal<4> >(text, spec),
+                              dec::fromString<dec::decimal<4> >(text, format));
+        }
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalFormatSpecConstant)
+{
+    using namespace dec;
+    BOOST_CHECK_EQUAL(toString(decimal<2>("-1234567.5"), german_spec), "-1.234.567,50");
+    BOOST_CHECK_EQUAL(toString(decimal<2>("1234567.5"), indian_spec), "12,34,567.50");
+    BOOST_CHECK_EQUAL(fixed_format_printer<german_spec>::print(decimal<1>("1000")), "1.000,0");
+    BOOST_CHECK_EQUAL(fixed_format_printer<indian_spec>::print(decimal<0>("100000")), "1,00,000");
+
+    BOOST_CHECK_EQUAL(decimal<2>("1.234,5", german_spec), decimal<2>("1234.5"));
+    BOOST_CHECK_EQUAL(decimal<2>(std::string("12,34,567.25"), indian_spec), decimal<2>("1234567.25"));
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >("-0,05", german_spec), decimal<2>("-0.05"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalFormatSpecSameAsFormat)
+{
+    check_same_as_format(dec::decimal_format(','));
+    check_same_as_format(dec::decimal_format(',', '.'));
+    check_same_as_format(dec::decimal_format('.', ' ', true, "\3\2"));
+    check_same_as_format(dec::decimal_format('.', '\'', true, "\1"));
+    check_same_as_format(dec::decimal_format('.', ',', true, "\4\3\2\1"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalFormatSpecConversions)
+{
+    using namespace dec;
+    const format_spec plain = basic_decimal_format().spec();
+    BOOST_CHECK_EQUAL(plain.decimal_point, '.');
+    BOOST_CHECK(!plain.thousands_grouping);
+    BOOST_CHECK_EQUAL(grouping_string(plain), "");
+
+    // grouping longer than max_grouping is truncated
+    const decimal_format format('.', ',', true, "\1\1\1\1\1\1\1\1\1\1\2");
+    BOOST_CHECK_EQUAL(grouping_string(format.spec()), "\1\1\1\1\1\1\1\1");
+    BOOST_CHECK_EQUAL(format.grouping(), "\1\1\1\1\1\1\1\1");
+    BOOST_CHECK_EQUAL(grouping_string(make_format_spec(',', '.')), "\3");
+
+    const decimal_format copy(indian_spec);
+    BOOST_CHECK_EQUAL(copy.thousands_sep(), ',');
+    BOOST_CHECK_EQUAL(copy.grouping(), "\3\2");
+
+    std::istringstream input("1 23 456,75");
+    input.imbue(std::locale(std::locale::classic(), new grouped_punct));
+    const format_spec fromStream = format_spec_from_stream(input);
+    BOOST_CHECK_EQUAL(fromStream.decimal_point, ',');
+    BOOST_CHECK_EQUAL(fromStream.thousands_sep, ' ');
+    BOOST_CHECK(fromStream.thousands_grouping);
+    BOOST_CHECK_EQUAL(grouping_string(fromStream), "\3\2");
+    BOOST_CHECK_EQUAL(grouping_string(format_from_stream(input).spec()), "\3\2");
+
+    decimal<2> value;
+    BOOST_CHECK(dec::fromStream(input, fromStream, value));
+    BOOST_CHECK_EQUAL(value, decimal<2>("123456.75"));
+}
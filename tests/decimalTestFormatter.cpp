@@ -0,0 +1,156 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+    std::vector<dec::int64> formatter_test_values() {
+        std::vector<dec::int64> result;
+        test_random random(3);
+        for (int i = 0; i < 500; ++i) {
+            result.push_back(random.unbiased());
+        }
+        for (dec::int64 v = -120; v <= 120; ++v) {
+            result.push_back(v);
+        }
+        result.push_back(DEC_MAX_INT64);
+        result.push_back(DEC_MIN_INT64 + 1);
+        return result;
+    }
+
+    // digits before decimal point grouped by std::num_put with numpunct of format
+    template<int Prec>
+    std::string stream_reference(const dec::decimal<Prec> &value, const dec::basic_decimal_format &format) {
+        dec::int64 before, after;
+        value.unpack(before, after);
+        std::ostringstream output;
+        output.imbue(std::locale(std::locale::classic(), new dec::decimal_format_punct(format)));
+        if (value.getUnbiased() < 0) {
+            output << '-';
+        }
+        output << dec::details::abs_unsigned(before);
+        if (Prec > 0) {
+            output.imbue(std::locale::classic());
+            output << format.decimal_point() << std::setw(Prec) << std::setfill('0')
+                   << dec::details::abs_unsigned(after);
+        }
+        return output.str();
+    }
+
+    template<int Prec>
+    void check_same_as_stream(const dec::basic_decimal_format &format) {
+        const dec::decimal_formatter formatter(format);
+        const std::vector<dec::int64> values = formatter_test_values();
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            dec::decimal<Prec> value;
+            value.setUnbiased(values[i]);
+            const std::string expected = stream_reference(value, format);
+            BOOST_CHECK_EQUAL(formatter.toString(value), expected);
+            std::ostringstream output;
+            dec::toStream(value, format, output);
+            BOOST_CHECK_EQUAL(output.str(), expected);
+        }
+    }
+
+    template<int Prec>
+    void check_formats() {
+        check_same_as_stream<Prec>(dec::basic_decimal_format());
+        check_same_as_stream<Prec>(dec::decimal_format(','));
+        check_same_as_stream<Prec>(dec::decimal_format(',', '.'));
+        check_same_as_stream<Prec>(dec::decimal_format('.', ' ', true, "\3\2"));
+        check_same_as_stream<Prec>(dec::decimal_format('.', '\'', true, "\1"));
+        check_same_as_stream<Prec>(dec::decimal_format('.', ',', true, "\4\3\2\1"));
+    }
+
+    struct grouped_punct : std::numpunct<char> {
+        char do_thousands_sep() const { return '.'; }
+        std::string do_grouping() const { return "\3"; }
+        char do_decimal_point() const { return ','; }
+    };
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalFormatterSameAsStream)
+{
+    check_formats<0>();
+    check_formats<1>();
+    check_formats<2>();
+    check_formats<4>();
+    check_formats<9>();
+    check_formats<18>();
+}
+
+BOOST_AUTO_TEST_CASE(decimalFormatterBuffer)
+{
+    using namespace dec;
+    const decimal_formatter formatter(decimal_format(',', '.'));
+
+    char buffer[decimal_formatter::max_chars + 1];
+    *formatter.format(decimal<2>("-1234567.05"), buffer) = '\0';
+    BOOST_CHECK_EQUAL(std::string(buffer), "-1.234.567,05");
+
+    decimal<0> lowest;
+    lowest.setUnbiased(DEC_MIN_INT64);
+    const decimal_formatter grouped1(decimal_format('.', ',', true, "\1"));
+    char *end = grouped1.format(lowest, buffer);
+    BOOST_CHECK(end - buffer <= decimal_formatter::max_chars);
+    BOOST_CHECK_EQUAL(std::string(buffer, end), "-9,2,2,3,3,7,2,0,3,6,8,5,4,7,7,5,8,0,8");
+
+    BOOST_CHECK_EQUAL(decimal_formatter().toString(decimal<3>("-0.5")), "-0.500");
+    BOOST_CHECK_EQUAL(decimal_formatter().toString(decimal<3>(0)), "0.000");
+}
+
+BOOST_AUTO_TEST_CASE(decimalFormatterAppend)
+{
+    using namespace dec;
+    const decimal_formatter formatter;
+
+    std::string output;
+    output.reserve(256);
+    const std::string::size_type capacity = output.capacity();
+    for (int i = 0; i < 10; ++i) {
+        formatter.append(decimal<2>(i), output);
+        output += ';';
+    }
+    BOOST_CHECK_EQUAL(output.capacity(), capacity);
+    BOOST_CHECK_EQUAL(output.substr(0, 15), "0.00;1.00;2.00;");
+}
+
+BOOST_AUTO_TEST_CASE(decimalFormatterStream)
+{
+    using namespace dec;
+    const decimal_formatter formatter(std::locale(std::locale::classic(), new grouped_punct));
+
+    std::ostringstream out;
+    const std::locale before = out.getloc();
+    out << formatter(decimal<2>("12345.6")) << '|'
+        << std::setw(8) << formatter(decimal<2>("1.5")) << '|'
+        << std::left << std::setfill('*') << std::setw(8) << formatter(decimal<2>("-1.5")) << '|'
+        << std::setw(2) << formatter(decimal<2>("1234")) << '|';
+    BOOST_CHECK_EQUAL(out.str(), "12.345,60|    1,50|-1,50***|1.234,00|");
+    BOOST_CHECK(out.getloc() == before);
+}
+
+BOOST_AUTO_TEST_CASE(decimalFormatterStreamOperator)
+{
+    using namespace dec;
+    std::ostringstream out;
+    out.imbue(std::locale(std::locale::classic(), new grouped_punct));
+    const std::locale before = out.getloc();
+    out << decimal<2>("12345.6") << '|' << std::setw(8) << decimal<2>("-1.5") << '|'
+        << std::left << std::setfill('*') << std::setw(6) << decimal<0>(12) << '|' << 7 << '|';
+    BOOST_CHECK_EQUAL(out.str(), "12.345,60|   -1,50|12****|7|");
+    BOOST_CHECK(out.getloc() == before);
+    BOOST_CHECK_EQUAL(out.fill(), '*');
+
+    std::ostringstream classic;
+    classic << decimal<3>("-0.5") << ' ' << decimal<0>(-1234);
+    BOOST_CHECK_EQUAL(classic.str(), "-0.500 -1234");
+}
@@ -0,0 +1,52 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+// forward declarations have to work when included before decimal.h
+#include "decimal_fwd.h"
+
+namespace {
+
+    dec::decimal4 twice(const dec::decimal4 &value);
+
+} // namespace
+
+#include "decimal.h"
+#include "decimal_fwd.h"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+
+namespace {
+
+    dec::decimal4 twice(const dec::decimal4 &value) {
+        return value + value;
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalFwdDeclarations)
+{
+    BOOST_CHECK_EQUAL(twice(dec::decimal4("1.2345")), dec::decimal4("2.469"));
+}
+
+// types instantiated by library target, see DEC_EXTERN_TEMPLATES
+BOOST_AUTO_TEST_CASE(decimalInstantiatedTypes)
+{
+    using namespace dec;
+    decimal<2, half_even_round_policy> d2;
+    decimal<8, floor_round_policy> d8("-1.123456789");
+    BOOST_CHECK_EQUAL(toString(d8), "-1.12345679");
+
+    std::istringstream input("2.345");
+    input >> d2;
+    BOOST_CHECK_EQUAL(toString(d2, decimal_format(',')), "2,34");
+
+    std::ostringstream output;
+    output << (d2 % decimal<2, half_even_round_policy>(1)).abs();
+    BOOST_CHECK_EQUAL(output.str(), "0.34");
+
+    decimal<6, round_up_round_policy> d6;
+    BOOST_CHECK(fromString("0.0000001", 9, basic_decimal_format(), d6));
+    typedef decimal<6, round_up_round_policy> decimal_up;
+    BOOST_CHECK_EQUAL(d6, fromString<decimal_up>(std::string("0.000001")));
+}
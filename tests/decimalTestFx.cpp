@@ -0,0 +1,196 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal_fx.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+namespace {
+
+    enum { USD, EUR, JPY, GBP, CHF, currency_count };
+
+    typedef dec::fx_rate_table<8> table_type;
+    typedef table_type::rate_type rate_type;
+
+    // values small enough for exact int64 arithmetic
+    template<class RoundPolicy>
+    int compare_ratio(int count) {
+        test_random random(7);
+        int errors = 0;
+        for (int i = 0; i < count; ++i) {
+            const dec::int64 value = random.below(2000001) - 1000000;
+            const dec::int64 numerator = 1 + random.below(100000);
+            const dec::int64 denominator = 1 + random.below(100000);
+            const int shift = static_cast<int>(random.below(5));
+            const dec::int64 factor = dec::dec_utils<RoundPolicy>::pow10(shift);
+            dec::int64 output = 0, expected = 0;
+            const bool ok = dec::details::mul_ratio_rounded<RoundPolicy>(output, value, numerator, denominator,
+                                                                         shift);
+            RoundPolicy::div_rounded(expected, value * numerator * factor, denominator);
+            errors += (ok && output == expected) ? 0 : 1;
+            // negative shift divides
+            const bool okDown = dec::details::mul_ratio_rounded<RoundPolicy>(output, value, numerator, denominator,
+                                                                             -shift);
+            RoundPolicy::div_rounded(expected, value * numerator, denominator * factor);
+            errors += (okDown && output == expected) ? 0 : 1;
+        }
+        return errors;
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalFxConvert)
+{
+    using namespace dec;
+    table_type rates(currency_count, USD);
+    BOOST_CHECK_EQUAL(rates.version(), 0u);
+    BOOST_CHECK(rates.set_rate(EUR, rate_type("0.92")));
+    BOOST_CHECK(rates.set_rate(JPY, rate_type("151.2345")));
+    BOOST_CHECK(rates.set_rate(GBP, rate_type("0.78912345")));
+    rates.publish();
+    BOOST_CHECK_EQUAL(rates.version(), 1u);
+
+    // triangulated through USD with single rounding
+    decimal<0> yen;
+    BOOST_REQUIRE(rates.convert(decimal<2>("1234.56"), EUR, JPY, yen));
+    BOOST_CHECK_EQUAL(yen, decimal<0>("202944"));
+    decimal<2> yen2;
+    BOOST_REQUIRE(rates.convert(decimal<2>("1234.56"), EUR, JPY, yen2));
+    BOOST_CHECK_EQUAL(yen2, decimal<2>("202943.55"));
+    decimal<2> pounds;
+    BOOST_REQUIRE(rates.convert(decimal<0>("-1000"), EUR, GBP, pounds));
+    BOOST_CHECK_EQUAL(pounds, decimal<2>("-857.74"));
+    decimal<3> back;
+    BOOST_REQUIRE(rates.convert(decimal<2>("1234.56"), JPY, GBP, back));
+    BOOST_CHECK_EQUAL(back, decimal<3>("6.442"));
+
+    // policy of output type is used
+    decimal<0, floor_round_policy> yenFloor;
+    BOOST_REQUIRE(rates.convert(decimal<2>("1234.56"), EUR, JPY, yenFloor));
+    BOOST_CHECK_EQUAL(yenFloor.getUnbiased(), 202943);
+
+    // pivot and the same currency
+    decimal<4> dollars;
+    BOOST_REQUIRE(rates.convert(decimal<2>("100"), USD, JPY, dollars));
+    BOOST_CHECK_EQUAL(dollars, decimal<4>("15123.45"));
+    BOOST_REQUIRE(rates.convert(decimal<2>("12.34"), GBP, GBP, dollars));
+    BOOST_CHECK_EQUAL(dollars, decimal<4>("12.34"));
+
+    decimal<8> cross;
+    BOOST_REQUIRE(rates.cross(EUR, JPY, cross));
+    BOOST_CHECK_EQUAL(cross, decimal<8>("164.38532609"));
+    BOOST_REQUIRE(rates.cross(USD, EUR, cross));
+    BOOST_CHECK_EQUAL(cross, decimal<8>("0.92"));
+
+    // CHF has no rate
+    BOOST_CHECK(!rates.convert(decimal<2>("1"), CHF, USD, dollars));
+    BOOST_CHECK(!rates.convert(decimal<2>("1"), USD, CHF, dollars));
+    BOOST_CHECK(!rates.convert(decimal<2>("1"), USD, currency_count, dollars));
+    BOOST_CHECK(!rates.cross(CHF, EUR, cross));
+
+    // result does not fit
+    decimal<8> large;
+    BOOST_CHECK(!rates.convert(decimal<2>("100000000000"), USD, JPY, large));
+}
+
+BOOST_AUTO_TEST_CASE(decimalFxPublish)
+{
+    using namespace dec;
+    table_type rates(currency_count, USD);
+    BOOST_CHECK_EQUAL(rates.currency_count(), static_cast<std::size_t>(currency_count));
+    BOOST_CHECK_EQUAL(rates.pivot(), static_cast<std::size_t>(USD));
+    BOOST_CHECK(!rates.set_rate(USD, rate_type("2")));
+    BOOST_CHECK(!rates.set_rate(EUR, rate_type("0")));
+    BOOST_CHECK(!rates.set_rate(EUR, rate_type("-1")));
+    BOOST_CHECK(!rates.set_rate(currency_count, rate_type("1")));
+
+    // rates are not visible before publish()
+    decimal<2> output;
+    BOOST_CHECK(rates.set_rate(EUR, rate_type("0.5")));
+    BOOST_CHECK(!rates.convert(decimal<2>("1"), USD, EUR, output));
+    rates.publish();
+    BOOST_REQUIRE(rates.convert(decimal<2>("1"), USD, EUR, output));
+    BOOST_CHECK_EQUAL(output, decimal<2>("0.5"));
+
+    // reader keeps its snapshot
+    {
+        const table_type::reader view(rates);
+        BOOST_CHECK(rates.set_rate(EUR, rate_type("0.25")));
+        BOOST_CHECK(rates.clear_rate(EUR));
+        BOOST_REQUIRE(view.convert(decimal<2>("1"), USD, EUR, output));
+        BOOST_CHECK_EQUAL(output, decimal<2>("0.5"));
+        BOOST_CHECK_EQUAL(view.version(), 1u);
+    }
+    rates.publish();
+    BOOST_CHECK(!rates.convert(decimal<2>("1"), USD, EUR, output));
+    BOOST_CHECK(rates.set_rate(EUR, rate_type("0.25")));
+    rates.publish();
+    BOOST_REQUIRE(rates.convert(decimal<2>("1"), EUR, USD, output));
+    BOOST_CHECK_EQUAL(output, decimal<2>("4"));
+    BOOST_CHECK_EQUAL(rates.version(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(decimalFxRounding)
+{
+    using namespace dec;
+    BOOST_CHECK_EQUAL(compare_ratio<def_round_policy>(20000), 0);
+    BOOST_CHECK_EQUAL(compare_ratio<half_down_round_policy>(20000), 0);
+    BOOST_CHECK_EQUAL(compare_ratio<half_up_round_policy>(20000), 0);
+    BOOST_CHECK_EQUAL(compare_ratio<half_even_round_policy>(20000), 0);
+    BOOST_CHECK_EQUAL(compare_ratio<ceiling_round_policy>(20000), 0);
+    BOOST_CHECK_EQUAL(compare_ratio<floor_round_policy>(20000), 0);
+    BOOST_CHECK_EQUAL(compare_ratio<round_down_round_policy>(20000), 0);
+    BOOST_CHECK_EQUAL(compare_ratio<round_up_round_policy>(20000), 0);
+
+    // wide intermediate values, result near limits
+    int64 output;
+    BOOST_CHECK(details::mul_ratio_rounded<def_round_policy>(output, DEC_MAX_INT64, DEC_MAX_INT64, DEC_MAX_INT64, 0));
+    BOOST_CHECK_EQUAL(output, DEC_MAX_INT64);
+    BOOST_CHECK(details::mul_ratio_rounded<def_round_policy>(output, DEC_MIN_INT64, 3, 3, 0));
+    BOOST_CHECK_EQUAL(output, DEC_MIN_INT64);
+    BOOST_CHECK(!details::mul_ratio_rounded<def_round_policy>(output, DEC_MAX_INT64, 2, 1, 0));
+    BOOST_CHECK(details::mul_ratio_rounded<def_round_policy>(output, 123456789, 1, 1, 10));
+    BOOST_CHECK_EQUAL(output, 1234567890000000000LL);
+    BOOST_CHECK(!details::mul_ratio_rounded<def_round_policy>(output, 123456789, 1000, 1, 10));
+    BOOST_CHECK(details::mul_ratio_rounded<def_round_policy>(output, DEC_MAX_INT64, DEC_MAX_INT64, 1, -37));
+    BOOST_CHECK_EQUAL(output, 9);
+    BOOST_CHECK(details::mul_ratio_rounded<def_round_policy>(output, -5, 1, 1, -1));
+    BOOST_CHECK_EQUAL(output, -1);
+}
+
+BOOST_AUTO_TEST_CASE(decimalFxConcurrentReaders)
+{
+    using namespace dec;
+    table_type rates(currency_count, USD);
+    rates.set_rate(EUR, rate_type(1));
+    rates.publish();
+
+    // rate of EUR is equal to version of snapshot, so readers can check consistency
+    std::atomic<bool> done(false);
+    std::atomic<int> errors(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.push_back(std::thread([&rates, &done, &errors]() {
+            while (!done.load()) {
+                const table_type::reader view(rates);
+                decimal<2> euros;
+                if (!view.convert(decimal<2>(1), USD, EUR, euros) ||
+                    euros.getUnbiased() != static_cast<int64>(view.version()) * 100) {
+                    ++errors;
+                }
+            }
+        }));
+    }
+    for (int version = 2; version <= 300; ++version) {
+        rates.set_rate(EUR, rate_type(version));
+        rates.publish();
+    }
+    done.store(true);
+    for (std::size_t i = 0; i < readers.size(); ++i) {
+        readers[i].join();
+    }
+    BOOST_CHECK_EQUAL(errors.load(), 0);
+    BOOST_CHECK_EQUAL(rates.version(), 300u);
+}
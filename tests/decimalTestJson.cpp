@@ -0,0 +1,164 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal_json.h"
+#include <boost/test/unit_test.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+    template<class T>
+    bool parse_json(const char *text, T &output) {
+        return dec::read_json(text, std::strlen(text), output);
+    }
+
+    template<class T>
+    std::string to_json(const T &value, bool quoted = false) {
+        std::string result;
+        return dec::append_json(value, result, quoted);
+    }
+
+    // collects numbers passed by adapter
+    struct number_collector {
+        bool on_decimal(const dec::decimal<4> &value) {
+            values.push_back(value);
+            return true;
+        }
+
+        std::vector<dec::decimal<4> > values;
+    };
+
+}
+
+BOOST_AUTO_TEST_CASE(decimalJsonRead)
+{
+    dec::decimal<4> value;
+
+    BOOST_CHECK(parse_json("0", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(0));
+    BOOST_CHECK(parse_json("-12.5", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("-12.5"));
+    BOOST_CHECK(parse_json("1.25E-3", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("0.0013"));
+    BOOST_CHECK(parse_json("6e+5", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(600000));
+    BOOST_CHECK(parse_json("0.00005", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("0.0001"));
+    BOOST_CHECK(parse_json("-0.00005", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("-0.0001"));
+    BOOST_CHECK(parse_json("\"4.00000000\"", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(4));
+    BOOST_CHECK(parse_json("1e-100000", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(0));
+    BOOST_CHECK(parse_json("0e100000", value));
+
+    // invalid JSON numbers
+    const char *invalid[] = {"", "-", "+1", "01", "1.", ".5", "1e", "1e+", "1.5x", "\"1.5", "\"1.5x\"", "--1",
+                             "1e400", "922337203685477.5808", "\"\""};
+    for (std::size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        value = dec::decimal<4>(1);
+        BOOST_CHECK_MESSAGE(!parse_json(invalid[i], value), invalid[i]);
+        BOOST_CHECK_EQUAL(value, dec::decimal<4>(0));
+    }
+
+    // limits
+    BOOST_CHECK(parse_json("922337203685477.5807", value));
+    BOOST_CHECK_EQUAL(value.getUnbiased(), DEC_MAX_INT64);
+    BOOST_CHECK(parse_json("-922337203685477.5808", value));
+    BOOST_CHECK_EQUAL(value.getUnbiased(), DEC_MIN_INT64);
+
+    // token inside larger text
+    const char *text = "[1.5,\"2\"]";
+    const char *end = text + std::strlen(text);
+    const char *next = dec::read_json(text + 1, end, value);
+    BOOST_REQUIRE(next != NULL);
+    BOOST_CHECK_EQUAL(*next, ',');
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("1.5"));
+    next = dec::read_json(next + 1, end, value);
+    BOOST_REQUIRE(next != NULL);
+    BOOST_CHECK_EQUAL(*next, ']');
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(2));
+}
+
+BOOST_AUTO_TEST_CASE(decimalJsonRounding)
+{
+    // digits beyond mantissa are kept as sticky flag
+    dec::decimal<2, dec::half_down_round_policy> down;
+    BOOST_CHECK(parse_json("0.125", down));
+    BOOST_CHECK_EQUAL(down.getUnbiased(), 12);
+    BOOST_CHECK(parse_json("0.12500000000000000000000000001", down));
+    BOOST_CHECK_EQUAL(down.getUnbiased(), 13);
+    BOOST_CHECK(parse_json("12500000000000000000000000001e-29", down));
+    BOOST_CHECK_EQUAL(down.getUnbiased(), 13);
+
+    dec::decimal<0, dec::half_even_round_policy> even;
+    BOOST_CHECK(parse_json("2.5", even));
+    BOOST_CHECK_EQUAL(even.getUnbiased(), 2);
+    BOOST_CHECK(parse_json("2.50000000000000000000001", even));
+    BOOST_CHECK_EQUAL(even.getUnbiased(), 3);
+    BOOST_CHECK(parse_json("1234567890123456789.4", even));
+    BOOST_CHECK_EQUAL(even.getUnbiased(), static_cast<dec::int64>(1234567890123456789LL));
+
+    dec::decimal<2, dec::ceiling_round_policy> ceiling;
+    BOOST_CHECK(parse_json("1.00000000000000000000000001", ceiling));
+    BOOST_CHECK_EQUAL(ceiling.getUnbiased(), 101);
+    BOOST_CHECK(parse_json("1e-50", ceiling));
+    BOOST_CHECK_EQUAL(ceiling.getUnbiased(), 1);
+    BOOST_CHECK(parse_json("-1e-50", ceiling));
+    BOOST_CHECK_EQUAL(ceiling.getUnbiased(), 0);
+
+    // same results as fromString for plain numbers
+    const char *samples[] = {"0.005", "-0.015", "123.455", "99999999.995", "-1e-3", "5E-3"};
+    for (std::size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); ++i) {
+        dec::decimal<2> value;
+        BOOST_CHECK(parse_json(samples[i], value));
+        BOOST_CHECK_EQUAL(value, dec::fromString<dec::decimal<2> >(samples[i]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(decimalJsonWrite)
+{
+    BOOST_CHECK_EQUAL(to_json(dec::decimal<4>("-12.5")), "-12.5");
+    BOOST_CHECK_EQUAL(to_json(dec::decimal<4>(3)), "3");
+    BOOST_CHECK_EQUAL(to_json(dec::decimal<4>(0)), "0");
+    BOOST_CHECK_EQUAL(to_json(dec::decimal<4>("0.0001")), "0.0001");
+    BOOST_CHECK_EQUAL(to_json(dec::decimal<4>("100")), "100");
+    BOOST_CHECK_EQUAL(to_json(dec::decimal<0>(120)), "120");
+    BOOST_CHECK_EQUAL(to_json(dec::decimal<8>("4.5"), true), "\"4.5\"");
+
+    dec::decimal<4> minValue;
+    minValue.setUnbiased(DEC_MIN_INT64);
+    BOOST_CHECK_EQUAL(to_json(minValue), "-922337203685477.5808");
+
+    // round trip
+    dec::decimal<4> value;
+    BOOST_CHECK(parse_json(to_json(minValue).c_str(), value));
+    BOOST_CHECK_EQUAL(value, minValue);
+}
+
+BOOST_AUTO_TEST_CASE(decimalJsonSaxAdapter)
+{
+    dec::json_sax_adapter<number_collector, 4> adapter;
+
+    // RapidJSON style
+    const char *raw = "1.25";
+    BOOST_CHECK(adapter.RawNumber(raw, 4u, false));
+    BOOST_CHECK(!adapter.RawNumber("1.2.5", 5u, true));
+
+    // nlohmann::json style
+    BOOST_CHECK(adapter.number_float(0.1, std::string("0.1")));
+    BOOST_CHECK(adapter.number_integer(-7));
+    BOOST_CHECK(adapter.number_unsigned(42u));
+    BOOST_CHECK(!adapter.number_unsigned(~static_cast<dec::details::uint64>(0)));
+    BOOST_CHECK(!adapter.number_integer(DEC_MAX_INT64));
+
+    const std::vector<dec::decimal<4> > &values = adapter.handler().values;
+    BOOST_REQUIRE_EQUAL(values.size(), 4u);
+    BOOST_CHECK_EQUAL(values[0], dec::decimal<4>("1.25"));
+    BOOST_CHECK_EQUAL(values[1], dec::decimal<4>("0.1"));
+    BOOST_CHECK_EQUAL(values[2], dec::decimal<4>(-7));
+    BOOST_CHECK_EQUAL(values[3], dec::decimal<4>(42));
+}
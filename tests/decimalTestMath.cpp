@@ -0,0 +1,110 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal.h"
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(decimalPow)
+{
+    BOOST_CHECK_EQUAL(dec::decimal<4>("1.5").pow(2), dec::decimal<4>("2.25"));
+    BOOST_CHECK_EQUAL(dec::decimal<4>("-1.5").pow(3), dec::decimal<4>("-3.375"));
+    BOOST_CHECK_EQUAL(dec::decimal<2>("3").pow(0), dec::decimal<2>("1"));
+    BOOST_CHECK_EQUAL(dec::decimal<2>("0").pow(0), dec::decimal<2>("1"));
+    BOOST_CHECK_EQUAL(dec::decimal<2>("0").pow(5), dec::decimal<2>("0"));
+    BOOST_CHECK_EQUAL(dec::decimal<4>("2").pow(-3), dec::decimal<4>("0.125"));
+    BOOST_CHECK_EQUAL(dec::decimal<2>("1.05").pow(360), dec::decimal<2>("42476396.41"));
+    BOOST_CHECK_EQUAL(dec::decimal<8>("1.0025").pow(360), dec::decimal<8>("2.45684221"));
+    BOOST_CHECK_EQUAL(dec::decimal<6>("3").pow(-1), dec::decimal<6>("0.333333"));
+
+    // rounding of exact ties
+    BOOST_CHECK_EQUAL(dec::decimal<1>("1.5").pow(2), dec::decimal<1>("2.3"));
+    BOOST_CHECK_EQUAL((dec::decimal<1, dec::half_even_round_policy>("1.5").pow(2)),
+                      (dec::decimal<1, dec::half_even_round_policy>("2.2")));
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::ceiling_round_policy>("1.1").pow(2)),
+                      (dec::decimal<2, dec::ceiling_round_policy>("1.21")));
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::floor_round_policy>("1.1").pow(2)),
+                      (dec::decimal<2, dec::floor_round_policy>("1.21")));
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::ceiling_round_policy>("1.01").pow(3)),
+                      (dec::decimal<2, dec::ceiling_round_policy>("1.04")));
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::floor_round_policy>("1.01").pow(3)),
+                      (dec::decimal<2, dec::floor_round_policy>("1.03")));
+
+    // exact negative powers, too long to be calculated directly
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::ceiling_round_policy>("0.5").pow(-40)),
+                      (dec::decimal<2, dec::ceiling_round_policy>("1099511627776")));
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::floor_round_policy>("0.5").pow(-40)),
+                      (dec::decimal<2, dec::floor_round_policy>("1099511627776")));
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::round_up_round_policy>("0.25").pow(-20)),
+                      (dec::decimal<2, dec::round_up_round_policy>("1099511627776")));
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::floor_round_policy>("-0.25").pow(-21)),
+                      (dec::decimal<2, dec::floor_round_policy>("-4398046511104")));
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::ceiling_round_policy>("0.7").pow(-37)),
+                      (dec::decimal<2, dec::ceiling_round_policy>("538731.69")));
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::floor_round_policy>("0.7").pow(-37)),
+                      (dec::decimal<2, dec::floor_round_policy>("538731.68")));
+
+    // overflow, division by zero
+    BOOST_CHECK_EQUAL(dec::decimal<4>("10").pow(19), dec::decimal<4>("0"));
+    BOOST_CHECK_EQUAL(dec::decimal<8>("0.3").pow(-30), dec::decimal<8>("0"));
+    BOOST_CHECK_EQUAL(dec::decimal<4>("0").pow(-1), dec::decimal<4>("0"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalSqrt)
+{
+    BOOST_CHECK_EQUAL(dec::decimal<4>("2.25").sqrt(), dec::decimal<4>("1.5"));
+    BOOST_CHECK_EQUAL(dec::decimal<8>("2").sqrt(), dec::decimal<8>("1.41421356"));
+    BOOST_CHECK_EQUAL(dec::decimal<18>("2").sqrt(), dec::decimal<18>("1.414213562373095049"));
+    BOOST_CHECK_EQUAL(dec::decimal<0>("9223372036854775807").sqrt(), dec::decimal<0>("3037000500"));
+    BOOST_CHECK_EQUAL(dec::decimal<2>("0").sqrt(), dec::decimal<2>("0"));
+    BOOST_CHECK_EQUAL(dec::decimal<2>("-4").sqrt(), dec::decimal<2>("0"));
+
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::ceiling_round_policy>("2").sqrt()),
+                      (dec::decimal<2, dec::ceiling_round_policy>("1.42")));
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::ceiling_round_policy>("4").sqrt()),
+                      (dec::decimal<2, dec::ceiling_round_policy>("2")));
+    BOOST_CHECK_EQUAL((dec::decimal<2, dec::floor_round_policy>("3").sqrt()),
+                      (dec::decimal<2, dec::floor_round_policy>("1.73")));
+}
+
+BOOST_AUTO_TEST_CASE(decimalExp)
+{
+    BOOST_CHECK_EQUAL(dec::decimal<4>("0").exp(), dec::decimal<4>("1"));
+    BOOST_CHECK_EQUAL(dec::decimal<2>("1").exp(), dec::decimal<2>("2.72"));
+    BOOST_CHECK_EQUAL(dec::decimal<16>("1").exp(), dec::decimal<16>("2.7182818284590452"));
+    BOOST_CHECK_EQUAL(dec::decimal<8>("-1").exp(), dec::decimal<8>("0.36787944"));
+    BOOST_CHECK_EQUAL(dec::decimal<6>("0.05").exp(), dec::decimal<6>("1.051271"));
+    BOOST_CHECK_EQUAL(dec::decimal<0>("43").exp(), dec::decimal<0>("4727839468229346561"));
+    BOOST_CHECK_EQUAL((dec::decimal<4, dec::round_up_round_policy>("0").exp()),
+                      (dec::decimal<4, dec::round_up_round_policy>("1")));
+
+    // underflow rounds according to policy
+    BOOST_CHECK_EQUAL(dec::decimal<8>("-30").exp(), dec::decimal<8>("0"));
+    BOOST_CHECK_EQUAL((dec::decimal<8, dec::ceiling_round_policy>("-30").exp()),
+                      (dec::decimal<8, dec::ceiling_round_policy>("0.00000001")));
+
+    // overflow
+    BOOST_CHECK_EQUAL(dec::decimal<0>("44").exp(), dec::decimal<0>("0"));
+    BOOST_CHECK_EQUAL(dec::decimal<4>("1000").exp(), dec::decimal<4>("0"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalLn)
+{
+    BOOST_CHECK_EQUAL(dec::decimal<4>("1").ln(), dec::decimal<4>("0"));
+    BOOST_CHECK_EQUAL(dec::decimal<8>("10").ln(), dec::decimal<8>("2.30258509"));
+    BOOST_CHECK_EQUAL(dec::decimal<8>("0.5").ln(), dec::decimal<8>("-0.69314718"));
+    BOOST_CHECK_EQUAL(dec::decimal<18>("2").ln(), dec::decimal<18>("0.693147180559945309"));
+    BOOST_CHECK_EQUAL(dec::decimal<6>("1.05").ln(), dec::decimal<6>("0.04879"));
+    BOOST_CHECK_EQUAL(dec::decimal<0>("9223372036854775807").ln(), dec::decimal<0>("44"));
+
+    BOOST_CHECK_EQUAL((dec::decimal<4, dec::floor_round_policy>("0.5").ln()),
+                      (dec::decimal<4, dec::floor_round_policy>("-0.6932")));
+    BOOST_CHECK_EQUAL((dec::decimal<4, dec::ceiling_round_policy>("0.5").ln()),
+                      (dec::decimal<4, dec::ceiling_round_policy>("-0.6931")));
+    BOOST_CHECK_EQUAL((dec::decimal<4, dec::ceiling_round_policy>("1").ln()),
+                      (dec::decimal<4, dec::ceiling_round_policy>("0")));
+
+    // domain errors
+    BOOST_CHECK_EQUAL(dec::decimal<4>("0").ln(), dec::decimal<4>("0"));
+    BOOST_CHECK_EQUAL(dec::decimal<4>("-1").ln(), dec::decimal<4>("0"));
+}
@@ -0,0 +1,228 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal_order_book.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <map>
+
+namespace {
+
+    typedef dec::order_book<4, 2> book_type;
+    typedef book_type::price_type price_type;
+    typedef book_type::quantity_type quantity_type;
+
+    struct model_order {
+        dec::book_side side;
+        dec::int64 price;
+        dec::int64 quantity;
+    };
+
+    // naive book: orders by id, levels summed on request
+    struct model_book {
+        std::map<dec::details::uint64, model_order> orders;
+
+        std::vector<book_type::level> levels(dec::book_side side) const {
+            std::map<dec::int64, book_type::level> byPrice;
+            for (std::map<dec::details::uint64, model_order>::const_iterator it = orders.begin();
+                 it != orders.end(); ++it) {
+                if (it->second.side != side) {
+                    continue;
+                }
+                book_type::level &entry = byPrice[it->second.price];
+                entry.price.setUnbiased(it->second.price);
+                entry.quantity += quantity_type::buildWithExponent(it->second.quantity, -2);
+                ++entry.orders;
+            }
+            std::vector<book_type::level> result;
+            for (std::map<dec::int64, book_type::level>::const_iterator it = byPrice.begin();
+                 it != byPrice.end(); ++it) {
+                result.push_back(it->second);
+            }
+            if (side == dec::book_bid) {
+                std::reverse(result.begin(), result.end());
+            }
+            return result;
+        }
+    };
+
+    int compare_side(const book_type &book, const model_book &model, dec::book_side side) {
+        const std::vector<book_type::level> expected = model.levels(side);
+        BOOST_REQUIRE_EQUAL(book.level_count(side), expected.size());
+        std::vector<book_type::level> levels(expected.size() + 1);
+        const std::size_t count = book.snapshot(side, levels.size(), &levels[0]);
+        BOOST_REQUIRE_EQUAL(count, expected.size());
+        int errors = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (levels[i].price != expected[i].price || levels[i].quantity != expected[i].quantity ||
+                levels[i].orders != expected[i].orders) {
+                ++errors;
+            }
+        }
+        return errors;
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalOrderBookBasic)
+{
+    using namespace dec;
+    book_type book(price_type("0.0005"));
+    BOOST_CHECK(book.empty());
+    BOOST_CHECK(book.add(1, book_bid, price_type("101.25"), quantity_type("10")));
+    BOOST_CHECK(book.add(2, book_bid, price_type("101.25"), quantity_type("2.5")));
+    BOOST_CHECK(book.add(3, book_bid, price_type("101.2"), quantity_type("1")));
+    BOOST_CHECK(book.add(4, book_ask, price_type("101.3"), quantity_type("4")));
+    BOOST_CHECK(book.add(5, book_ask, price_type("101.35"), quantity_type("6")));
+    BOOST_CHECK_EQUAL(book.order_count(), 5u);
+    BOOST_CHECK_EQUAL(book.level_count(book_bid), 2u);
+    BOOST_CHECK_EQUAL(book.level_count(book_ask), 2u);
+
+    book_type::level top[3];
+    BOOST_REQUIRE_EQUAL(book.snapshot(book_bid, 3, top), 2u);
+    BOOST_CHECK_EQUAL(top[0].price, price_type("101.25"));
+    BOOST_CHECK_EQUAL(top[0].quantity, quantity_type("12.5"));
+    BOOST_CHECK_EQUAL(top[0].orders, 2u);
+    BOOST_CHECK_EQUAL(top[1].price, price_type("101.2"));
+
+    book_type::level best;
+    BOOST_REQUIRE(book.best(book_ask, best));
+    BOOST_CHECK_EQUAL(best.price, price_type("101.3"));
+    BOOST_CHECK_EQUAL(best.quantity, quantity_type("4"));
+
+    // partial fill, then price change to better level
+    BOOST_CHECK(book.modify(1, quantity_type("7.5")));
+    BOOST_REQUIRE(book.best(book_bid, best));
+    BOOST_CHECK_EQUAL(best.quantity, quantity_type("10"));
+    BOOST_CHECK(book.modify(3, price_type("101.255"), quantity_type("3")));
+    BOOST_REQUIRE(book.best(book_bid, best));
+    BOOST_CHECK_EQUAL(best.price, price_type("101.255"));
+    BOOST_CHECK_EQUAL(best.quantity, quantity_type("3"));
+    BOOST_CHECK_EQUAL(book.level_count(book_bid), 2u);
+
+    book_side side;
+    price_type price;
+    quantity_type quantity;
+    BOOST_REQUIRE(book.find(3, side, price, quantity));
+    BOOST_CHECK_EQUAL(side, book_bid);
+    BOOST_CHECK_EQUAL(price, price_type("101.255"));
+    BOOST_CHECK_EQUAL(quantity, quantity_type("3"));
+
+    BOOST_CHECK(book.cancel(4));
+    BOOST_REQUIRE(book.best(book_ask, best));
+    BOOST_CHECK_EQUAL(best.price, price_type("101.35"));
+    BOOST_CHECK(!book.cancel(4));
+    BOOST_CHECK_EQUAL(book.order_count(), 4u);
+
+    book.clear();
+    BOOST_CHECK(book.empty());
+    BOOST_CHECK(!book.best(book_bid, best));
+}
+
+BOOST_AUTO_TEST_CASE(decimalOrderBookInvalid)
+{
+    using namespace dec;
+    book_type book(price_type("0.01"));
+    // price not on tick, non-positive quantity, duplicate id
+    BOOST_CHECK(!book.add(1, book_bid, price_type("1.005"), quantity_type("1")));
+    BOOST_CHECK(!book.add(1, book_bid, price_type("1.01"), quantity_type("0")));
+    BOOST_CHECK(!book.add(1, book_bid, price_type("1.01"), quantity_type("-1")));
+    BOOST_CHECK(book.add(1, book_bid, price_type("1.01"), quantity_type("1")));
+    BOOST_CHECK(!book.add(1, book_ask, price_type("1.02"), quantity_type("1")));
+
+    // unknown order, invalid new values leave order unchanged
+    BOOST_CHECK(!book.modify(2, quantity_type("1")));
+    BOOST_CHECK(!book.modify(1, quantity_type("0")));
+    BOOST_CHECK(!book.modify(1, price_type("1.015"), quantity_type("2")));
+    BOOST_CHECK(!book.modify(1, price_type("1.02"), quantity_type("0")));
+    book_type::level best;
+    BOOST_REQUIRE(book.best(book_bid, best));
+    BOOST_CHECK_EQUAL(best.price, price_type("1.01"));
+    BOOST_CHECK_EQUAL(best.quantity, quantity_type("1"));
+
+    // total quantity of level overflows
+    quantity_type large;
+    large.setUnbiased(DEC_MAX_INT64 - 10);
+    BOOST_CHECK(!book.add(2, book_bid, price_type("1.01"), large));
+    BOOST_CHECK(book.add(2, book_bid, price_type("1.02"), large));
+    BOOST_CHECK(!book.modify(1, price_type("1.02"), quantity_type("1")));
+    BOOST_CHECK_EQUAL(book.order_count(), 2u);
+    BOOST_CHECK_EQUAL(book.level_count(book_bid), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(decimalOrderBookNegativePrices)
+{
+    using namespace dec;
+    // spreads and some energy futures trade below zero
+    book_type book(price_type("0.25"));
+    BOOST_CHECK(book.add(1, book_bid, price_type("-1.25"), quantity_type("1")));
+    BOOST_CHECK(book.add(2, book_bid, price_type("-0.5"), quantity_type("1")));
+    BOOST_CHECK(book.add(3, book_ask, price_type("0"), quantity_type("1")));
+    BOOST_CHECK(book.add(4, book_ask, price_type("-0.25"), quantity_type("1")));
+    book_type::level best;
+    BOOST_REQUIRE(book.best(book_bid, best));
+    BOOST_CHECK_EQUAL(best.price, price_type("-0.5"));
+    BOOST_REQUIRE(book.best(book_ask, best));
+    BOOST_CHECK_EQUAL(best.price, price_type("-0.25"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalOrderBookRandom)
+{
+    using namespace dec;
+    book_type book(price_type("0.01"));
+    model_book model;
+    std::vector<details::uint64> ids;
+    details::uint64 nextId = 1;
+    test_random random(5);
+    int errors = 0;
+
+    for (int i = 0; i < 20000; ++i) {
+        const int64 action = random.below(10);
+        if (ids.empty() || action < 4) {
+            // ids with equal low bits collide in hash table
+            const details::uint64 id = (nextId++) << (random.below(3) * 16);
+            model_order order;
+            order.side = (random.below(2) == 0) ? book_bid : book_ask;
+            order.price = (order.side == book_bid ? 10000 : 10500) + (random.below(40) - 20) * 100;
+            order.quantity = 1 + random.below(100000);
+            BOOST_REQUIRE(book.add(id, order.side, price_type::buildWithExponent(order.price, -4),
+                                   quantity_type::buildWithExponent(order.quantity, -2)));
+            model.orders[id] = order;
+            ids.push_back(id);
+        } else {
+            const std::size_t position = static_cast<std::size_t>(random.below(static_cast<int64>(ids.size())));
+            const details::uint64 id = ids[position];
+            model_order &order = model.orders[id];
+            if (action < 6) {
+                order.quantity = 1 + random.below(order.quantity);
+                BOOST_REQUIRE(book.modify(id, quantity_type::buildWithExponent(order.quantity, -2)));
+            } else if (action < 7) {
+                order.price += (random.below(5) - 2) * 100;
+                order.quantity = 1 + random.below(100000);
+                BOOST_REQUIRE(book.modify(id, price_type::buildWithExponent(order.price, -4),
+                                          quantity_type::buildWithExponent(order.quantity, -2)));
+            } else {
+                BOOST_REQUIRE(book.cancel(id));
+                model.orders.erase(id);
+                ids[position] = ids.back();
+                ids.pop_back();
+            }
+        }
+        if (i % 97 == 0) {
+            errors += compare_side(book, model, book_bid);
+            errors += compare_side(book, model, book_ask);
+        }
+    }
+    BOOST_CHECK_EQUAL(errors, 0);
+    BOOST_CHECK_EQUAL(book.order_count(), model.orders.size());
+
+    // every live order can be found after deletions shifted hash table entries
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        book_side side;
+        price_type price;
+        quantity_type quantity;
+        BOOST_REQUIRE(book.find(ids[i], side, price, quantity));
+        BOOST_CHECK_EQUAL(price.getUnbiased(), model.orders[ids[i]].price);
+    }
+}
@@ -0,0 +1,152 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal_reader.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    typedef dec::decimal<4> value_type;
+
+    // removes file when test ends
+    struct temp_file {
+        explicit temp_file(const std::string &content) : path("decimal_reader_test.csv") {
+            std::ofstream output(path.c_str(), std::ios::binary);
+            output << content;
+        }
+
+        ~temp_file() {
+            std::remove(path.c_str());
+        }
+
+        std::string path;
+    };
+
+    struct row_sum {
+        row_sum() : rows(0), first(0), second(0) {
+        }
+
+        void operator()(const value_type *values, std::size_t count) {
+            BOOST_REQUIRE_EQUAL(count, 2u);
+            ++rows;
+            first += values[0];
+            second += values[1];
+        }
+
+        std::size_t rows;
+        value_type first;
+        value_type second;
+    };
+
+    std::vector<std::size_t> make_columns(std::size_t first, std::size_t second) {
+        std::vector<std::size_t> columns;
+        columns.push_back(first);
+        columns.push_back(second);
+        return columns;
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(decimalReaderSimple)
+{
+    temp_file file("id,price,qty\n1,12.5,3\r\n2,-0.0001,4.25\n\n3,1.5e2,x\n4,7\n");
+    dec::decimal_reader_options options;
+    options.skip_header = true;
+    dec::decimal_file_reader<4> reader(file.path, make_columns(2, 1), options);
+    BOOST_REQUIRE(reader.is_open());
+
+    std::vector<std::vector<value_type> > columns;
+    BOOST_REQUIRE(reader.read_columns(columns));
+    BOOST_CHECK_EQUAL(reader.rows(), 4u);
+    // "x" and missing quantity
+    BOOST_CHECK_EQUAL(reader.errors(), 2u);
+    BOOST_REQUIRE_EQUAL(columns.size(), 2u);
+    BOOST_REQUIRE_EQUAL(columns[0].size(), 4u);
+    BOOST_CHECK_EQUAL(columns[0][0], value_type(3));
+    BOOST_CHECK_EQUAL(columns[0][1], value_type("4.25"));
+    BOOST_CHECK_EQUAL(columns[0][2], value_type(0));
+    BOOST_CHECK_EQUAL(columns[0][3], value_type(0));
+    BOOST_CHECK_EQUAL(columns[1][0], value_type("12.5"));
+    BOOST_CHECK_EQUAL(columns[1][1], value_type("-0.0001"));
+    BOOST_CHECK_EQUAL(columns[1][2], value_type(150));
+    BOOST_CHECK_EQUAL(columns[1][3], value_type(7));
+
+    dec::decimal_file_reader<4> missing("decimal_reader_missing.csv", make_columns(0, 1));
+    BOOST_CHECK(!missing.is_open());
+    BOOST_CHECK(!missing.read_columns(columns));
+}
+
+BOOST_AUTO_TEST_CASE(decimalReaderOptions)
+{
+    temp_file file("1;2,5;x\n3;4,75;y");
+    dec::decimal_reader_options options;
+    options.separator = ';';
+    options.decimal_point = ',';
+    dec::decimal_file_reader<2> reader(file.path, make_columns(1, 0), options);
+
+    std::vector<std::vector<dec::decimal<2> > > columns;
+    BOOST_REQUIRE(reader.read_columns(columns));
+    BOOST_CHECK_EQUAL(reader.errors(), 0u);
+    BOOST_REQUIRE_EQUAL(columns[0].size(), 2u);
+    BOOST_CHECK_EQUAL(columns[0][1], dec::decimal<2>("4.75"));
+    BOOST_CHECK_EQUAL(columns[1][1], dec::decimal<2>(3));
+
+    temp_file empty("");
+    dec::decimal_file_reader<2> emptyReader(empty.path, make_columns(1, 0), options);
+    BOOST_CHECK(emptyReader.read_columns(columns));
+    BOOST_CHECK_EQUAL(columns[0].size(), 0u);
+    BOOST_CHECK_EQUAL(emptyReader.rows(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(decimalReaderWindows)
+{
+    // small windows and chunks, one line longer than window
+    test_random random(11);
+    std::string content;
+    std::vector<value_type> expectedFirst, expectedSecond;
+    for (int i = 0; i < 5000; ++i) {
+        value_type first, second;
+        first.setUnbiased(random.below(2000000000) - 1000000000);
+        second.setUnbiased(random.below(1000000));
+        content += dec::toString(first) + "," + (i == 1234 ? std::string(3000, ' ') : std::string()) + "0," +
+                   dec::toString(second) + "\n";
+        expectedFirst.push_back(first);
+        expectedSecond.push_back(second);
+    }
+    temp_file file(content);
+
+    const unsigned threadCounts[] = {1, 3, 8};
+    for (std::size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); ++t) {
+        dec::decimal_reader_options options;
+        options.threads = threadCounts[t];
+        options.window_size = 2048;
+        options.chunk_size = 300;
+        dec::decimal_file_reader<4> reader(file.path, make_columns(0, 2), options);
+
+        std::vector<std::vector<value_type> > columns;
+        BOOST_REQUIRE(reader.read_columns(columns));
+        BOOST_CHECK_EQUAL(reader.rows(), 5000u);
+        BOOST_CHECK_EQUAL(reader.errors(), 0u);
+        BOOST_CHECK(columns[0] == expectedFirst);
+        BOOST_CHECK(columns[1] == expectedSecond);
+
+        if (threadCounts[t] == 1) {
+            row_sum sum;
+            BOOST_REQUIRE(reader.for_each_row(sum));
+            BOOST_CHECK_EQUAL(sum.rows, 5000u);
+            value_type first, second;
+            for (std::size_t i = 0; i < expectedFirst.size(); ++i) {
+                first += expectedFirst[i];
+                second += expectedSecond[i];
+            }
+            BOOST_CHECK_EQUAL(sum.first, first);
+            BOOST_CHECK_EQUAL(sum.second, second);
+        }
+    }
+}
@@ -420,3 +420,51 @@ BOOST_AUTO_TEST_CASE(decimalRoundingPolicyOther)
     }
 }
 
+BOOST_AUTO_TEST_CASE(decimalRoundingNegativeDivisor)
+{
+    using namespace dec;
+    int64 output;
+
+    BOOST_CHECK(half_up_round_policy::div_rounded(output, 5, -2));
+    BOOST_CHECK_EQUAL(output, -2);
+    BOOST_CHECK(half_down_round_policy::div_rounded(output, -7, -2));
+    BOOST_CHECK_EQUAL(output, 3);
+    BOOST_CHECK(ceiling_round_policy::div_rounded(output, 1, -3));
+    BOOST_CHECK_EQUAL(output, 0);
+    BOOST_CHECK(floor_round_policy::div_rounded(output, 1, -3));
+    BOOST_CHECK_EQUAL(output, -1);
+    BOOST_CHECK(round_up_round_policy::div_rounded(output, -1, -3));
+    BOOST_CHECK_EQUAL(output, 1);
+
+    // half-even with odd divisor
+    BOOST_CHECK(half_even_round_policy::div_rounded(output, -28, 3));
+    BOOST_CHECK_EQUAL(output, -9);
+    BOOST_CHECK(half_even_round_policy::div_rounded(output, -28, -3));
+    BOOST_CHECK_EQUAL(output, 9);
+}
+
+BOOST_AUTO_TEST_CASE(decimalRoundingNearLimits)
+{
+    using namespace dec;
+    int64 output;
+
+    BOOST_CHECK(!div_rounded(output, DEC_MIN_INT64, -1));
+    BOOST_CHECK(!half_even_round_policy::div_rounded(output, DEC_MIN_INT64, -1));
+    BOOST_CHECK(!half_down_round_policy::div_rounded(output, DEC_MIN_INT64, -1));
+    BOOST_CHECK(half_down_round_policy::div_rounded(output, DEC_MIN_INT64, 1));
+    BOOST_CHECK_EQUAL(output, DEC_MIN_INT64);
+    BOOST_CHECK(ceiling_round_policy::div_rounded(output, DEC_MAX_INT64, 2));
+    BOOST_CHECK_EQUAL(output, 4611686018427387904LL);
+}
+
+BOOST_AUTO_TEST_CASE(decimalRoundingHalfEvenMultDiv)
+{
+    using namespace dec;
+
+    // parity of the whole result decides, not parity of the fractional part
+    decimal<1, half_even_round_policy> a, b;
+    a.setUnbiased(54066472515LL);
+    b.setUnbiased(261);
+    BOOST_CHECK_EQUAL((a * b).getUnbiased(), 1411134932642LL);
+    BOOST_CHECK_EQUAL(dec_utils<half_even_round_policy>::multDiv(54066472515LL, 261, 10), 1411134932642LL);
+}
@@ -0,0 +1,125 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal_bulk.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+namespace {
+
+    template<class RoundPolicy>
+    dec::int64 dec_utils_mult_div(dec::int64 value, dec::int64 divisor) {
+        return dec::dec_utils<RoundPolicy>::multDiv(value, 3, divisor * 3);
+    }
+
+    template<class RoundPolicy>
+    void check_div_rounded(dec::runtime_round_policy policy) {
+        for (dec::int64 a = -250; a <= 250; ++a) {
+            for (dec::int64 b = 1; b <= 12; ++b) {
+                dec::int64 expected = 0, actual = 0;
+                RoundPolicy::div_rounded(expected, a, b);
+                dec::div_rounded(actual, a, b, policy);
+                BOOST_CHECK_EQUAL(expected, actual);
+                BOOST_CHECK_EQUAL(dec_utils_mult_div<RoundPolicy>(a * 7919, b), dec::multDiv(a * 7919, 3, b * 3, policy));
+            }
+        }
+    }
+
+    template<class RoundPolicy>
+    void check_rescale(dec::runtime_round_policy policy) {
+        std::vector<dec::int64> input;
+        test_random random(7);
+        for (int i = 0; i < 1000; ++i) {
+            input.push_back(random.unbiased());
+        }
+        std::vector<dec::int64> expected(input.size()), actual(input.size());
+        dec::rescale_unbiased<6, 2, RoundPolicy>(&input[0], &expected[0], input.size());
+        dec::rescale_unbiased<6, 2>(&input[0], &actual[0], input.size(), policy);
+        BOOST_CHECK(expected == actual);
+    }
+
+    struct policy_name_visitor {
+        typedef std::string result_type;
+
+        std::string operator()(const dec::half_even_round_policy &) const {
+            return "half_even";
+        }
+
+        template<class RoundPolicy>
+        std::string operator()(const RoundPolicy &) const {
+            return "other";
+        }
+    };
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalRuntimePolicyDispatch)
+{
+    check_div_rounded<dec::def_round_policy>(dec::round_policy_def);
+    check_div_rounded<dec::null_round_policy>(dec::round_policy_null);
+    check_div_rounded<dec::half_down_round_policy>(dec::round_policy_half_down);
+    check_div_rounded<dec::half_up_round_policy>(dec::round_policy_half_up);
+    check_div_rounded<dec::half_even_round_policy>(dec::round_policy_half_even);
+    check_div_rounded<dec::ceiling_round_policy>(dec::round_policy_ceiling);
+    check_div_rounded<dec::floor_round_policy>(dec::round_policy_floor);
+    check_div_rounded<dec::round_down_round_policy>(dec::round_policy_round_down);
+    check_div_rounded<dec::round_up_round_policy>(dec::round_policy_round_up);
+
+    const policy_name_visitor visitor;
+    BOOST_CHECK_EQUAL(dec::visit_round_policy(dec::round_policy_half_even, visitor), "half_even");
+    BOOST_CHECK_EQUAL(dec::visit_round_policy(dec::round_policy_floor, visitor), "other");
+}
+
+BOOST_AUTO_TEST_CASE(decimalRuntimePolicyDecimal)
+{
+    using namespace dec;
+    const decimal<4> price("2.1250");
+    const decimal<2> qty("3.00");
+
+    BOOST_CHECK_EQUAL(decimal_cast<2>(price, round_policy_half_even), decimal<2>("2.12"));
+    BOOST_CHECK_EQUAL(decimal_cast<2>(price, round_policy_half_up), decimal<2>("2.13"));
+    BOOST_CHECK_EQUAL(decimal_cast<2>(-price, round_policy_floor), decimal<2>("-2.13"));
+    BOOST_CHECK_EQUAL(decimal_cast<2>(-price, round_policy_ceiling), decimal<2>("-2.12"));
+    BOOST_CHECK_EQUAL(decimal_cast<6>(price, round_policy_null), decimal<6>("2.125"));
+
+    BOOST_CHECK_EQUAL(multiply(decimal<2>("1.25"), decimal<2>("0.5"), round_policy_half_even), decimal<2>("0.62"));
+    BOOST_CHECK_EQUAL(multiply(decimal<2>("1.25"), decimal<2>("0.5"), round_policy_def), decimal<2>("0.63"));
+    BOOST_CHECK_EQUAL(multiply(price, qty, round_policy_def), decimal<4>("6.375"));
+    BOOST_CHECK_EQUAL(divide(decimal<2>(1), decimal<2>(3), round_policy_ceiling), decimal<2>("0.34"));
+    BOOST_CHECK_EQUAL(divide(decimal<2>(-1), decimal<2>(3), round_policy_round_up), decimal<2>("-0.34"));
+    BOOST_CHECK_EQUAL(divide(decimal<2>(2), decimal<2>(3), round_policy_round_down), decimal<2>("0.66"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalRuntimePolicyNames)
+{
+    using namespace dec;
+    for (int i = round_policy_def; i <= round_policy_round_up; ++i) {
+        const runtime_round_policy policy = static_cast<runtime_round_policy>(i);
+        runtime_round_policy parsed = round_policy_def;
+        BOOST_CHECK(parse_round_policy(round_policy_name(policy), parsed));
+        BOOST_CHECK_EQUAL(parsed, policy);
+    }
+
+    runtime_round_policy parsed = round_policy_floor;
+    BOOST_CHECK(!parse_round_policy("bankers", parsed));
+    BOOST_CHECK_EQUAL(parsed, round_policy_floor);
+    BOOST_CHECK_EQUAL(std::string(round_policy_name(round_policy_half_even)), "half_even");
+}
+
+BOOST_AUTO_TEST_CASE(decimalRuntimePolicyBulk)
+{
+    check_rescale<dec::def_round_policy>(dec::round_policy_def);
+    check_rescale<dec::half_even_round_policy>(dec::round_policy_half_even);
+    check_rescale<dec::ceiling_round_policy>(dec::round_policy_ceiling);
+    check_rescale<dec::floor_round_policy>(dec::round_policy_floor);
+    check_rescale<dec::round_up_round_policy>(dec::round_policy_round_up);
+
+    dec::decimal<4> values[3] = { dec::decimal<4>("1.005"), dec::decimal<4>("1.015"), dec::decimal<4>("-1.005") };
+    dec::decimal<2> output[3];
+    BOOST_CHECK_EQUAL(dec::rescale(values, output, 3, dec::round_policy_half_even), 0u);
+    BOOST_CHECK_EQUAL(output[0], dec::decimal<2>("1.00"));
+    BOOST_CHECK_EQUAL(output[1], dec::decimal<2>("1.02"));
+    BOOST_CHECK_EQUAL(output[2], dec::decimal<2>("-1.00"));
+}
@@ -0,0 +1,352 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal_statistics.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+    typedef dec::decimal<2> value_type;
+
+    template<int Prec>
+    dec::decimal<Prec> make_value(dec::int64 unbiased) {
+        dec::decimal<Prec> result;
+        result.setUnbiased(unbiased);
+        return result;
+    }
+
+    std::vector<value_type> random_values(test_random &random, std::size_t count, dec::int64 range) {
+        std::vector<value_type> result;
+        for (std::size_t i = 0; i < count; ++i) {
+            result.push_back(make_value<2>(random.below(2 * range + 1) - range));
+        }
+        return result;
+    }
+
+    // quantile on sorted copy, with small values calculated in int64
+    dec::int64 reference_quantile(std::vector<value_type> values, dec::int64 p) {
+        std::sort(values.begin(), values.end());
+        const dec::int64 rank = static_cast<dec::int64>(values.size() - 1) * p;
+        const std::size_t lower = static_cast<std::size_t>(rank / 100);
+        const dec::int64 fraction = rank % 100;
+        dec::int64 value = values[lower].getUnbiased() * 100;
+        if (fraction != 0) {
+            value += (values[lower + 1].getUnbiased() - values[lower].getUnbiased()) * fraction;
+        }
+        dec::int64 result;
+        dec::def_round_policy::div_rounded(result, value, 100);
+        return result;
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalStatisticsBasic)
+{
+    const char *texts[] = {"2", "4", "4", "4", "5", "5", "7", "9"};
+    dec::running_stats<2> stats;
+    for (std::size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); ++i) {
+        stats.add(value_type(texts[i]));
+    }
+
+    dec::decimal<4> result;
+    BOOST_CHECK_EQUAL(stats.count(), 8u);
+    BOOST_CHECK_EQUAL(stats.min(), value_type(2));
+    BOOST_CHECK_EQUAL(stats.max(), value_type(9));
+    BOOST_CHECK(stats.sum(result));
+    BOOST_CHECK_EQUAL(result, dec::decimal<4>(40));
+    BOOST_CHECK(stats.mean(result));
+    BOOST_CHECK_EQUAL(result, dec::decimal<4>(5));
+    BOOST_CHECK(stats.population_variance(result));
+    BOOST_CHECK_EQUAL(result, dec::decimal<4>(4));
+    BOOST_CHECK(stats.population_stddev(result));
+    BOOST_CHECK_EQUAL(result, dec::decimal<4>(2));
+    // 32 / 7
+    BOOST_CHECK(stats.variance(result));
+    BOOST_CHECK_EQUAL(result, dec::decimal<4>("4.5714"));
+    BOOST_CHECK(stats.stddev(result));
+    BOOST_CHECK_EQUAL(result, dec::decimal<4>("2.1381"));
+
+    dec::decimal<0> rounded;
+    BOOST_CHECK(stats.variance(rounded));
+    BOOST_CHECK_EQUAL(rounded, dec::decimal<0>(5));
+}
+
+BOOST_AUTO_TEST_CASE(decimalStatisticsEmpty)
+{
+    dec::running_stats<2> stats;
+    dec::decimal<2> result;
+    BOOST_CHECK(stats.empty());
+    BOOST_CHECK(!stats.mean(result));
+    BOOST_CHECK(!stats.variance(result));
+    BOOST_CHECK(!stats.population_stddev(result));
+    BOOST_CHECK(stats.sum(result));
+    BOOST_CHECK_EQUAL(result, dec::decimal<2>(0));
+
+    stats.add(value_type("1.5"));
+    BOOST_CHECK(stats.mean(result));
+    BOOST_CHECK_EQUAL(result, dec::decimal<2>("1.5"));
+    BOOST_CHECK(!stats.variance(result));
+    BOOST_CHECK(stats.population_variance(result));
+    BOOST_CHECK_EQUAL(result, dec::decimal<2>(0));
+}
+
+BOOST_AUTO_TEST_CASE(decimalStatisticsRounding)
+{
+    dec::running_stats<1> stats;
+    stats.add(dec::decimal<1>("-2.5"));
+    stats.add(dec::decimal<1>("2.5"));
+
+    // standard deviation is exactly 2.5, so it is rounded only by output policy
+    dec::decimal<0, dec::half_even_round_policy> even;
+    dec::decimal<0, dec::half_up_round_policy> up;
+    dec::decimal<0, dec::floor_round_policy> floor;
+    BOOST_CHECK(stats.population_stddev(even));
+    BOOST_CHECK_EQUAL(even.getUnbiased(), 2);
+    BOOST_CHECK(stats.population_stddev(up));
+    BOOST_CHECK_EQUAL(up.getUnbiased(), 3);
+
+    // 2 / 3 and -2 / 3
+    dec::running_stats<0> thirds;
+    thirds.add(dec::decimal<0>(1));
+    thirds.add(dec::decimal<0>(0));
+    thirds.add(dec::decimal<0>(1));
+    BOOST_CHECK(thirds.mean(floor));
+    BOOST_CHECK_EQUAL(floor.getUnbiased(), 0);
+    BOOST_CHECK(thirds.mean(up));
+    BOOST_CHECK_EQUAL(up.getUnbiased(), 1);
+
+    dec::running_stats<0> negative;
+    negative.add(dec::decimal<0>(-1));
+    negative.add(dec::decimal<0>(0));
+    negative.add(dec::decimal<0>(-1));
+    BOOST_CHECK(negative.mean(floor));
+    BOOST_CHECK_EQUAL(floor.getUnbiased(), -1);
+    BOOST_CHECK(negative.mean(up));
+    BOOST_CHECK_EQUAL(up.getUnbiased(), -1);
+}
+
+BOOST_AUTO_TEST_CASE(decimalStatisticsZeroDeviation)
+{
+    // deviation of constant data is exactly zero, also for directed rounding
+    dec::running_stats<2> constant;
+    constant.add(value_type("3.25"));
+    constant.add(value_type("3.25"));
+    constant.add(value_type("3.25"));
+
+    dec::decimal<4, dec::ceiling_round_policy> ceiling;
+    dec::decimal<4, dec::round_up_round_policy> up;
+    BOOST_CHECK(constant.stddev(ceiling));
+    BOOST_CHECK_EQUAL(ceiling.getUnbiased(), 0);
+    BOOST_CHECK(constant.population_stddev(ceiling));
+    BOOST_CHECK_EQUAL(ceiling.getUnbiased(), 0);
+    BOOST_CHECK(constant.stddev(up));
+    BOOST_CHECK_EQUAL(up.getUnbiased(), 0);
+    BOOST_CHECK(constant.variance(up));
+    BOOST_CHECK_EQUAL(up.getUnbiased(), 0);
+
+    dec::running_stats<2> single;
+    single.add(value_type("-7.5"));
+    BOOST_CHECK(single.population_stddev(ceiling));
+    BOOST_CHECK_EQUAL(ceiling.getUnbiased(), 0);
+    BOOST_CHECK(single.population_stddev(up));
+    BOOST_CHECK_EQUAL(up.getUnbiased(), 0);
+
+    // tiny non-zero deviation is still rounded up
+    dec::running_stats<2> spread;
+    spread.add(value_type("1"));
+    spread.add(value_type("1.01"));
+    dec::decimal<1, dec::ceiling_round_policy> coarse;
+    BOOST_CHECK(spread.population_stddev(coarse));
+    BOOST_CHECK_EQUAL(coarse.getUnbiased(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(decimalStatisticsWide)
+{
+    // sums far above int64 range
+    dec::running_stats<2> stats;
+    for (int i = 0; i < 1000; ++i) {
+        stats.add(make_value<2>(DEC_MAX_INT64));
+        stats.add(make_value<2>(DEC_MIN_INT64));
+    }
+
+    dec::decimal<3> mean;
+    BOOST_CHECK(stats.mean(mean));
+    BOOST_CHECK_EQUAL(mean.getUnbiased(), -5);
+    BOOST_CHECK_EQUAL(stats.min().getUnbiased(), DEC_MIN_INT64);
+    BOOST_CHECK_EQUAL(stats.max().getUnbiased(), DEC_MAX_INT64);
+
+    dec::decimal<2> sum;
+    BOOST_CHECK(stats.sum(sum));
+    BOOST_CHECK_EQUAL(sum.getUnbiased(), -1000);
+
+    // population standard deviation is (MAX - MIN) / 2
+    dec::decimal<0> stddev;
+    BOOST_CHECK(stats.population_stddev(stddev));
+    BOOST_CHECK_EQUAL(stddev.getUnbiased(), 92233720368547758LL);
+    BOOST_CHECK(!stats.population_variance(stddev));
+
+    dec::running_stats<2> same;
+    for (int i = 0; i < 1000; ++i) {
+        same.add(make_value<2>(DEC_MAX_INT64));
+    }
+    dec::decimal<2> result;
+    BOOST_CHECK(same.mean(result));
+    BOOST_CHECK_EQUAL(result.getUnbiased(), DEC_MAX_INT64);
+    BOOST_CHECK(same.variance(result));
+    BOOST_CHECK_EQUAL(result.getUnbiased(), 0);
+    BOOST_CHECK(!same.sum(result));
+}
+
+BOOST_AUTO_TEST_CASE(decimalStatisticsMatchesReference)
+{
+    test_random random(11);
+    for (int round = 0; round < 50; ++round) {
+        const std::size_t count = static_cast<std::size_t>(random.below(500)) + 2;
+        const std::vector<value_type> values = random_values(random, count, 1000000);
+
+        dec::int64 sum = 0, sumSquares = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            sum += values[i].getUnbiased();
+            sumSquares += values[i].getUnbiased() * values[i].getUnbiased();
+        }
+        const dec::int64 n = static_cast<dec::int64>(count);
+        const dec::int64 deviations = n * sumSquares - sum * sum;
+
+        dec::decimal<4> mean, variance, stddev;
+        BOOST_REQUIRE(dec::mean(&values[0], count, mean));
+        BOOST_REQUIRE(dec::variance(&values[0], count, variance));
+        BOOST_REQUIRE(dec::stddev(&values[0], count, stddev));
+
+        dec::int64 expected;
+        dec::def_round_policy::div_rounded(expected, sum * 100, n);
+        BOOST_CHECK_EQUAL(mean.getUnbiased(), expected);
+        dec::def_round_policy::div_rounded(expected, deviations, n * (n - 1));
+        BOOST_CHECK_EQUAL(variance.getUnbiased(), expected);
+
+        // correctly rounded root is within half unit of exact one
+        const double root = std::sqrt(static_cast<double>(deviations) / static_cast<double>(n * (n - 1))) * 100;
+        BOOST_CHECK(std::fabs(static_cast<double>(stddev.getUnbiased()) - root) <= 0.5 + root * 1e-12);
+
+        // parallel form gives the same results
+        dec::running_stats<2> parts[3];
+        for (std::size_t i = 0; i < count; ++i) {
+            parts[i % 3].add(values[i]);
+        }
+        parts[1].merge(parts[2]);
+        parts[0].merge(parts[1]);
+        dec::decimal<4> merged;
+        BOOST_CHECK(parts[0].mean(merged));
+        BOOST_CHECK_EQUAL(merged, mean);
+        BOOST_CHECK(parts[0].stddev(merged));
+        BOOST_CHECK_EQUAL(merged, stddev);
+        BOOST_CHECK_EQUAL(parts[0].count(), static_cast<dec::details::uint64>(count));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(decimalStatisticsVwap)
+{
+    dec::vwap_accumulator<2, 0> accumulator;
+    accumulator.add(dec::decimal<2>("10.00"), dec::decimal<0>(100));
+    accumulator.add(dec::decimal<2>("11.00"), dec::decimal<0>(300));
+
+    dec::decimal<4> result;
+    BOOST_CHECK(accumulator.vwap(result));
+    BOOST_CHECK_EQUAL(result, dec::decimal<4>("10.75"));
+    dec::decimal<0> volume;
+    BOOST_CHECK(accumulator.volume(volume));
+    BOOST_CHECK_EQUAL(volume, dec::decimal<0>(400));
+
+    // 10.01 * 1 + 10.02 * 2 = 30.05, / 3 = 10.01666...
+    dec::vwap_accumulator<2, 0> other;
+    other.add(dec::decimal<2>("10.01"), dec::decimal<0>(1));
+    other.add(dec::decimal<2>("10.02"), dec::decimal<0>(2));
+    dec::decimal<2> rounded;
+    BOOST_CHECK(other.vwap(rounded));
+    BOOST_CHECK_EQUAL(rounded, dec::decimal<2>("10.02"));
+
+    other.merge(accumulator);
+    BOOST_CHECK_EQUAL(other.count(), 4u);
+    BOOST_CHECK(other.vwap(result));
+    // (4300 + 30.05) / 403
+    BOOST_CHECK_EQUAL(result, dec::decimal<4>("10.7445"));
+
+    dec::vwap_accumulator<2, 0> empty;
+    BOOST_CHECK(!empty.vwap(result));
+
+    // large notional, exact in the middle
+    dec::decimal<2> prices[2] = {make_value<2>(DEC_MAX_INT64), make_value<2>(DEC_MAX_INT64 - 2)};
+    dec::decimal<0> quantities[2] = {make_value<0>(DEC_MAX_INT64), make_value<0>(DEC_MAX_INT64)};
+    BOOST_CHECK(dec::vwap(prices, quantities, 2, rounded));
+    BOOST_CHECK_EQUAL(rounded.getUnbiased(), DEC_MAX_INT64 - 1);
+}
+
+BOOST_AUTO_TEST_CASE(decimalStatisticsQuantile)
+{
+    std::vector<value_type> values;
+    for (int i = 10; i >= 1; --i) {
+        values.push_back(value_type(i));
+    }
+
+    value_type result;
+    BOOST_CHECK(dec::median(&values[0], values.size(), result));
+    BOOST_CHECK_EQUAL(result, value_type("5.5"));
+    BOOST_CHECK(dec::quantile(&values[0], values.size(), dec::decimal<2>("0.95"), result));
+    BOOST_CHECK_EQUAL(result, value_type("9.55"));
+    BOOST_CHECK(dec::quantile(&values[0], values.size(), dec::decimal<0>(0), result));
+    BOOST_CHECK_EQUAL(result, value_type(1));
+    BOOST_CHECK(dec::quantile(&values[0], values.size(), dec::decimal<0>(1), result));
+    BOOST_CHECK_EQUAL(result, value_type(10));
+    BOOST_CHECK(!dec::quantile(&values[0], values.size(), dec::decimal<2>("1.01"), result));
+    BOOST_CHECK(!dec::quantile(&values[0], values.size(), dec::decimal<2>("-0.01"), result));
+    BOOST_CHECK(!dec::quantile(&values[0], 0, dec::decimal<2>("0.5"), result));
+    // input array is not changed
+    BOOST_CHECK_EQUAL(values[0], value_type(10));
+
+    // rounded with output policy
+    dec::decimal<0, dec::half_even_round_policy> even;
+    BOOST_CHECK(dec::median(&values[0], values.size(), even));
+    BOOST_CHECK_EQUAL(even.getUnbiased(), 6);
+    values.push_back(value_type(-1));
+    values.push_back(value_type(-2));
+    // -2, -1, 1, 2, ... 10: rank 2.2 -> 1.2
+    BOOST_CHECK(dec::quantile(&values[0], values.size(), dec::decimal<1>("0.2"), result));
+    BOOST_CHECK_EQUAL(result, value_type("1.2"));
+    // rank 0.55 -> -1.45
+    BOOST_CHECK(dec::quantile(&values[0], values.size(), dec::decimal<2>("0.05"), result));
+    BOOST_CHECK_EQUAL(result, value_type("-1.45"));
+
+    dec::exact_quantiles<2> extreme;
+    extreme.add(make_value<2>(DEC_MIN_INT64));
+    extreme.add(make_value<2>(DEC_MAX_INT64));
+    // -0.5, rounded away from zero
+    BOOST_CHECK(extreme.median(result));
+    BOOST_CHECK_EQUAL(result.getUnbiased(), -1);
+}
+
+BOOST_AUTO_TEST_CASE(decimalStatisticsQuantileMatchesReference)
+{
+    test_random random(13);
+    for (int round = 0; round < 50; ++round) {
+        const std::size_t count = static_cast<std::size_t>(random.below(300)) + 1;
+        const std::vector<value_type> values = random_values(random, count, round % 2 == 0 ? 100 : 100000);
+
+        dec::exact_quantiles<2> parts[2];
+        for (std::size_t i = 0; i < count; ++i) {
+            parts[i % 2].add(values[i]);
+        }
+        parts[0].merge(parts[1]);
+        BOOST_REQUIRE_EQUAL(parts[0].size(), count);
+
+        for (int i = 0; i < 10; ++i) {
+            const dec::int64 p = random.below(101);
+            value_type result;
+            BOOST_REQUIRE(parts[0].quantile(make_value<2>(p), result));
+            BOOST_CHECK_EQUAL(result.getUnbiased(), reference_quantile(values, p));
+        }
+    }
+}
@@ -0,0 +1,110 @@
+//
+// Created by piotr on 10/19/26.
+//
+// Built as separate runner with DEC_ENABLE_STATS defined.
+
+#include "decimal.h"
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+namespace {
+
+    unsigned long long stats_delta(const dec::decimal_stats &before, const dec::decimal_stats &after,
+                                   dec::stats_event event) {
+        return after[event] - before[event];
+    }
+
+    unsigned long long hook_calls[dec::stats_event_count];
+
+    void count_hook(dec::stats_event event) {
+        ++hook_calls[event];
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalStatsMultDivTiers)
+{
+    using namespace dec;
+
+    decimal_stats before = get_stats();
+    decimal<2> product = decimal<2>("1.5") * decimal<2>("2.25");
+    BOOST_CHECK_EQUAL(product, decimal<2>("3.38"));
+    decimal_stats after = get_stats();
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_mult_div_direct), 1u);
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_mult_div_gcd), 0u);
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_mult_div_cross_float), 0u);
+
+    // fractional parts overflow, but can be reduced
+    before = get_stats();
+    BOOST_CHECK_EQUAL(decimal<18>("0.5") * decimal<18>("0.5"), decimal<18>("0.25"));
+    after = get_stats();
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_mult_div_gcd), 1u);
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_mult_div_cross_float), 0u);
+
+    // fractional parts are coprime with divisor
+    before = get_stats();
+    decimal<18> value = decimal<18>("0.333333333333333333") * decimal<18>("0.777777777777777777");
+    after = get_stats();
+    BOOST_CHECK(value > decimal<18>("0.259"));
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_mult_div_cross_float), 1u);
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_mult_div_direct), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(decimalStatsOverflow)
+{
+    using namespace dec;
+
+    decimal_stats before = get_stats();
+    int64 output;
+    BOOST_CHECK(!div_rounded(output, DEC_MAX_INT64, 10));
+    BOOST_CHECK(!half_up_round_policy::div_rounded(output, DEC_MAX_INT64, 10));
+    BOOST_CHECK(div_rounded(output, 15, 10));
+    decimal_stats after = get_stats();
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_div_overflow), 2u);
+
+    // product of fractional parts close to limit is rounded without overflow
+    before = get_stats();
+    BOOST_CHECK_EQUAL(dec_utils<def_round_policy>::multDiv(3000000000LL, 3074457345LL, 4000000000LL),
+                      2305843009LL);
+    after = get_stats();
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_round_failure), 0u);
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_div_overflow), 0u);
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_mult_div_direct), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(decimalStatsHook)
+{
+    using namespace dec;
+
+    for (int i = 0; i < stats_event_count; ++i) {
+        hook_calls[i] = 0;
+    }
+    stats_hook previous = set_stats_hook(&count_hook);
+    int64 output;
+    div_rounded(output, DEC_MAX_INT64, 10);
+    decimal<4> value = decimal<4>("1.5") * decimal<4>("3");
+    BOOST_CHECK_EQUAL(set_stats_hook(previous), &count_hook);
+    value = value * value;
+
+    BOOST_CHECK_EQUAL(hook_calls[stats_div_overflow], 1u);
+    BOOST_CHECK_EQUAL(hook_calls[stats_mult_div_direct], 1u);
+}
+
+BOOST_AUTO_TEST_CASE(decimalStatsThreads)
+{
+    using namespace dec;
+
+    const decimal_stats before = get_stats();
+    std::thread worker([]() {
+        decimal<2> value(1);
+        for (int i = 0; i < 1000; ++i) {
+            value = value * decimal<2>("1.01");
+            value = value / decimal<2>("1.01");
+        }
+    });
+    worker.join();
+    const decimal_stats after = get_stats();
+
+    // counters of finished thread are kept
+    BOOST_CHECK_EQUAL(stats_delta(before, after, stats_mult_div_direct), 2000u);
+}
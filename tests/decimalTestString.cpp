@@ -4,6 +4,7 @@
 
 #include "decimal.h"
 #include <boost/test/unit_test.hpp>
+#include <cstring>
 
 BOOST_AUTO_TEST_CASE(decimalString)
 {
@@ -198,4 +199,32 @@ BOOST_AUTO_TEST_CASE(decimalFromStringWithGlobalItLocaleAndProvidedFormat) {
 
     std::cout.imbue(prior_cout_locale);
     std::locale::global(prior_locale);
-}
\ No newline at end of file
+}
+
+namespace {
+
+template<typename T>
+bool parse_checked(const char *text, T &out) {
+    return dec::fromString(text, std::strlen(text), dec::basic_decimal_format(), out);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalFromStringOverflow) {
+    dec::decimal<2> d2;
+    BOOST_CHECK(!parse_checked("130000000000000000.5", d2));
+    BOOST_CHECK(!parse_checked("-92233720368547758.09", d2));
+    BOOST_CHECK(parse_checked("-92233720368547758.08", d2));
+    BOOST_CHECK_EQUAL(d2.getUnbiased(), DEC_MIN_INT64);
+    BOOST_CHECK(!parse_checked("99999999999999999999999", d2));
+    BOOST_CHECK_EQUAL(d2.getUnbiased(), 0);
+
+    dec::decimal<0> d0;
+    BOOST_CHECK(parse_checked("-9223372036854775808", d0));
+    BOOST_CHECK_EQUAL(d0.getUnbiased(), DEC_MIN_INT64);
+    BOOST_CHECK(!parse_checked("9223372036854775808", d0));
+
+    // exponent after all digits of precision
+    BOOST_CHECK(parse_checked("9.223372036854775498e18", d0));
+    BOOST_CHECK_EQUAL(d0.getUnbiased(), 9223372036854775498LL);
+}
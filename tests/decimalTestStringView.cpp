@@ -0,0 +1,84 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal.h"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+
+namespace {
+
+    // result of parsing the same text with stream
+    template<typename T>
+    T parse_with_stream(const std::string &text, const dec::basic_decimal_format &format) {
+        std::istringstream input(text);
+        T result;
+        if (!dec::fromStream(input, format, result)) {
+            result.setUnbiased(0);
+        }
+        return result;
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalParseBuffer)
+{
+    using namespace dec;
+    // slice of a buffer, without terminating zero
+    const char message[] = "px=101.255;qty=7";
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >(message + 3, 7), decimal<2>("101.26"));
+    BOOST_CHECK_EQUAL(fromString<decimal<3> >(message + 3, 7), decimal<3>("101.255"));
+    BOOST_CHECK_EQUAL(fromString<decimal<0> >(message + 15, 1), decimal<0>(7));
+    BOOST_CHECK_EQUAL(decimal_cast<2>(message + 3, 3), decimal<2>(101));
+    BOOST_CHECK_EQUAL((decimal_cast<2, half_even_round_policy>(message + 3, 7)), (decimal<2, half_even_round_policy>("101.26")));
+
+    decimal<4> value;
+    fromString(message + 3, 5, value);
+    BOOST_CHECK_EQUAL(value, decimal<4>("101.2"));
+    fromString(message, 2, value);
+    BOOST_CHECK_EQUAL(value, decimal<4>(0));
+
+    const decimal_format format(',', '.');
+    const char localized[] = "1.234,5|";
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >(localized, 7, format), decimal<2>("1234.5"));
+    BOOST_CHECK_EQUAL(decimal<2>("1.234,5", format), decimal<2>("1234.5"));
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >("-12.5"), decimal<2>("-12.5"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalParseBufferSameAsStream)
+{
+    using namespace dec;
+    const char *texts[] = {
+        "0", "1", "-1", "+1", "12.", ".5", "-.5", "1.005", "  12.5x", "\t-3.25", "1,234.5",
+        "12 ", ".", "-", "", "abc", "1.2345678901234567891", "-99999999.999999", "--1", "1e5",
+        "12,345,678.1"
+    };
+    const decimal_format grouped('.', ',', true);
+    for (std::size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); ++i) {
+        const std::string text(texts[i]);
+        BOOST_CHECK_EQUAL(fromString<decimal<3> >(text.data(), text.size(), grouped),
+                          parse_with_stream<decimal<3> >(text, grouped));
+        BOOST_CHECK_EQUAL(fromString<decimal<2> >(text.data(), text.size(), basic_decimal_format()),
+                          parse_with_stream<decimal<2> >(text, basic_decimal_format()));
+    }
+}
+
+#if DEC_USE_STRING_VIEW
+BOOST_AUTO_TEST_CASE(decimalParseStringView)
+{
+    using namespace dec;
+    const std::string_view message = "px=101.255;qty=7";
+    const std::string_view price = message.substr(3, 7);
+
+    BOOST_CHECK_EQUAL(decimal<3>(price), decimal<3>("101.255"));
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >(price), decimal<2>("101.26"));
+    BOOST_CHECK_EQUAL(decimal_cast<1>(price), decimal<1>("101.3"));
+    BOOST_CHECK_EQUAL((decimal_cast<1, floor_round_policy>(price)), (decimal<1, floor_round_policy>("101.2")));
+    BOOST_CHECK_EQUAL(decimal<2>(std::string_view("1.234,5"), decimal_format(',', '.')), decimal<2>("1234.5"));
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >(std::string_view("7,5"), decimal_format(',')), decimal<2>("7.5"));
+
+    // literals and strings are still accepted
+    BOOST_CHECK_EQUAL(decimal<2>(std::string("1.5")), decimal<2>("1.5"));
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >("1.5"), decimal_cast<2>("1.5"));
+}
+#endif
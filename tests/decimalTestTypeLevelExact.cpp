@@ -0,0 +1,109 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal.h"
+#include <boost/test/unit_test.hpp>
+
+#if DEC_TYPE_LEVEL > 2
+
+namespace {
+
+    template<int Prec, class RoundPolicy>
+    int precision_of(const dec::decimal<Prec, RoundPolicy> &) {
+        return Prec;
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalTypeLevelExactResultTypes)
+{
+    using namespace dec;
+    const decimal<2> d2("1.25");
+    const decimal<4> d4("0.3333");
+    const decimal<6> d6("-2.000001");
+
+    BOOST_CHECK_EQUAL(precision_of(d2 + d4), 4);
+    BOOST_CHECK_EQUAL(precision_of(d4 + d2), 4);
+    BOOST_CHECK_EQUAL(precision_of(d6 - d2), 6);
+    BOOST_CHECK_EQUAL(precision_of(d2 * d4), 6);
+    BOOST_CHECK_EQUAL(precision_of(d4 * d6), 10);
+
+    // same precision works as before
+    BOOST_CHECK_EQUAL(precision_of(d2 + d2), 2);
+    BOOST_CHECK_EQUAL(precision_of(d2 * d2), 2);
+
+    // division is not exact, result has precision of left argument
+    BOOST_CHECK_EQUAL(precision_of(d2 / d4), 2);
+
+    // product would exceed max_decimal_points, it is rounded as on level 2
+    const decimal<9> d9("1.000000001");
+    const decimal<10> d10("2.0000000005");
+    BOOST_CHECK_EQUAL(precision_of(d9 * d10), 9);
+    BOOST_CHECK_EQUAL(d9 * d10, decimal<9>("2.000000003"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalTypeLevelExactValues)
+{
+    using namespace dec;
+    const decimal<2> d2("1.25");
+    const decimal<4> d4("0.3333");
+    const decimal<6> d6("-2.000001");
+
+    BOOST_CHECK_EQUAL(d2 + d4, decimal<4>("1.5833"));
+    BOOST_CHECK_EQUAL(d4 - d2, decimal<4>("-0.9167"));
+    BOOST_CHECK_EQUAL(d6 - d2, decimal<6>("-3.250001"));
+    BOOST_CHECK_EQUAL(d2 * d4, decimal<6>("0.416625"));
+    BOOST_CHECK_EQUAL(d4 * d6, decimal<10>("-0.6666003333"));
+
+    // rounding is done only by explicit cast or assignment
+    BOOST_CHECK_EQUAL(decimal_cast<2>(d2 * d4), decimal<2>("0.42"));
+    decimal<4> assigned;
+    assigned = d2 * d4;
+    BOOST_CHECK_EQUAL(assigned, decimal<4>("0.4166"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalTypeLevelExactCrossRate)
+{
+    using namespace dec;
+    // EUR amount converted to USD, then to JPY, with fee in USD
+    const decimal<2> amount("1234.56");
+    const decimal<6> eurUsd("1.087654");
+    const decimal<4> usdJpy("151.2345");
+    const decimal<2> fee("2.50");
+
+    const decimal<8> usd = amount * eurUsd;
+    BOOST_CHECK_EQUAL(usd, decimal<8>("1342.77412224"));
+    const decimal<8> net = usd - fee;
+    BOOST_CHECK_EQUAL(net, decimal<8>("1340.27412224"));
+
+    // rounded only once, at the end
+    BOOST_CHECK_EQUAL(precision_of(net * usdJpy), 12);
+    BOOST_CHECK_EQUAL(decimal_cast<2>(net * usdJpy), decimal<2>("202695.69"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalTypeLevelExactOverflow)
+{
+    using namespace dec;
+    // results which do not fit in int64 are set to zero
+    BOOST_CHECK_EQUAL(decimal<8>("100000") * decimal<6>("2"), decimal<14>(0));
+    BOOST_CHECK_EQUAL(decimal<2>("100000000000") + decimal<8>("1"), decimal<8>(0));
+    BOOST_CHECK_EQUAL(decimal<8>("1") - decimal<2>("-100000000000"), decimal<8>(0));
+    BOOST_CHECK_EQUAL(decimal<2>("-100000000000") - decimal<8>("1"), decimal<8>(0));
+
+    // scaled values fit, but their sum does not
+    const decimal<8> large("92233720368.5");
+    BOOST_CHECK_EQUAL(large + decimal<2>("0.5"), decimal<8>(0));
+    BOOST_CHECK_EQUAL(decimal<2>("-0.5") - large, decimal<8>(0));
+
+    // large values which fit are still exact
+    BOOST_CHECK_EQUAL(decimal<8>("10000") * decimal<6>("-2"), decimal<14>("-20000"));
+    BOOST_CHECK_EQUAL(decimal<2>("92233720368") + decimal<8>("0.54775807"),
+                      decimal<8>("92233720368.54775807"));
+    BOOST_CHECK_EQUAL(decimal<2>("-92233720368") - decimal<8>("0.54775807"),
+                      decimal<8>("-92233720368.54775807"));
+    BOOST_CHECK_EQUAL(decimal<0>("3037000499") * decimal<1>("300000000.5"),
+                      decimal<1>("911100151218500249.5"));
+}
+
+#endif // DEC_TYPE_LEVEL > 2
@@ -0,0 +1,139 @@
+//
+// Created by piotr on 10/19/26.
+//
+
+#include "decimal.h"
+#include "decimalTestUtils.h"
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+
+namespace {
+
+    // narrow no-break space, as used in French
+    DEC_CONSTEXPR dec::unicode_format_spec french_spec = {',', 0x202F, true, {3}};
+    // Arabic decimal and thousands separators
+    DEC_CONSTEXPR dec::unicode_format_spec arabic_spec = {0x066B, 0x066C, true, {3}};
+
+    struct wide_punct : std::numpunct<wchar_t> {
+        wchar_t do_thousands_sep() const { return L' '; }
+        std::string do_grouping() const { return "\3"; }
+        wchar_t do_decimal_point() const { return L','; }
+    };
+
+    template<class CharT>
+    void check_round_trip(const dec::unicode_format_spec &format) {
+        test_random random(5);
+        for (int i = 0; i < 300; ++i) {
+            dec::decimal<4> value;
+            value.setUnbiased(random.unbiased());
+
+            const std::basic_string<CharT> text = dec::toString<CharT>(value, format);
+            dec::decimal<4> parsed;
+            BOOST_CHECK(dec::fromString(text.data(), text.size(), format, parsed));
+            BOOST_CHECK_EQUAL(parsed, value);
+        }
+    }
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(decimalUnicodeFormat)
+{
+    using namespace dec;
+    const decimal<2> value("-1234567.5");
+    BOOST_CHECK(toString<char>(value, french_spec) == "-1\xE2\x80\xAF" "234\xE2\x80\xAF" "567,50");
+    BOOST_CHECK(toString<char16_t>(value, french_spec) == u"-1 234 567,50");
+    BOOST_CHECK(toString<char32_t>(value, arabic_spec) == U"-1٬234٬567٫50");
+    BOOST_CHECK(toString<wchar_t>(value, arabic_spec) == L"-1٬234٬567٫50");
+    BOOST_CHECK(toString<char32_t>(decimal<0>(7), arabic_spec) == U"7");
+
+    // separators outside of BMP are written as surrogate pairs
+    const unicode_format_spec wide = {0x1F4B0, ',', false, {0}};
+    BOOST_CHECK(toString<char16_t>(decimal<1>("1.5"), wide) == u"1\U0001F4B05");
+    BOOST_CHECK(toString<char>(decimal<1>("1.5"), wide) == "1\xF0\x9F\x92\xB0" "5");
+
+    char16_t buffer[max_unicode_units];
+    char16_t *end = toString(value, french_spec, buffer);
+    BOOST_CHECK(std::u16string(buffer, end) == u"-1 234 567,50");
+
+#ifdef __cpp_char8_t
+    BOOST_CHECK(toString<char8_t>(value, french_spec) == u8"-1 234 567,50");
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(decimalUnicodeParse)
+{
+    using namespace dec;
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >(std::u16string(u" 1 234,5"), french_spec), decimal<2>("1234.5"));
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >(std::wstring(L"-12٬345٫67"), arabic_spec),
+                      decimal<2>("-12345.67"));
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >(std::string("1\xE2\x80\xAF" "000,25"), french_spec),
+                      decimal<2>("1000.25"));
+    BOOST_CHECK_EQUAL(fromString<decimal<4> >(std::u32string(U"1,5e3"), french_spec), decimal<4>("1500"));
+
+    // long inputs are read without intermediate buffer
+    const std::u32string longText = U"0000000000000000000000000000000000000000000000000000000000000000000012,5";
+    BOOST_CHECK_EQUAL(fromString<decimal<2> >(longText, french_spec), decimal<2>("12.5"));
+
+    decimal<2> output;
+    // '.' is not decimal point of format
+    BOOST_CHECK(!fromString(U"x", 1, french_spec, output));
+    BOOST_CHECK(!fromString(U".5", 2, french_spec, output));
+    // digits other than ASCII and broken sequences are rejected
+    BOOST_CHECK(!fromString(U"١", 1, arabic_spec, output));
+    BOOST_CHECK(!fromString("\xE2\x80", 2, french_spec, output));
+    BOOST_CHECK(!fromString(u"\xD800" u"1", 2, french_spec, output));
+    BOOST_CHECK_EQUAL(output, decimal<2>(0));
+}
+
+BOOST_AUTO_TEST_CASE(decimalUnicodeRoundTrip)
+{
+    check_round_trip<char>(french_spec);
+    check_round_trip<char16_t>(french_spec);
+    check_round_trip<char32_t>(arabic_spec);
+    check_round_trip<wchar_t>(arabic_spec);
+    check_round_trip<char16_t>(dec::make_unicode_format_spec());
+}
+
+BOOST_AUTO_TEST_CASE(decimalUnicodeFormatClass)
+{
+    using namespace dec;
+    const decimal_format format(french_spec);
+    BOOST_CHECK(format.has_unicode_separators());
+    BOOST_CHECK_EQUAL(format.thousands_sep_code(), 0x202Fu);
+    BOOST_CHECK_EQUAL(format.decimal_point_code(), 0u);
+    BOOST_CHECK_EQUAL(format.decimal_point(), ',');
+
+    // std::string is UTF-8
+    const std::string text = toString(decimal<2>("9876543.21"), format);
+    BOOST_CHECK_EQUAL(text, "9\xE2\x80\xAF" "876\xE2\x80\xAF" "543,21");
+    BOOST_CHECK_EQUAL(decimal<2>(text, format), decimal<2>("9876543.21"));
+    BOOST_CHECK_EQUAL(toStringWithExponent(decimal<2>("-1.25"), decimal_format(arabic_spec)),
+                      "-1\xD9\xAB" "25e0");
+    BOOST_CHECK(!decimal_format(',', '.').has_unicode_separators());
+}
+
+BOOST_AUTO_TEST_CASE(decimalUnicodeWideStream)
+{
+    using namespace dec;
+    const std::locale locale(std::locale::classic(), new wide_punct);
+
+    std::wostringstream output;
+    output.imbue(locale);
+    output << decimal<2>("-1234.5") << L'|' << std::setw(8) << decimal<1>("1.5") << L'|'
+           << std::left << std::setfill(L'*') << std::setw(6) << decimal<0>(12) << L'|';
+    BOOST_CHECK(output.str() == L"-1 234,50|     1,5|12****|");
+
+    std::wistringstream input(L" 12 345,25 -0,5 1.5");
+    input.imbue(locale);
+    decimal<2> first, second, third;
+    input >> first >> second >> third;
+    BOOST_CHECK_EQUAL(first, decimal<2>("12345.25"));
+    BOOST_CHECK_EQUAL(second, decimal<2>("-0.5"));
+    // '.' is not decimal point of stream
+    BOOST_CHECK_EQUAL(third, decimal<2>("1"));
+
+    std::wistringstream plain(L"3.75");
+    decimal<2> value;
+    plain >> value;
+    BOOST_CHECK_EQUAL(value, decimal<2>("3.75"));
+}
@@ -5,6 +5,35 @@
 #ifndef DECIMAL_FOR_CPP_DECIMALTESTUTILS_H
 #define DECIMAL_FOR_CPP_DECIMALTESTUTILS_H
 
+#include "decimal.h"
+#include <string>
+
 std::string uint_to_string(unsigned int arg);
 
+/// Linear congruential generator for test and benchmark data, the same sequence on every platform
+class test_random {
+public:
+    explicit test_random(dec::details::uint64 seed) : m_state(seed) {
+    }
+
+    dec::details::uint64 next() {
+        m_state = m_state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return m_state;
+    }
+
+    /// Returns value in [0, range), range has to be positive
+    dec::int64 below(dec::int64 range) {
+        return static_cast<dec::int64>((next() >> 16) % static_cast<dec::details::uint64>(range));
+    }
+
+    /// Returns value with random sign and magnitude, from -1 and 0 up to full int64 range
+    dec::int64 unbiased() {
+        const dec::details::uint64 value = next();
+        return static_cast<dec::int64>(value) >> static_cast<int>(value % 63);
+    }
+
+private:
+    dec::details::uint64 m_state;
+};
+
 #endif //DECIMAL_FOR_CPP_DECIMALTESTUTILS_H
@@ -4,6 +4,8 @@
 
 #include "decimal.h"
 #include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <string>
 
 BOOST_AUTO_TEST_CASE(decimalWithExponent)
 {
@@ -57,3 +59,171 @@ BOOST_AUTO_TEST_CASE(decimalWithExponent)
     BOOST_CHECK_EQUAL(dec::decimal<4>::buildWithExponent(1, -15), dec::decimal<4>("0"));
 }
 
+
+namespace {
+
+    template<class T>
+    bool parse_with_exponent(const std::string &text, T &output) {
+        std::istringstream input(text);
+        return dec::fromStream(input, output);
+    }
+
+    // text left in stream after operator>>
+    template<class T>
+    std::string rest_after_read(const std::string &text, T &output) {
+        std::istringstream input(text);
+        input >> output;
+        std::string rest;
+        std::getline(input, rest);
+        return rest;
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(decimalWithExponentLimits)
+{
+    dec::decimal<4> value;
+
+    // divisor above 10^18 is handled without pow10 table
+    BOOST_CHECK(value.setWithExponent(5, -30));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(0));
+    BOOST_CHECK(value.setWithExponent(DEC_MAX_INT64, -30));
+    BOOST_CHECK_EQUAL(value.getUnbiased(), 0);
+    BOOST_CHECK(value.setWithExponent(DEC_MAX_INT64, -22));
+    BOOST_CHECK_EQUAL(value.getUnbiased(), 9);
+    BOOST_CHECK(value.setWithExponent(-DEC_MAX_INT64, -22));
+    BOOST_CHECK_EQUAL(value.getUnbiased(), -9);
+    BOOST_CHECK(value.setWithExponent(DEC_MAX_INT64, -20));
+    BOOST_CHECK_EQUAL(value.getUnbiased(), 922);
+
+    // overflow is reported
+    BOOST_CHECK(!value.setWithExponent(1, 15));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(0));
+    BOOST_CHECK(!value.setWithExponent(-1, 40));
+    BOOST_CHECK(value.setWithExponent(0, 40));
+    BOOST_CHECK(value.setWithExponent(9, 14));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("900000000000000"));
+}
+
+BOOST_AUTO_TEST_CASE(decimalParseExponent)
+{
+    dec::decimal<4> value;
+
+    BOOST_CHECK(parse_with_exponent("1.25E-3", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("0.0013"));
+    BOOST_CHECK(parse_with_exponent("6e5", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("600000"));
+    BOOST_CHECK(parse_with_exponent("-6E+5", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("-600000"));
+    BOOST_CHECK(parse_with_exponent("12.5e-1", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("1.25"));
+    BOOST_CHECK(parse_with_exponent("0.000001e6", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(1));
+    BOOST_CHECK(parse_with_exponent("1e-40", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(0));
+    BOOST_CHECK(parse_with_exponent("123456789012345678e-18", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("0.1235"));
+
+    // rounding uses policy of output type
+    dec::decimal<2, dec::half_even_round_policy> even;
+    BOOST_CHECK(parse_with_exponent("125e-3", even));
+    BOOST_CHECK_EQUAL(even.getUnbiased(), 12);
+    BOOST_CHECK(parse_with_exponent("135e-3", even));
+    BOOST_CHECK_EQUAL(even.getUnbiased(), 14);
+    dec::decimal<2, dec::ceiling_round_policy> ceiling;
+    BOOST_CHECK(parse_with_exponent("1001e-5", ceiling));
+    BOOST_CHECK_EQUAL(ceiling.getUnbiased(), 2);
+    BOOST_CHECK(parse_with_exponent("-1001e-5", ceiling));
+    BOOST_CHECK_EQUAL(ceiling.getUnbiased(), -1);
+
+    // mantissa with more digits than int64 holds is rounded only once
+    dec::decimal<2> shortValue;
+    BOOST_CHECK(parse_with_exponent("12.123456789012345678e1", shortValue));
+    BOOST_CHECK_EQUAL(shortValue, dec::decimal<2>("121.23"));
+    BOOST_CHECK(parse_with_exponent("-9223372036854775807.5e-2", shortValue));
+    BOOST_CHECK_EQUAL(shortValue, dec::decimal<2>("-92233720368547758.08"));
+    BOOST_CHECK(parse_with_exponent("0.000000000000000001e19", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(10));
+    BOOST_CHECK(parse_with_exponent("0e100", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(0));
+
+    // 'e' without exponent digits ends the number
+    BOOST_CHECK(parse_with_exponent("1e", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(1));
+    BOOST_CHECK(parse_with_exponent("1.5e+", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>("1.5"));
+    BOOST_CHECK(parse_with_exponent("2e-x", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(2));
+
+    // errors
+    BOOST_CHECK(!parse_with_exponent("1e40", value));
+    BOOST_CHECK_EQUAL(value, dec::decimal<4>(0));
+    BOOST_CHECK(!parse_with_exponent("1e1000000", value));
+
+    // other conversions
+    BOOST_CHECK_EQUAL(dec::fromString<dec::decimal<4> >("2.5e2"), dec::decimal<4>(250));
+    BOOST_CHECK_EQUAL(dec::decimal<4>("-7.5E-1"), dec::decimal<4>("-0.75"));
+    std::istringstream input("3e1 4E-1");
+    dec::decimal<4> first, second;
+    input >> first >> second;
+    BOOST_CHECK_EQUAL(first, dec::decimal<4>(30));
+    BOOST_CHECK_EQUAL(second, dec::decimal<4>("0.4"));
+
+    // parser without exponent support rejects it
+    std::istringstream plain("6e5");
+    int sign, digits;
+    dec::int64 before, after;
+    BOOST_CHECK(!dec::details::parse_unpacked(plain, sign, before, after, digits));
+}
+
+BOOST_AUTO_TEST_CASE(decimalParseTrailingText)
+{
+    // text after number starting with 'e' is not an exponent, only the 'e' is read
+    dec::decimal<2> value;
+    BOOST_CHECK_EQUAL(rest_after_read("100EUR", value), "UR");
+    BOOST_CHECK_EQUAL(value, dec::decimal<2>(100));
+    BOOST_CHECK_EQUAL(rest_after_read("2.5each", value), "ach");
+    BOOST_CHECK_EQUAL(value, dec::decimal<2>("2.5"));
+    BOOST_CHECK_EQUAL(rest_after_read("1e-x", value), "-x");
+    BOOST_CHECK_EQUAL(value, dec::decimal<2>(1));
+    BOOST_CHECK_EQUAL(rest_after_read("3E+", value), "+");
+    BOOST_CHECK_EQUAL(value, dec::decimal<2>(3));
+    BOOST_CHECK_EQUAL(rest_after_read("4e+2 m", value), "m");
+    BOOST_CHECK_EQUAL(value, dec::decimal<2>(400));
+
+    std::wistringstream wideInput(L"1.5e-kg");
+    wideInput >> value;
+    std::wstring wideRest;
+    std::getline(wideInput, wideRest);
+    BOOST_CHECK(wideRest == L"-kg");
+    BOOST_CHECK_EQUAL(value, dec::decimal<2>("1.5"));
+
+    BOOST_CHECK_EQUAL(dec::fromString<dec::decimal<2> >("2.5each"), dec::decimal<2>("2.5"));
+    BOOST_CHECK_EQUAL(dec::fromString<dec::decimal<2> >(std::string("-7Eur")), dec::decimal<2>(-7));
+    BOOST_CHECK_EQUAL(dec::fromString<dec::decimal<2> >("3.25e", 5), dec::decimal<2>("3.25"));
+    BOOST_CHECK_EQUAL(dec::fromString<dec::decimal<2> >("12e3x", 5), dec::decimal<2>(12000));
+}
+
+BOOST_AUTO_TEST_CASE(decimalToStringWithExponent)
+{
+    BOOST_CHECK_EQUAL(dec::toStringWithExponent(dec::decimal<4>("0.00125")), "1.3e-3");
+    BOOST_CHECK_EQUAL(dec::toStringWithExponent(dec::decimal<5>("0.00125")), "1.25e-3");
+    BOOST_CHECK_EQUAL(dec::toStringWithExponent(dec::decimal<2>(600000)), "6e5");
+    BOOST_CHECK_EQUAL(dec::toStringWithExponent(dec::decimal<2>(-600000)), "-6e5");
+    BOOST_CHECK_EQUAL(dec::toStringWithExponent(dec::decimal<2>(0)), "0e0");
+    BOOST_CHECK_EQUAL(dec::toStringWithExponent(dec::decimal<2>("12.34")), "1.234e1");
+    BOOST_CHECK_EQUAL(dec::toStringWithExponent(dec::decimal<2>("12.34"), dec::decimal_format(',')), "1,234e1");
+
+    dec::decimal<2> minValue;
+    minValue.setUnbiased(DEC_MIN_INT64);
+    BOOST_CHECK_EQUAL(dec::toStringWithExponent(minValue), "-9.223372036854775808e16");
+
+    // round trip
+    dec::decimal<6> values[] = {
+            dec::decimal<6>("0.000001"), dec::decimal<6>("-123.456"), dec::decimal<6>("1000000"),
+            dec::decimal<6>("98765.4321")
+    };
+    for (std::size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+        BOOST_CHECK_EQUAL(dec::fromString<dec::decimal<6> >(dec::toStringWithExponent(values[i])), values[i]);
+    }
+}